@@ -996,6 +996,20 @@ static int64_t gdextension_worker_thread_pool_add_native_task(GDExtensionObjectP
 	return (int64_t)p->add_native_task(p_func, p_userdata, static_cast<bool>(p_high_priority), *description);
 }
 
+static int64_t gdextension_worker_thread_pool_add_native_group_task_with_dependencies(GDExtensionObjectPtr p_instance, void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, const int64_t *p_dependencies, int p_dependency_count, int p_tasks, GDExtensionBool p_high_priority, GDExtensionConstStringPtr p_description) {
+	WorkerThreadPool *p = (WorkerThreadPool *)p_instance;
+	const String *description = (const String *)p_description;
+	ERR_FAIL_COND_V(p_dependency_count < 0, WorkerThreadPool::INVALID_TASK_ID);
+	return (int64_t)p->add_native_group_task_with_dependencies(p_func, p_userdata, p_elements, p_dependencies, p_dependency_count, p_tasks, static_cast<bool>(p_high_priority), *description);
+}
+
+static int64_t gdextension_worker_thread_pool_add_native_task_with_dependencies(GDExtensionObjectPtr p_instance, void (*p_func)(void *), void *p_userdata, const int64_t *p_dependencies, int p_dependency_count, GDExtensionBool p_high_priority, GDExtensionConstStringPtr p_description) {
+	WorkerThreadPool *p = (WorkerThreadPool *)p_instance;
+	const String *description = (const String *)p_description;
+	ERR_FAIL_COND_V(p_dependency_count < 0, WorkerThreadPool::INVALID_TASK_ID);
+	return (int64_t)p->add_native_task_with_dependencies(p_func, p_userdata, p_dependencies, p_dependency_count, static_cast<bool>(p_high_priority), *description);
+}
+
 /* Packed array functions */
 
 static uint8_t *gdextension_packed_byte_array_operator_index(GDExtensionTypePtr p_self, GDExtensionInt p_index) {
@@ -1158,6 +1172,87 @@ static GDExtensionTypePtr gdextension_packed_vector4_array_operator_index_const(
 	return (GDExtensionTypePtr)&self->ptr()[p_index];
 }
 
+template <typename T>
+static void *_packed_array_ptrw(GDExtensionTypePtr p_self, GDExtensionInt *r_size) {
+	Vector<T> *self = (Vector<T> *)p_self;
+	if (r_size) {
+		*r_size = self->size();
+	}
+	// Detaches the array from any copies sharing its data, once for the whole span.
+	return self->is_empty() ? nullptr : (void *)self->ptrw();
+}
+
+template <typename T>
+static const void *_packed_array_ptr(GDExtensionConstTypePtr p_self, GDExtensionInt *r_size) {
+	const Vector<T> *self = (const Vector<T> *)p_self;
+	if (r_size) {
+		*r_size = self->size();
+	}
+	return (const void *)self->ptr();
+}
+
+static void *gdextension_packed_array_ptrw(GDExtensionTypePtr p_self, GDExtensionVariantType p_type, GDExtensionInt *r_size) {
+	switch ((Variant::Type)p_type) {
+		case Variant::PACKED_BYTE_ARRAY:
+			return _packed_array_ptrw<uint8_t>(p_self, r_size);
+		case Variant::PACKED_INT32_ARRAY:
+			return _packed_array_ptrw<int32_t>(p_self, r_size);
+		case Variant::PACKED_INT64_ARRAY:
+			return _packed_array_ptrw<int64_t>(p_self, r_size);
+		case Variant::PACKED_FLOAT32_ARRAY:
+			return _packed_array_ptrw<float>(p_self, r_size);
+		case Variant::PACKED_FLOAT64_ARRAY:
+			return _packed_array_ptrw<double>(p_self, r_size);
+		case Variant::PACKED_STRING_ARRAY:
+			return _packed_array_ptrw<String>(p_self, r_size);
+		case Variant::PACKED_VECTOR2_ARRAY:
+			return _packed_array_ptrw<Vector2>(p_self, r_size);
+		case Variant::PACKED_VECTOR3_ARRAY:
+			return _packed_array_ptrw<Vector3>(p_self, r_size);
+		case Variant::PACKED_COLOR_ARRAY:
+			return _packed_array_ptrw<Color>(p_self, r_size);
+		case Variant::PACKED_VECTOR4_ARRAY:
+			return _packed_array_ptrw<Vector4>(p_self, r_size);
+		default:
+			break;
+	}
+	if (r_size) {
+		*r_size = 0;
+	}
+	ERR_FAIL_V_MSG(nullptr, "Type is not a packed array: " + Variant::get_type_name((Variant::Type)p_type) + ".");
+}
+
+static const void *gdextension_packed_array_ptr(GDExtensionConstTypePtr p_self, GDExtensionVariantType p_type, GDExtensionInt *r_size) {
+	switch ((Variant::Type)p_type) {
+		case Variant::PACKED_BYTE_ARRAY:
+			return _packed_array_ptr<uint8_t>(p_self, r_size);
+		case Variant::PACKED_INT32_ARRAY:
+			return _packed_array_ptr<int32_t>(p_self, r_size);
+		case Variant::PACKED_INT64_ARRAY:
+			return _packed_array_ptr<int64_t>(p_self, r_size);
+		case Variant::PACKED_FLOAT32_ARRAY:
+			return _packed_array_ptr<float>(p_self, r_size);
+		case Variant::PACKED_FLOAT64_ARRAY:
+			return _packed_array_ptr<double>(p_self, r_size);
+		case Variant::PACKED_STRING_ARRAY:
+			return _packed_array_ptr<String>(p_self, r_size);
+		case Variant::PACKED_VECTOR2_ARRAY:
+			return _packed_array_ptr<Vector2>(p_self, r_size);
+		case Variant::PACKED_VECTOR3_ARRAY:
+			return _packed_array_ptr<Vector3>(p_self, r_size);
+		case Variant::PACKED_COLOR_ARRAY:
+			return _packed_array_ptr<Color>(p_self, r_size);
+		case Variant::PACKED_VECTOR4_ARRAY:
+			return _packed_array_ptr<Vector4>(p_self, r_size);
+		default:
+			break;
+	}
+	if (r_size) {
+		*r_size = 0;
+	}
+	ERR_FAIL_V_MSG(nullptr, "Type is not a packed array: " + Variant::get_type_name((Variant::Type)p_type) + ".");
+}
+
 static GDExtensionVariantPtr gdextension_array_operator_index(GDExtensionTypePtr p_self, GDExtensionInt p_index) {
 	Array *self = (Array *)p_self;
 	if (unlikely(p_index < 0 || p_index >= self->size())) {
@@ -1222,6 +1317,26 @@ static void gdextension_object_method_bind_ptrcall(GDExtensionMethodBindPtr p_me
 	mb->ptrcall(o, (const void **)p_args, p_ret);
 }
 
+static void gdextension_object_method_bind_ptrcall_batch(GDExtensionMethodBindPtr p_method_bind, const GDExtensionObjectPtr *p_instances, GDExtensionInt p_instance_count, const GDExtensionConstTypePtr *p_args, GDExtensionInt p_args_stride, GDExtensionTypePtr r_rets, GDExtensionInt p_rets_stride) {
+	const MethodBind *mb = reinterpret_cast<const MethodBind *>(p_method_bind);
+	ERR_FAIL_NULL(mb);
+	ERR_FAIL_COND_MSG(mb->is_vararg(), "Batched ptrcall can't be used with vararg methods.");
+	ERR_FAIL_COND(p_instance_count < 0 || p_args_stride < 0 || p_rets_stride < 0);
+	ERR_FAIL_COND_MSG(mb->get_argument_count() > 0 && !p_args, "Arguments are required by this method.");
+	ERR_FAIL_COND_MSG(mb->has_return() && !r_rets, "A return buffer is required by this method.");
+
+	// Validated once for the whole batch; each call is then a plain ptrcall.
+	const void **args = (const void **)p_args;
+	uint8_t *rets = (uint8_t *)r_rets;
+	for (GDExtensionInt i = 0; i < p_instance_count; i++) {
+		Object *o = (Object *)p_instances[i];
+		if (unlikely(!o)) {
+			continue;
+		}
+		mb->ptrcall(o, args ? args + i * p_args_stride : nullptr, rets ? rets + i * p_rets_stride : nullptr);
+	}
+}
+
 static void gdextension_object_destroy(GDExtensionObjectPtr p_o) {
 	memdelete((Object *)p_o);
 }
@@ -1646,6 +1761,8 @@ void gdextension_setup_interface() {
 	REGISTER_INTERFACE_FUNC(file_access_get_buffer);
 	REGISTER_INTERFACE_FUNC(worker_thread_pool_add_native_group_task);
 	REGISTER_INTERFACE_FUNC(worker_thread_pool_add_native_task);
+	REGISTER_INTERFACE_FUNC(worker_thread_pool_add_native_group_task_with_dependencies);
+	REGISTER_INTERFACE_FUNC(worker_thread_pool_add_native_task_with_dependencies);
 	REGISTER_INTERFACE_FUNC(packed_byte_array_operator_index);
 	REGISTER_INTERFACE_FUNC(packed_byte_array_operator_index_const);
 	REGISTER_INTERFACE_FUNC(packed_color_array_operator_index);
@@ -1666,6 +1783,8 @@ void gdextension_setup_interface() {
 	REGISTER_INTERFACE_FUNC(packed_vector3_array_operator_index_const);
 	REGISTER_INTERFACE_FUNC(packed_vector4_array_operator_index);
 	REGISTER_INTERFACE_FUNC(packed_vector4_array_operator_index_const);
+	REGISTER_INTERFACE_FUNC(packed_array_ptrw);
+	REGISTER_INTERFACE_FUNC(packed_array_ptr);
 	REGISTER_INTERFACE_FUNC(array_operator_index);
 	REGISTER_INTERFACE_FUNC(array_operator_index_const);
 	REGISTER_INTERFACE_FUNC(array_ref);
@@ -1674,6 +1793,7 @@ void gdextension_setup_interface() {
 	REGISTER_INTERFACE_FUNC(dictionary_operator_index_const);
 	REGISTER_INTERFACE_FUNC(object_method_bind_call);
 	REGISTER_INTERFACE_FUNC(object_method_bind_ptrcall);
+	REGISTER_INTERFACE_FUNC(object_method_bind_ptrcall_batch);
 	REGISTER_INTERFACE_FUNC(object_destroy);
 	REGISTER_INTERFACE_FUNC(global_get_singleton);
 	REGISTER_INTERFACE_FUNC(object_get_instance_binding);
@@ -1997,6 +1997,48 @@ typedef int64_t (*GDExtensionInterfaceWorkerThreadPoolAddNativeGroupTask)(GDExte
  */
 typedef int64_t (*GDExtensionInterfaceWorkerThreadPoolAddNativeTask)(GDExtensionObjectPtr p_instance, void (*p_func)(void *), void *p_userdata, GDExtensionBool p_high_priority, GDExtensionConstStringPtr p_description);
 
+/**
+ * @name worker_thread_pool_add_native_group_task_with_dependencies
+ * @since 4.4
+ *
+ * Adds a group task to an instance of WorkerThreadPool, which will only be run once all its dependencies have completed.
+ *
+ * @param p_instance A pointer to a WorkerThreadPool object.
+ * @param p_func A pointer to a function to run in the thread pool.
+ * @param p_userdata A pointer to arbitrary data which will be passed to p_func.
+ * @param p_elements The number of elements to process.
+ * @param p_dependencies A pointer to an array of task or task group IDs to wait for.
+ * @param p_dependency_count The number of IDs in p_dependencies.
+ * @param p_tasks The number of tasks needed in the group.
+ * @param p_high_priority Whether or not this is a high priority task.
+ * @param p_description A pointer to a String with the task description.
+ *
+ * @return The task group ID.
+ *
+ * @see WorkerThreadPool::add_group_task_with_dependencies()
+ */
+typedef int64_t (*GDExtensionInterfaceWorkerThreadPoolAddNativeGroupTaskWithDependencies)(GDExtensionObjectPtr p_instance, void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, const int64_t *p_dependencies, int p_dependency_count, int p_tasks, GDExtensionBool p_high_priority, GDExtensionConstStringPtr p_description);
+
+/**
+ * @name worker_thread_pool_add_native_task_with_dependencies
+ * @since 4.4
+ *
+ * Adds a task to an instance of WorkerThreadPool, which will only be run once all its dependencies have completed.
+ *
+ * @param p_instance A pointer to a WorkerThreadPool object.
+ * @param p_func A pointer to a function to run in the thread pool.
+ * @param p_userdata A pointer to arbitrary data which will be passed to p_func.
+ * @param p_dependencies A pointer to an array of task or task group IDs to wait for.
+ * @param p_dependency_count The number of IDs in p_dependencies.
+ * @param p_high_priority Whether or not this is a high priority task.
+ * @param p_description A pointer to a String with the task description.
+ *
+ * @return The task ID.
+ *
+ * @see WorkerThreadPool::add_task_with_dependencies()
+ */
+typedef int64_t (*GDExtensionInterfaceWorkerThreadPoolAddNativeTaskWithDependencies)(GDExtensionObjectPtr p_instance, void (*p_func)(void *), void *p_userdata, const int64_t *p_dependencies, int p_dependency_count, GDExtensionBool p_high_priority, GDExtensionConstStringPtr p_description);
+
 /* INTERFACE: Packed Array */
 
 /**
@@ -2259,6 +2301,40 @@ typedef GDExtensionTypePtr (*GDExtensionInterfacePackedColorArrayOperatorIndex)(
  */
 typedef GDExtensionTypePtr (*GDExtensionInterfacePackedColorArrayOperatorIndexConst)(GDExtensionConstTypePtr p_self, GDExtensionInt p_index);
 
+/**
+ * @name packed_array_ptrw
+ * @since 4.4
+ *
+ * Gets a pointer to the first element of a packed array, along with its size, so all its elements can be processed without a call per element.
+ *
+ * If the data is shared with copies of the array, it's duplicated first (copy-on-write), so this is done only once for the whole span.
+ * The pointer stays valid until the array is resized, destroyed, or assigned to or from another array. Writing through it after the array
+ * has been copied modifies the copies as well.
+ *
+ * @param p_self A pointer to a packed array object.
+ * @param p_type The type of the packed array (one of the GDEXTENSION_VARIANT_TYPE_PACKED_*_ARRAY values).
+ * @param r_size A pointer to an integer that will receive the number of elements. Can be NULL.
+ *
+ * @return A pointer to the first element, or NULL if the array is empty or p_type is not a packed array type.
+ */
+typedef void *(*GDExtensionInterfacePackedArrayPtrw)(GDExtensionTypePtr p_self, GDExtensionVariantType p_type, GDExtensionInt *r_size);
+
+/**
+ * @name packed_array_ptr
+ * @since 4.4
+ *
+ * Gets a const pointer to the first element of a packed array, along with its size, so all its elements can be read without a call per element.
+ *
+ * The pointer stays valid until the array is modified, resized, or destroyed.
+ *
+ * @param p_self A const pointer to a packed array object.
+ * @param p_type The type of the packed array (one of the GDEXTENSION_VARIANT_TYPE_PACKED_*_ARRAY values).
+ * @param r_size A pointer to an integer that will receive the number of elements. Can be NULL.
+ *
+ * @return A const pointer to the first element, or NULL if the array is empty or p_type is not a packed array type.
+ */
+typedef const void *(*GDExtensionInterfacePackedArrayPtr)(GDExtensionConstTypePtr p_self, GDExtensionVariantType p_type, GDExtensionInt *r_size);
+
 /**
  * @name array_operator_index
  * @since 4.1
@@ -2367,6 +2443,29 @@ typedef void (*GDExtensionInterfaceObjectMethodBindCall)(GDExtensionMethodBindPt
  */
 typedef void (*GDExtensionInterfaceObjectMethodBindPtrcall)(GDExtensionMethodBindPtr p_method_bind, GDExtensionObjectPtr p_instance, const GDExtensionConstTypePtr *p_args, GDExtensionTypePtr r_ret);
 
+/**
+ * @name object_method_bind_ptrcall_batch
+ * @since 4.4
+ *
+ * Calls the same method on many Objects (using a "ptrcall" for each).
+ *
+ * The method bind is validated once for the whole batch, so this is cheaper than calling
+ * object_method_bind_ptrcall() in a loop, e.g. to set the transforms of thousands of nodes.
+ *
+ * The arguments for the object at index i start at p_args[i * p_args_stride]. A stride of 0
+ * passes the same arguments to every object. Likewise, its return value is written to
+ * r_rets + i * p_rets_stride (in bytes). Null entries in p_instances are skipped.
+ *
+ * @param p_method_bind A pointer to the MethodBind representing the method on the Objects' class.
+ * @param p_instances A pointer to a C array of pointers to the Objects.
+ * @param p_instance_count The number of Objects.
+ * @param p_args A pointer to a C array representing the arguments of all the calls. Can be NULL if the method takes no arguments.
+ * @param p_args_stride The number of entries in p_args between the arguments of consecutive Objects.
+ * @param r_rets A pointer to the buffer that will receive the return values. Can be NULL if the method doesn't return a value.
+ * @param p_rets_stride The number of bytes in r_rets between the return values of consecutive Objects.
+ */
+typedef void (*GDExtensionInterfaceObjectMethodBindPtrcallBatch)(GDExtensionMethodBindPtr p_method_bind, const GDExtensionObjectPtr *p_instances, GDExtensionInt p_instance_count, const GDExtensionConstTypePtr *p_args, GDExtensionInt p_args_stride, GDExtensionTypePtr r_rets, GDExtensionInt p_rets_stride);
+
 /**
  * @name object_destroy
  * @since 4.1
@@ -36,6 +36,7 @@
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h"
 #include "core/io/marshalls.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 FileAccess::CreateFunc FileAccess::create_func[ACCESS_MAX] = {};
@@ -161,7 +162,7 @@ Ref<FileAccess> FileAccess::open_encrypted_pass(const String &p_path, ModeFlags
 Ref<FileAccess> FileAccess::open_compressed(const String &p_path, ModeFlags p_mode_flags, CompressionMode p_compress_mode) {
 	Ref<FileAccessCompressed> fac;
 	fac.instantiate();
-	fac->configure("GCPF", (Compression::Mode)p_compress_mode);
+	fac->configure("GCPF", (Compression::Mode)p_compress_mode, FileAccessCompressed::STREAMING_BLOCK_SIZE);
 	Error err = fac->open_internal(p_path, p_mode_flags);
 	last_file_open_error = err;
 	if (err) {
@@ -478,6 +479,61 @@ uint64_t FileAccess::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return i;
 }
 
+uint64_t FileAccess::get_buffer_at(uint64_t p_position, uint8_t *p_dst, uint64_t p_length) {
+	// Generic fallback, only valid when nothing else is using the file.
+	uint64_t prev_position = get_position();
+	seek(p_position);
+	uint64_t read = get_buffer(p_dst, p_length);
+	seek(prev_position);
+	return read;
+}
+
+struct FileAccess::AsyncReadTask {
+	Ref<FileAccess> file;
+	AsyncRead read;
+};
+
+void FileAccess::_async_read(FileAccess *p_file, const AsyncRead &p_read) {
+	uint64_t read = p_file->get_buffer_at(p_read.position, p_read.dst, p_read.length);
+	if (p_read.callback) {
+		p_read.callback(p_read.userdata, read);
+	}
+}
+
+void FileAccess::_async_read_task(void *p_userdata) {
+	AsyncReadTask *task = (AsyncReadTask *)p_userdata;
+	_async_read(task->file.ptr(), task->read);
+	memdelete(task);
+}
+
+FileAccess::AsyncReadID FileAccess::read_async(const AsyncRead &p_read) {
+	ERR_FAIL_COND_V(!p_read.dst && p_read.length > 0, ASYNC_READ_COMPLETED);
+
+	if (!can_get_buffer_at()) {
+		_async_read(this, p_read);
+		return ASYNC_READ_COMPLETED;
+	}
+
+	AsyncReadTask *task = memnew(AsyncReadTask);
+	task->file = Ref<FileAccess>(this);
+	task->read = p_read;
+	return WorkerThreadPool::get_singleton()->add_native_task(&FileAccess::_async_read_task, task, false, "Read file");
+}
+
+bool FileAccess::is_async_read_completed(AsyncReadID p_id) {
+	if (p_id == ASYNC_READ_COMPLETED) {
+		return true;
+	}
+	return WorkerThreadPool::get_singleton()->is_task_completed(p_id);
+}
+
+Error FileAccess::wait_async_read(AsyncReadID p_id) {
+	if (p_id == ASYNC_READ_COMPLETED) {
+		return OK;
+	}
+	return WorkerThreadPool::get_singleton()->wait_for_task_completion(p_id);
+}
+
 Vector<uint8_t> FileAccess::get_buffer(int64_t p_length) const {
 	Vector<uint8_t> data;
 
@@ -730,14 +786,14 @@ void FileAccess::store_buffer(const Vector<uint8_t> &p_buffer) {
 
 void FileAccess::store_var(const Variant &p_var, bool p_full_objects) {
 	int len;
-	Error err = encode_variant(p_var, nullptr, len, p_full_objects);
+	Error err = encode_variant(p_var, nullptr, len, p_full_objects, 0, compact_vars);
 	ERR_FAIL_COND_MSG(err != OK, "Error when trying to encode Variant.");
 
 	Vector<uint8_t> buff;
 	buff.resize(len);
 
 	uint8_t *w = buff.ptrw();
-	err = encode_variant(p_var, &w[0], len, p_full_objects);
+	err = encode_variant(p_var, &w[0], len, p_full_objects, 0, compact_vars);
 	ERR_FAIL_COND_MSG(err != OK, "Error when trying to encode Variant.");
 
 	store_32(len);
@@ -892,6 +948,8 @@ void FileAccess::_bind_methods() {
 	ClassDB::bind_static_method("FileAccess", D_METHOD("get_sha256", "path"), &FileAccess::get_sha256);
 	ClassDB::bind_method(D_METHOD("is_big_endian"), &FileAccess::is_big_endian);
 	ClassDB::bind_method(D_METHOD("set_big_endian", "big_endian"), &FileAccess::set_big_endian);
+	ClassDB::bind_method(D_METHOD("is_compact_vars"), &FileAccess::is_compact_vars);
+	ClassDB::bind_method(D_METHOD("set_compact_vars", "compact_vars"), &FileAccess::set_compact_vars);
 	ClassDB::bind_method(D_METHOD("get_error"), &FileAccess::get_error);
 	ClassDB::bind_method(D_METHOD("get_var", "allow_objects"), &FileAccess::get_var, DEFVAL(false));
 
@@ -925,6 +983,7 @@ void FileAccess::_bind_methods() {
 	ClassDB::bind_static_method("FileAccess", D_METHOD("get_read_only_attribute", "file"), &FileAccess::get_read_only_attribute);
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "big_endian"), "set_big_endian", "is_big_endian");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "compact_vars"), "set_compact_vars", "is_compact_vars");
 
 	BIND_ENUM_CONSTANT(READ);
 	BIND_ENUM_CONSTANT(WRITE);
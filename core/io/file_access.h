@@ -86,9 +86,26 @@ public:
 
 	typedef void (*FileCloseFailNotify)(const String &);
 
+	// Reads at an absolute position, independent from the file cursor, on a WorkerThreadPool thread.
+	// The callback runs on the thread that completed the read, which may be the caller's if the file
+	// can't read concurrently. Every read must be waited on, even with a callback, to release its task.
+	typedef int64_t AsyncReadID;
+	typedef void (*AsyncReadCallback)(void *p_userdata, uint64_t p_read);
+
+	static constexpr AsyncReadID ASYNC_READ_COMPLETED = -1;
+
+	struct AsyncRead {
+		uint64_t position = 0;
+		uint8_t *dst = nullptr;
+		uint64_t length = 0;
+		AsyncReadCallback callback = nullptr;
+		void *userdata = nullptr;
+	};
+
 	typedef Ref<FileAccess> (*CreateFunc)();
 	bool big_endian = false;
 	bool real_is_double = false;
+	bool compact_vars = false;
 
 	virtual BitField<UnixPermissionFlags> _get_unix_permissions(const String &p_file) = 0;
 	virtual Error _set_unix_permissions(const String &p_file, BitField<UnixPermissionFlags> p_permissions) = 0;
@@ -122,6 +139,10 @@ private:
 
 	static Ref<FileAccess> _open(const String &p_path, ModeFlags p_mode_flags);
 
+	struct AsyncReadTask;
+	static void _async_read(FileAccess *p_file, const AsyncRead &p_read);
+	static void _async_read_task(void *p_userdata);
+
 public:
 	static void set_file_close_fail_notify_callback(FileCloseFailNotify p_cbk) { close_fail_notify = p_cbk; }
 
@@ -150,6 +171,15 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const; ///< get an array of bytes
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	virtual const uint8_t *get_buffer_view(uint64_t p_length) const { return nullptr; } ///< get the next bytes without copying, nullptr if the file isn't memory backed or too short. Valid while the file is open.
+	virtual const uint8_t *map_read_only() { return nullptr; } ///< map the whole file read-only, nullptr if unsupported or if the file no longer covers the mapping. Valid until the file is closed, but reading a mapping whose file got truncated since can crash.
+
+	virtual bool can_get_buffer_at() const { return false; } ///< true if get_buffer_at() is safe to call from several threads at once
+	virtual uint64_t get_buffer_at(uint64_t p_position, uint8_t *p_dst, uint64_t p_length); ///< read at a position, only moves the cursor in the generic fallback
+
+	AsyncReadID read_async(const AsyncRead &p_read); ///< the read keeps the file alive until it completes
+	static bool is_async_read_completed(AsyncReadID p_id); ///< true once the read and its callback are done, it must still be waited on afterwards
+	static Error wait_async_read(AsyncReadID p_id); ///< ERR_BUSY if called from a WorkerThreadPool task that can't wait on the read, which is then still pending
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -164,6 +194,13 @@ public:
 	virtual void set_big_endian(bool p_big_endian) { big_endian = p_big_endian; }
 	inline bool is_big_endian() const { return big_endian; }
 
+	/**
+	 * Makes store_var() use the compact Variant encoding (see encode_variant()).
+	 * get_var() reads both encodings, older versions can only read the regular one.
+	 */
+	void set_compact_vars(bool p_compact_vars) { compact_vars = p_compact_vars; }
+	bool is_compact_vars() const { return compact_vars; }
+
 	virtual Error get_error() const = 0; ///< get last error
 
 	virtual Error resize(int64_t p_length) = 0;
@@ -32,6 +32,9 @@
 
 #include "core/string/print_string.h"
 
+Mutex FileAccessCompressed::retired_blocks_mutex;
+LocalVector<FileAccessCompressed::CachedBlock *> FileAccessCompressed::retired_blocks;
+
 void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size) {
 	magic = p_magic.ascii().get_data();
 	magic = (magic + "    ").substr(0, 4);
@@ -73,20 +76,209 @@ Error FileAccessCompressed::open_after_magic(Ref<FileAccess> p_base) {
 		read_blocks.push_back(rb);
 	}
 
-	comp_buffer.resize(max_bs);
-	buffer.resize(block_size);
-	read_ptr = buffer.ptrw();
-	f->get_buffer(comp_buffer.ptrw(), read_blocks[0].csize);
 	at_end = false;
 	read_eof = false;
 	read_block_count = bc;
-	read_block_size = read_blocks.size() == 1 ? read_total : block_size;
 
-	int ret = Compression::decompress(buffer.ptrw(), read_block_size, comp_buffer.ptr(), read_blocks[0].csize, cmode);
-	read_block = 0;
+	if (read_ahead > 0 && bc > 1 && block_size >= READ_AHEAD_MIN_BLOCK_SIZE) {
+		// Current block, the blocks being read ahead and one spare so a new prefetch never has to wait.
+		block_cache.resize(read_ahead + 2);
+		for (CachedBlock *&slot : block_cache) {
+			slot = memnew(CachedBlock);
+			slot->compressed.resize(max_bs);
+			slot->data.resize(block_size);
+		}
+	} else {
+		comp_buffer.resize(max_bs);
+		buffer.resize(block_size);
+	}
+
+	return _load_block(0) ? OK : ERR_FILE_CORRUPT;
+}
+
+uint32_t FileAccessCompressed::_get_block_capacity() const {
+	return read_blocks.size() == 1 ? read_total : block_size;
+}
+
+void FileAccessCompressed::_decompress_block_task(void *p_userdata) {
+	CachedBlock *slot = (CachedBlock *)p_userdata;
+	slot->result = Compression::decompress(slot->data.ptr(), slot->capacity, slot->compressed.ptr(), slot->compressed.size(), slot->mode);
+}
+
+void FileAccessCompressed::_prefetch_block_read(void *p_userdata, uint64_t p_read) {
+	CachedBlock *slot = (CachedBlock *)p_userdata;
+	if (p_read != slot->compressed.size()) {
+		slot->result = -1;
+		return;
+	}
+	_decompress_block_task(slot);
+}
+
+void FileAccessCompressed::_prepare_cached_block(uint32_t p_block, CachedBlock &r_slot) const {
+	r_slot.block = p_block;
+	r_slot.mode = cmode;
+	r_slot.capacity = _get_block_capacity();
+	r_slot.result = 0;
+	r_slot.compressed.resize(read_blocks[p_block].csize); // Never grows past the largest block reserved on open.
+}
+
+bool FileAccessCompressed::_read_compressed_block(uint32_t p_block, CachedBlock &r_slot) const {
+	const ReadBlock &rb = read_blocks[p_block];
+	_prepare_cached_block(p_block, r_slot);
+	f->seek(rb.offset);
+	if (f->get_buffer(r_slot.compressed.ptr(), rb.csize) != rb.csize) {
+		r_slot.block = UINT32_MAX;
+		return false;
+	}
+	return true;
+}
+
+bool FileAccessCompressed::_wait_cached_block(CachedBlock &p_slot) const {
+	if (p_slot.task_id == WorkerThreadPool::INVALID_TASK_ID) {
+		return true;
+	}
+	// Either a read chained with decompression or a decompression task. A pool thread running a task
+	// newer than it gets ERR_BUSY, the task is then still writing to the slot, which must be left alone.
+	if (FileAccess::wait_async_read(p_slot.task_id) != OK) {
+		return false;
+	}
+	p_slot.task_id = WorkerThreadPool::INVALID_TASK_ID;
+	return true;
+}
+
+void FileAccessCompressed::_reap_retired_blocks() {
+	MutexLock lock(retired_blocks_mutex);
+	for (uint32_t i = 0; i < retired_blocks.size(); i++) {
+		CachedBlock *slot = retired_blocks[i];
+		if (FileAccess::is_async_read_completed(slot->task_id)) {
+			FileAccess::wait_async_read(slot->task_id); // Never fails on a completed read, this releases it.
+			memdelete(slot);
+			retired_blocks.remove_at_unordered(i);
+			i--;
+		}
+	}
+}
+
+void FileAccessCompressed::finalize() {
+	MutexLock lock(retired_blocks_mutex);
+	for (CachedBlock *slot : retired_blocks) {
+		FileAccess::wait_async_read(slot->task_id);
+		memdelete(slot);
+	}
+	retired_blocks.clear();
+}
+
+FileAccessCompressed::CachedBlock *FileAccessCompressed::_get_cached_block(uint32_t p_block) const {
+	CachedBlock *slot = nullptr;
+	CachedBlock *lru = nullptr;
+	CachedBlock *lru_idle = nullptr;
+	for (CachedBlock *E : block_cache) {
+		if (E->block == p_block) {
+			slot = E;
+			break;
+		}
+		if (!lru || E->last_used < lru->last_used) {
+			lru = E;
+		}
+		if (E->task_id == WorkerThreadPool::INVALID_TASK_ID && (!lru_idle || E->last_used < lru_idle->last_used)) {
+			lru_idle = E;
+		}
+	}
+
+	if (slot) {
+		if (!_wait_cached_block(*slot)) {
+			return nullptr;
+		}
+	} else {
+		slot = lru_idle ? lru_idle : lru;
+		if (!_wait_cached_block(*slot)) {
+			return nullptr;
+		}
+		if (!_read_compressed_block(p_block, *slot)) {
+			return nullptr;
+		}
+		_decompress_block_task(slot);
+	}
+
+	slot->last_used = ++block_cache_tick;
+	if (slot->result == -1) {
+		slot->block = UINT32_MAX;
+		return nullptr;
+	}
+	return slot;
+}
+
+void FileAccessCompressed::_prefetch_blocks(uint32_t p_from) const {
+	// Blocks retired by files closed meanwhile would otherwise wait for the next close.
+	_reap_retired_blocks();
+
+	uint32_t to = MIN(p_from + read_ahead, read_block_count);
+	for (uint32_t i = p_from; i < to; i++) {
+		CachedBlock *victim = nullptr;
+		bool cached = false;
+		for (CachedBlock *E : block_cache) {
+			if (E->block == i) {
+				cached = true;
+				break;
+			}
+			// Don't wait on pending tasks here, nor drop the block being read.
+			if (E->task_id == WorkerThreadPool::INVALID_TASK_ID && E->block != read_block && (!victim || E->last_used < victim->last_used)) {
+				victim = E;
+			}
+		}
+		if (cached) {
+			continue;
+		}
+		if (!victim) {
+			break;
+		}
+
+		if (f->can_get_buffer_at()) {
+			// Read and decompress off this thread, without touching the cursor of the base file.
+			_prepare_cached_block(i, *victim);
+			AsyncRead read;
+			read.position = read_blocks[i].offset;
+			read.dst = victim->compressed.ptr();
+			read.length = victim->compressed.size();
+			read.callback = &FileAccessCompressed::_prefetch_block_read;
+			read.userdata = victim;
+			victim->task_id = f->read_async(read);
+		} else {
+			if (!_read_compressed_block(i, *victim)) {
+				break;
+			}
+			victim->task_id = WorkerThreadPool::get_singleton()->add_native_task(&FileAccessCompressed::_decompress_block_task, victim, false, "Decompress file block");
+		}
+		victim->last_used = ++block_cache_tick;
+	}
+}
+
+bool FileAccessCompressed::_load_block(uint32_t p_block) const {
+	read_block = p_block;
+	read_block_size = p_block == read_block_count - 1 ? read_total % block_size : block_size;
 	read_pos = 0;
 
-	return ret == -1 ? ERR_FILE_CORRUPT : OK;
+	if (!block_cache.is_empty()) {
+		CachedBlock *slot = _get_cached_block(p_block);
+		if (slot) {
+			read_ptr = slot->data.ptr();
+			_prefetch_blocks(p_block + 1);
+			return true;
+		}
+		// Either corrupt, or held by a task this thread can't wait on. Decode it here like when not reading ahead.
+		if (comp_buffer.size() < read_blocks[p_block].csize) {
+			comp_buffer.resize(read_blocks[p_block].csize);
+		}
+		if (buffer.size() < block_size) {
+			buffer.resize(block_size);
+		}
+	}
+
+	f->seek(read_blocks[p_block].offset);
+	f->get_buffer(comp_buffer.ptrw(), read_blocks[p_block].csize);
+	int ret = Compression::decompress(buffer.ptrw(), _get_block_capacity(), comp_buffer.ptr(), read_blocks[p_block].csize, cmode);
+	read_ptr = buffer.ptr();
+	return ret != -1;
 }
 
 Error FileAccessCompressed::open_internal(const String &p_path, int p_mode_flags) {
@@ -144,22 +336,18 @@ void FileAccessCompressed::_close() {
 			f->store_32(0); //compressed sizes, will update later
 		}
 
-		Vector<int> block_sizes;
-		for (uint32_t i = 0; i < bc; i++) {
-			uint32_t bl = i == (bc - 1) ? write_max % block_size : block_size;
-			uint8_t *bp = &write_ptr[i * block_size];
+		// Blocks are independent, so compress them all at once and write them in order after.
+		Vector<Vector<uint8_t>> cblocks;
+		cblocks.resize(bc);
+		WorkerThreadPool::get_singleton()->parallel_for(this, &FileAccessCompressed::_compress_blocks, cblocks.ptrw(), 0, bc, 1, "Compress file blocks");
 
-			Vector<uint8_t> cblock;
-			cblock.resize(Compression::get_max_compressed_buffer_size(bl, cmode));
-			int s = Compression::compress(cblock.ptrw(), bp, bl, cmode);
-
-			f->store_buffer(cblock.ptr(), s);
-			block_sizes.push_back(s);
+		for (uint32_t i = 0; i < bc; i++) {
+			f->store_buffer(cblocks[i].ptr(), cblocks[i].size());
 		}
 
 		f->seek(16); //ok write block sizes
 		for (uint32_t i = 0; i < bc; i++) {
-			f->store_32(block_sizes[i]);
+			f->store_32(cblocks[i].size());
 		}
 		f->seek_end();
 		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //magic at the end too
@@ -167,13 +355,37 @@ void FileAccessCompressed::_close() {
 		buffer.clear();
 
 	} else {
+		_reap_retired_blocks();
+		for (CachedBlock *slot : block_cache) {
+			if (_wait_cached_block(*slot)) {
+				memdelete(slot);
+			} else {
+				MutexLock lock(retired_blocks_mutex);
+				retired_blocks.push_back(slot);
+			}
+		}
+		block_cache.clear();
 		comp_buffer.clear();
 		buffer.clear();
 		read_blocks.clear();
+		read_ptr = nullptr;
 	}
 	f.unref();
 }
 
+void FileAccessCompressed::_compress_blocks(uint32_t p_from, uint32_t p_to, Vector<uint8_t> *r_blocks) {
+	uint32_t bc = (write_max / block_size) + 1;
+	for (uint32_t i = p_from; i < p_to; i++) {
+		uint32_t bl = i == (bc - 1) ? write_max % block_size : block_size;
+		const uint8_t *bp = &write_ptr[i * block_size];
+
+		Vector<uint8_t> &cblock = r_blocks[i];
+		cblock.resize(Compression::get_max_compressed_buffer_size(bl, cmode));
+		int s = Compression::compress(cblock.ptrw(), bp, bl, cmode);
+		cblock.resize(s);
+	}
+}
+
 bool FileAccessCompressed::is_open() const {
 	return f.is_valid();
 }
@@ -211,12 +423,7 @@ void FileAccessCompressed::seek(uint64_t p_position) {
 			read_eof = false;
 			uint32_t block_idx = p_position / block_size;
 			if (block_idx != read_block) {
-				read_block = block_idx;
-				f->seek(read_blocks[read_block].offset);
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				int ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				ERR_FAIL_COND_MSG(ret == -1, "Compressed file is corrupt.");
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+				ERR_FAIL_COND_MSG(!_load_block(block_idx), "Compressed file is corrupt.");
 			}
 
 			read_pos = p_position % block_size;
@@ -277,12 +484,7 @@ uint8_t FileAccessCompressed::get_8() const {
 
 		if (read_block < read_block_count) {
 			//read another block of compressed data
-			f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-			int total = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-			ERR_FAIL_COND_V_MSG(total == -1, 0, "Compressed file is corrupt.");
-			read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
-			read_pos = 0;
-
+			ERR_FAIL_COND_V_MSG(!_load_block(read_block), 0, "Compressed file is corrupt.");
 		} else {
 			read_block--;
 			at_end = true;
@@ -302,27 +504,25 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 		return 0;
 	}
 
-	for (uint64_t i = 0; i < p_length; i++) {
-		p_dst[i] = read_ptr[read_pos];
-		read_pos++;
+	uint64_t i = 0;
+	while (i < p_length) {
+		uint64_t to_copy = MIN((uint64_t)(read_block_size - read_pos), p_length - i);
+		memcpy(p_dst + i, read_ptr + read_pos, to_copy);
+		i += to_copy;
+		read_pos += to_copy;
 		if (read_pos >= read_block_size) {
 			read_block++;
 
 			if (read_block < read_block_count) {
 				//read another block of compressed data
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				int ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				ERR_FAIL_COND_V_MSG(ret == -1, -1, "Compressed file is corrupt.");
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
-				read_pos = 0;
-
+				ERR_FAIL_COND_V_MSG(!_load_block(read_block), -1, "Compressed file is corrupt.");
 			} else {
 				read_block--;
 				at_end = true;
-				if (i + 1 < p_length) {
+				if (i < p_length) {
 					read_eof = true;
 				}
-				return i + 1;
+				return i;
 			}
 		}
 	}
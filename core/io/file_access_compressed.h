@@ -33,8 +33,20 @@
 
 #include "core/io/compression.h"
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
 
 class FileAccessCompressed : public FileAccess {
+public:
+	enum {
+		DEFAULT_BLOCK_SIZE = 4096,
+		STREAMING_BLOCK_SIZE = 65536, // Used for user files, large enough to be worth decompressing ahead.
+		READ_AHEAD_MIN_BLOCK_SIZE = 16384, // Smaller blocks are cheaper to decompress than to dispatch.
+		DEFAULT_READ_AHEAD = 4,
+	};
+
+private:
 	Compression::Mode cmode = Compression::MODE_ZSTD;
 	bool writing = false;
 	uint64_t write_pos = 0;
@@ -50,8 +62,29 @@ class FileAccessCompressed : public FileAccess {
 		uint64_t offset;
 	};
 
+	// Decompressed blocks kept around when reading ahead. Slots are allocated once on open, so
+	// prefetch tasks can write into them while the reader keeps going. A slot whose task can't be
+	// waited on when closing is retired instead, and freed once the task is done.
+	struct CachedBlock {
+		uint32_t block = UINT32_MAX;
+		uint64_t last_used = 0;
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+		Compression::Mode mode = Compression::MODE_ZSTD;
+		uint32_t capacity = 0;
+		int result = 0;
+		LocalVector<uint8_t> compressed;
+		LocalVector<uint8_t> data;
+	};
+
+	uint32_t read_ahead = DEFAULT_READ_AHEAD;
+	mutable LocalVector<CachedBlock *> block_cache;
+	mutable uint64_t block_cache_tick = 0;
+
+	static Mutex retired_blocks_mutex;
+	static LocalVector<CachedBlock *> retired_blocks;
+
 	mutable Vector<uint8_t> comp_buffer;
-	uint8_t *read_ptr = nullptr;
+	mutable const uint8_t *read_ptr = nullptr;
 	mutable uint32_t read_block = 0;
 	uint32_t read_block_count = 0;
 	mutable uint32_t read_block_size = 0;
@@ -65,8 +98,25 @@ class FileAccessCompressed : public FileAccess {
 
 	void _close();
 
+	static void _decompress_block_task(void *p_userdata);
+	static void _prefetch_block_read(void *p_userdata, uint64_t p_read);
+	void _prepare_cached_block(uint32_t p_block, CachedBlock &r_slot) const;
+	void _compress_blocks(uint32_t p_from, uint32_t p_to, Vector<uint8_t> *r_blocks);
+	uint32_t _get_block_capacity() const;
+	bool _read_compressed_block(uint32_t p_block, CachedBlock &r_slot) const;
+	bool _wait_cached_block(CachedBlock &p_slot) const;
+	static void _reap_retired_blocks();
+	CachedBlock *_get_cached_block(uint32_t p_block) const;
+	void _prefetch_blocks(uint32_t p_from) const;
+	bool _load_block(uint32_t p_block) const;
+
 public:
-	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = 4096);
+	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = DEFAULT_BLOCK_SIZE);
+	// Number of blocks decompressed ahead on the WorkerThreadPool while reading, 0 to disable. Must be set before opening.
+	void set_read_ahead(uint32_t p_blocks) { read_ahead = p_blocks; }
+	uint32_t get_read_ahead() const { return read_ahead; }
+	// Frees the blocks of closed files whose decompression was still running. Needs the WorkerThreadPool.
+	static void finalize();
 
 	Error open_after_magic(Ref<FileAccess> p_base);
 
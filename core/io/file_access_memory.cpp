@@ -149,6 +149,29 @@ uint64_t FileAccessMemory::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+const uint8_t *FileAccessMemory::get_buffer_view(uint64_t p_length) const {
+	ERR_FAIL_NULL_V(data, nullptr);
+	if (pos > length || p_length > length - pos) {
+		return nullptr;
+	}
+
+	const uint8_t *view = &data[pos];
+	pos += p_length;
+	return view;
+}
+
+uint64_t FileAccessMemory::get_buffer_at(uint64_t p_position, uint8_t *p_dst, uint64_t p_length) {
+	ERR_FAIL_NULL_V(data, 0);
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, 0);
+	if (p_position >= length) {
+		return 0;
+	}
+
+	uint64_t to_read = MIN(p_length, length - p_position);
+	memcpy(p_dst, &data[p_position], to_read);
+	return to_read;
+}
+
 Error FileAccessMemory::get_error() const {
 	return pos >= length ? ERR_FILE_EOF : OK;
 }
@@ -136,6 +136,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	if (f.is_null()) {
 		return false;
 	}
+	Ref<FileAccess> pack_file = f;
 
 	bool pck_header_found = false;
 
@@ -262,10 +263,37 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED));
 	}
 
+	_map_pack(p_path, pack_file);
+
 	return true;
 }
 
+void PackedSourcePCK::_map_pack(const String &p_path, const Ref<FileAccess> &p_file) {
+	if (mapped_packs.has(p_path)) {
+		return;
+	}
+
+	const uint8_t *data = p_file->map_read_only();
+	if (!data) {
+		return; // Not supported here, files will be read through their own file handle.
+	}
+
+	MappedPack mapped_pack;
+	mapped_pack.file = p_file;
+	mapped_pack.data = data;
+	mapped_pack.size = p_file->get_length();
+	mapped_packs.insert(p_path, mapped_pack);
+}
+
 Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
+	if (!p_file->encrypted) {
+		const MappedPack *mapped_pack = mapped_packs.getptr(p_file->pack);
+		// Mapping again only checks the pack wasn't truncated on disk since, in which case
+		// reading through the mapping would crash instead of failing.
+		if (mapped_pack && p_file->offset + p_file->size <= mapped_pack->size && mapped_pack->file->map_read_only() == mapped_pack->data) {
+			return memnew(FileAccessPack(p_path, *p_file, mapped_pack->file, mapped_pack->data + p_file->offset));
+		}
+	}
 	return memnew(FileAccessPack(p_path, *p_file));
 }
 
@@ -277,7 +305,9 @@ Error FileAccessPack::open_internal(const String &p_path, int p_mode_flags) {
 }
 
 bool FileAccessPack::is_open() const {
-	if (f.is_valid()) {
+	if (mapped) {
+		return true;
+	} else if (f.is_valid()) {
 		return f->is_open();
 	} else {
 		return false;
@@ -285,7 +315,7 @@ bool FileAccessPack::is_open() const {
 }
 
 void FileAccessPack::seek(uint64_t p_position) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(f.is_null() && !mapped, "File must be opened before use.");
 
 	if (p_position > pf.size) {
 		eof = true;
@@ -293,7 +323,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (!mapped) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -314,18 +346,21 @@ bool FileAccessPack::eof_reached() const {
 }
 
 uint8_t FileAccessPack::get_8() const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), 0, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(f.is_null() && !mapped, 0, "File must be opened before use.");
 	if (pos >= pf.size) {
 		eof = true;
 		return 0;
 	}
 
+	if (mapped) {
+		return mapped[pos++];
+	}
 	pos++;
 	return f->get_8();
 }
 
 uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(f.is_null() && !mapped, -1, "File must be opened before use.");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 
 	if (eof) {
@@ -338,21 +373,58 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
-	pos += to_read;
-
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+
+	if (mapped) {
+		memcpy(p_dst, mapped + pos, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
+	pos += to_read;
 
 	return to_read;
 }
 
+const uint8_t *FileAccessPack::get_buffer_view(uint64_t p_length) const {
+	if (!mapped || eof || p_length > pf.size - pos) {
+		return nullptr;
+	}
+
+	const uint8_t *view = mapped + pos;
+	pos += p_length;
+	return view;
+}
+
+bool FileAccessPack::can_get_buffer_at() const {
+	// Encrypted files decrypt sequentially, those go through the generic fallback.
+	return mapped || (f.is_valid() && !pf.encrypted && f->can_get_buffer_at());
+}
+
+uint64_t FileAccessPack::get_buffer_at(uint64_t p_position, uint8_t *p_dst, uint64_t p_length) {
+	if (!can_get_buffer_at()) {
+		return FileAccess::get_buffer_at(p_position, p_dst, p_length);
+	}
+	if (p_position >= pf.size) {
+		return 0;
+	}
+
+	uint64_t to_read = MIN(p_length, pf.size - p_position);
+	if (mapped) {
+		memcpy(p_dst, mapped + p_position, to_read);
+		return to_read;
+	}
+	return f->get_buffer_at(off + p_position, p_dst, to_read);
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(f.is_null() && !mapped, "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (f.is_valid()) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -380,15 +452,27 @@ bool FileAccessPack::file_exists(const String &p_name) {
 
 void FileAccessPack::close() {
 	f = Ref<FileAccess>();
+	mapped_pack = Ref<FileAccess>();
+	mapped = nullptr;
 }
 
-FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
-		pf(p_file),
-		f(FileAccess::open(pf.pack, FileAccess::READ)) {
+FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<FileAccess> &p_mapped_pack, const uint8_t *p_mapped_data) :
+		pf(p_file) {
+	off = pf.offset;
+	pos = 0;
+	eof = false;
+
+	if (p_mapped_data) {
+		// Reads are served from memory, no need for a file handle of our own.
+		mapped_pack = p_mapped_pack;
+		mapped = p_mapped_data;
+		return;
+	}
+
+	f = FileAccess::open(pf.pack, FileAccess::READ);
 	ERR_FAIL_COND_MSG(f.is_null(), "Can't open pack-referenced file '" + String(pf.pack) + "'.");
 
 	f->seek(pf.offset);
-	off = pf.offset;
 
 	if (pf.encrypted) {
 		Ref<FileAccessEncrypted> fae;
@@ -406,8 +490,6 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		f = fae;
 		off = 0;
 	}
-	pos = 0;
-	eof = false;
 }
 
 //////////////////////////////////////////////////////////////////////////////////
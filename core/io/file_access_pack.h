@@ -136,6 +136,16 @@ public:
 };
 
 class PackedSourcePCK : public PackSource {
+	// Packs mapped read-only into memory, files in them are read straight from the mapping.
+	struct MappedPack {
+		Ref<FileAccess> file;
+		const uint8_t *data = nullptr;
+		uint64_t size = 0;
+	};
+	HashMap<String, MappedPack> mapped_packs;
+
+	void _map_pack(const String &p_path, const Ref<FileAccess> &p_file);
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
@@ -149,6 +159,10 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+
+	// Set when the pack is memory mapped, keeps the mapping alive while open.
+	Ref<FileAccess> mapped_pack;
+	const uint8_t *mapped = nullptr;
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual BitField<FileAccess::UnixPermissionFlags> _get_unix_permissions(const String &p_file) override { return 0; }
@@ -172,6 +186,9 @@ public:
 	virtual uint8_t get_8() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_buffer_view(uint64_t p_length) const override;
+	virtual bool can_get_buffer_at() const override;
+	virtual uint64_t get_buffer_at(uint64_t p_position, uint8_t *p_dst, uint64_t p_length) override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -187,7 +204,7 @@ public:
 
 	virtual void close() override;
 
-	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<FileAccess> &p_mapped_pack = Ref<FileAccess>(), const uint8_t *p_mapped_data = nullptr);
 };
 
 Ref<FileAccess> PackedData::try_open_path(const String &p_path) {
@@ -39,6 +39,8 @@
 class JSON : public Resource {
 	GDCLASS(JSON, Resource);
 
+	friend class JSONWriter;
+
 	enum TokenType {
 		TK_CURLY_BRACKET_OPEN,
 		TK_CURLY_BRACKET_CLOSE,
@@ -0,0 +1,662 @@
+/**************************************************************************/
+/*  json_reader.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "json_reader.h"
+
+static _FORCE_INLINE_ int _hex_value(int p_char) {
+	if (p_char >= '0' && p_char <= '9') {
+		return p_char - '0';
+	} else if (p_char >= 'a' && p_char <= 'f') {
+		return p_char - 'a' + 10;
+	} else if (p_char >= 'A' && p_char <= 'F') {
+		return p_char - 'A' + 10;
+	}
+	return -1;
+}
+
+static void _append_utf8(LocalVector<char> &r_text, char32_t p_char) {
+	if (p_char <= 0x7f) {
+		r_text.push_back(char(p_char));
+	} else if (p_char <= 0x7ff) {
+		r_text.push_back(char(0xc0 | ((p_char >> 6) & 0x1f)));
+		r_text.push_back(char(0x80 | (p_char & 0x3f)));
+	} else if (p_char <= 0xffff) {
+		r_text.push_back(char(0xe0 | ((p_char >> 12) & 0x0f)));
+		r_text.push_back(char(0x80 | ((p_char >> 6) & 0x3f)));
+		r_text.push_back(char(0x80 | (p_char & 0x3f)));
+	} else {
+		r_text.push_back(char(0xf0 | ((p_char >> 18) & 0x07)));
+		r_text.push_back(char(0x80 | ((p_char >> 12) & 0x3f)));
+		r_text.push_back(char(0x80 | ((p_char >> 6) & 0x3f)));
+		r_text.push_back(char(0x80 | (p_char & 0x3f)));
+	}
+}
+
+bool JSONReader::_refill() {
+	if (source_eof) {
+		return false;
+	}
+
+	if (chunk.size() != READ_CHUNK_SIZE) {
+		chunk.resize(READ_CHUNK_SIZE);
+	}
+	chunk_pos = 0;
+	chunk_len = 0;
+
+	if (file.is_valid()) {
+		chunk_len = file->get_buffer(chunk.ptr(), READ_CHUNK_SIZE);
+		if (chunk_len < READ_CHUNK_SIZE) {
+			source_eof = true;
+		}
+	} else if (stream.is_valid()) {
+		int received = 0;
+		if (stream->get_partial_data(chunk.ptr(), READ_CHUNK_SIZE, received) != OK) {
+			received = 0;
+			source_eof = true;
+		} else if (received == 0) {
+			// Nothing buffered yet, block for a byte (fails once the stream has ended).
+			if (stream->get_data(chunk.ptr(), 1) == OK) {
+				received = 1;
+			} else {
+				source_eof = true;
+			}
+		}
+		chunk_len = received;
+	} else {
+		source_eof = true;
+	}
+
+	return chunk_len > 0;
+}
+
+int JSONReader::_skip_whitespace() {
+	while (true) {
+		int c = _peek_char();
+		if (c < 0 || c > 32) {
+			return c;
+		}
+		_next_char();
+	}
+}
+
+Error JSONReader::_set_error(const String &p_message) {
+	err_str = p_message;
+	err_line = line;
+	event = EVENT_NONE;
+	skipping = false;
+	return ERR_PARSE_ERROR;
+}
+
+Error JSONReader::_parse_string() {
+	text.clear();
+	string_ready = false;
+
+	while (true) {
+		int c = _next_char();
+		if (c < 0) {
+			return _set_error("Unterminated string.");
+		} else if (c == '"') {
+			return OK;
+		} else if (c != '\\') {
+			if (!skipping) {
+				text.push_back(char(c));
+			}
+			continue;
+		}
+
+		c = _next_char();
+		char32_t res = 0;
+		switch (c) {
+			case 'b':
+				res = 8;
+				break;
+			case 't':
+				res = 9;
+				break;
+			case 'n':
+				res = 10;
+				break;
+			case 'f':
+				res = 12;
+				break;
+			case 'r':
+				res = 13;
+				break;
+			case '"':
+			case '\\':
+			case '/':
+				res = c;
+				break;
+			case 'u': {
+				for (int i = 0; i < 4; i++) {
+					int v = _hex_value(_next_char());
+					if (v < 0) {
+						return _set_error("Malformed hex constant in string.");
+					}
+					res = (res << 4) | v;
+				}
+
+				if ((res & 0xfffffc00) == 0xd800) {
+					if (_next_char() != '\\' || _next_char() != 'u') {
+						return _set_error("Invalid UTF-16 sequence in string, unpaired lead surrogate.");
+					}
+					char32_t trail = 0;
+					for (int i = 0; i < 4; i++) {
+						int v = _hex_value(_next_char());
+						if (v < 0) {
+							return _set_error("Malformed hex constant in string.");
+						}
+						trail = (trail << 4) | v;
+					}
+					if ((trail & 0xfffffc00) != 0xdc00) {
+						return _set_error("Invalid UTF-16 sequence in string, unpaired lead surrogate.");
+					}
+					res = (res << 10UL) + trail - ((0xd800 << 10UL) + 0xdc00 - 0x10000);
+				} else if ((res & 0xfffffc00) == 0xdc00) {
+					return _set_error("Invalid UTF-16 sequence in string, unpaired trail surrogate.");
+				}
+			} break;
+			case -1:
+				return _set_error("Unterminated string.");
+			default:
+				return _set_error("Invalid escape sequence.");
+		}
+
+		if (!skipping) {
+			_append_utf8(text, res);
+		}
+	}
+}
+
+Error JSONReader::_parse_number() {
+	// The first character was already consumed and stored by the caller.
+	while (true) {
+		int c = _peek_char();
+		if ((c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-') {
+			text.push_back(char(c));
+			_next_char();
+		} else {
+			break;
+		}
+	}
+
+	event = EVENT_NUMBER;
+	state = STATE_AFTER_VALUE;
+
+	// Validate against the JSON grammar, and read integers directly while at it.
+	const char *p = text.ptr();
+	const uint32_t len = text.size();
+	uint32_t i = 0;
+	bool negative = false;
+	if (p[i] == '-') {
+		negative = true;
+		i++;
+	}
+	if (i == len || !is_digit(p[i])) {
+		return _set_error("Malformed number.");
+	}
+
+	if (p[i] == '0' && i + 1 < len && is_digit(p[i + 1])) {
+		return _set_error("Malformed number, leading zeros are not allowed.");
+	}
+
+	number_is_integer = true;
+	uint64_t magnitude = 0;
+	for (; i < len && is_digit(p[i]); i++) {
+		uint32_t digit = p[i] - '0';
+		if (magnitude > (UINT64_MAX - digit) / 10) {
+			number_is_integer = false; // Too large, keep it as a float.
+		}
+		magnitude = magnitude * 10 + digit;
+	}
+	if (i < len && p[i] == '.') {
+		number_is_integer = false;
+		i++;
+		if (i == len || !is_digit(p[i])) {
+			return _set_error("Malformed number.");
+		}
+		while (i < len && is_digit(p[i])) {
+			i++;
+		}
+	}
+	if (i < len && (p[i] == 'e' || p[i] == 'E')) {
+		number_is_integer = false;
+		i++;
+		if (i < len && (p[i] == '+' || p[i] == '-')) {
+			i++;
+		}
+		if (i == len || !is_digit(p[i])) {
+			return _set_error("Malformed number.");
+		}
+		while (i < len && is_digit(p[i])) {
+			i++;
+		}
+	}
+	if (i != len) {
+		return _set_error("Malformed number.");
+	}
+
+	if (number_is_integer) {
+		if (negative ? magnitude > uint64_t(INT64_MAX) + 1 : magnitude > uint64_t(INT64_MAX)) {
+			number_is_integer = false;
+		} else {
+			int_value = negative ? int64_t(0 - magnitude) : int64_t(magnitude);
+		}
+	}
+	text.push_back(0); // Terminated for `String::to_float()`.
+	return OK;
+}
+
+Error JSONReader::_parse_literal() {
+	// The first character was already consumed and stored by the caller.
+	while (is_ascii_alphabet_char(_peek_char())) {
+		text.push_back(char(_next_char()));
+	}
+
+	const uint32_t len = text.size();
+	const char *p = text.ptr();
+	if (len == 4 && strncmp(p, "true", 4) == 0) {
+		event = EVENT_BOOL;
+		bool_value = true;
+	} else if (len == 5 && strncmp(p, "false", 5) == 0) {
+		event = EVENT_BOOL;
+		bool_value = false;
+	} else if (len == 4 && strncmp(p, "null", 4) == 0) {
+		event = EVENT_NULL;
+	} else {
+		return _set_error("Expected 'true', 'false' or 'null', got '" + String::utf8(p, len) + "'.");
+	}
+
+	state = STATE_AFTER_VALUE;
+	return OK;
+}
+
+Error JSONReader::_parse_value_start(int p_char) {
+	switch (p_char) {
+		case '{': {
+			containers.push_back(EVENT_OBJECT_BEGIN);
+			event = EVENT_OBJECT_BEGIN;
+			state = STATE_OBJECT_FIRST;
+			return OK;
+		}
+		case '[': {
+			containers.push_back(EVENT_ARRAY_BEGIN);
+			event = EVENT_ARRAY_BEGIN;
+			state = STATE_ARRAY_FIRST;
+			return OK;
+		}
+		case '"': {
+			Error err = _parse_string();
+			if (err) {
+				return err;
+			}
+			event = EVENT_STRING;
+			state = STATE_AFTER_VALUE;
+			return OK;
+		}
+		default: {
+			text.clear();
+			text.push_back(char(p_char));
+			if (p_char == '-' || is_digit(p_char)) {
+				return _parse_number();
+			} else if (is_ascii_alphabet_char(p_char)) {
+				return _parse_literal();
+			}
+			return _set_error("Expected value.");
+		}
+	}
+}
+
+Error JSONReader::_end_container() {
+	event = containers[containers.size() - 1] == EVENT_OBJECT_BEGIN ? EVENT_OBJECT_END : EVENT_ARRAY_END;
+	containers.resize(containers.size() - 1);
+	state = STATE_AFTER_VALUE;
+	return OK;
+}
+
+Error JSONReader::read() {
+	if (!err_str.is_empty()) {
+		return ERR_PARSE_ERROR;
+	}
+
+	int c = _skip_whitespace();
+
+	if (state == STATE_AFTER_VALUE) {
+		if (containers.is_empty()) {
+			// Documents may follow each other, as in JSON Lines.
+			state = STATE_VALUE;
+		} else {
+			const bool in_object = containers[containers.size() - 1] == EVENT_OBJECT_BEGIN;
+			if (c == ',') {
+				_next_char();
+				state = in_object ? STATE_KEY : STATE_VALUE;
+				c = _skip_whitespace();
+			} else if (c == (in_object ? '}' : ']')) {
+				_next_char();
+				return _end_container();
+			} else if (c < 0) {
+				return _set_error("Unexpected end of file.");
+			} else {
+				return _set_error(in_object ? "Expected ',' or '}'." : "Expected ',' or ']'.");
+			}
+		}
+	}
+
+	if (c < 0) {
+		if (state == STATE_VALUE && containers.is_empty()) {
+			event = EVENT_NONE;
+			return ERR_FILE_EOF;
+		}
+		return _set_error("Unexpected end of file.");
+	}
+
+	switch (state) {
+		case STATE_ARRAY_FIRST: {
+			if (c == ']') {
+				_next_char();
+				return _end_container();
+			}
+			_next_char();
+			return _parse_value_start(c);
+		}
+		case STATE_VALUE: {
+			_next_char();
+			return _parse_value_start(c);
+		}
+		case STATE_OBJECT_FIRST:
+		case STATE_KEY: {
+			if (c == '}' && state == STATE_OBJECT_FIRST) {
+				_next_char();
+				return _end_container();
+			}
+			if (c != '"') {
+				return _set_error("Expected string as object key.");
+			}
+			_next_char();
+			Error err = _parse_string();
+			if (err) {
+				return err;
+			}
+			if (_skip_whitespace() != ':') {
+				return _set_error("Expected ':' after object key.");
+			}
+			_next_char();
+			event = EVENT_KEY;
+			state = STATE_VALUE;
+			return OK;
+		}
+		default: {
+			ERR_FAIL_V(ERR_BUG);
+		}
+	}
+}
+
+Error JSONReader::skip() {
+	if (event == EVENT_KEY) {
+		Error err = read();
+		if (err) {
+			return err;
+		}
+	}
+	if (event != EVENT_OBJECT_BEGIN && event != EVENT_ARRAY_BEGIN) {
+		return OK;
+	}
+
+	// Only the structure is checked, strings and numbers inside aren't decoded.
+	const uint32_t depth = containers.size();
+	skipping = true;
+	Error err = OK;
+	while (containers.size() >= depth) {
+		err = read();
+		if (err) {
+			break;
+		}
+	}
+	skipping = false;
+	return err == ERR_FILE_EOF ? ERR_PARSE_ERROR : err;
+}
+
+Error JSONReader::read_value(Variant &r_value) {
+	if (event == EVENT_KEY) {
+		Error err = read();
+		if (err) {
+			return err == ERR_FILE_EOF ? ERR_PARSE_ERROR : err;
+		}
+	}
+
+	switch (event) {
+		case EVENT_OBJECT_BEGIN: {
+			if (containers.size() > Variant::MAX_RECURSION_DEPTH) {
+				return _set_error("JSON structure is too deep. Bailing.");
+			}
+			Dictionary d;
+			while (true) {
+				Error err = read();
+				if (err) {
+					return err;
+				}
+				if (event == EVENT_OBJECT_END) {
+					break;
+				}
+				String key = get_string();
+				err = read();
+				if (err) {
+					return err;
+				}
+				Variant value;
+				err = read_value(value);
+				if (err) {
+					return err;
+				}
+				d[key] = value;
+			}
+			r_value = d;
+		} break;
+		case EVENT_ARRAY_BEGIN: {
+			if (containers.size() > Variant::MAX_RECURSION_DEPTH) {
+				return _set_error("JSON structure is too deep. Bailing.");
+			}
+			Array a;
+			while (true) {
+				Error err = read();
+				if (err) {
+					return err;
+				}
+				if (event == EVENT_ARRAY_END) {
+					break;
+				}
+				Variant value;
+				err = read_value(value);
+				if (err) {
+					return err;
+				}
+				a.push_back(value);
+			}
+			r_value = a;
+		} break;
+		case EVENT_STRING:
+		case EVENT_NUMBER:
+		case EVENT_BOOL:
+		case EVENT_NULL: {
+			r_value = get_value();
+		} break;
+		default: {
+			ERR_FAIL_V_MSG(ERR_INVALID_DATA, "The current event doesn't start a value.");
+		}
+	}
+
+	return OK;
+}
+
+Variant JSONReader::_read_value_bind() {
+	Variant value;
+	if (read_value(value) != OK) {
+		return Variant();
+	}
+	return value;
+}
+
+String JSONReader::get_string() {
+	ERR_FAIL_COND_V_MSG(event != EVENT_KEY && event != EVENT_STRING, String(), "The current event is not a key or a string.");
+	if (!string_ready) {
+		string_value.parse_utf8(text.ptr(), text.size());
+		string_ready = true;
+	}
+	return string_value;
+}
+
+bool JSONReader::get_bool() const {
+	ERR_FAIL_COND_V_MSG(event != EVENT_BOOL, false, "The current event is not a boolean.");
+	return bool_value;
+}
+
+bool JSONReader::is_integer() const {
+	return event == EVENT_NUMBER && number_is_integer;
+}
+
+int64_t JSONReader::get_int() const {
+	ERR_FAIL_COND_V_MSG(event != EVENT_NUMBER, 0, "The current event is not a number.");
+	if (number_is_integer) {
+		return int_value;
+	}
+	return int64_t(String::to_float(text.ptr()));
+}
+
+double JSONReader::get_float() const {
+	ERR_FAIL_COND_V_MSG(event != EVENT_NUMBER, 0, "The current event is not a number.");
+	if (number_is_integer) {
+		return double(int_value);
+	}
+	return String::to_float(text.ptr());
+}
+
+Variant JSONReader::get_value() {
+	switch (event) {
+		case EVENT_KEY:
+		case EVENT_STRING:
+			return get_string();
+		case EVENT_NUMBER:
+			return get_float(); // Same as `JSON.parse()`, use `get_int()` for integers.
+		case EVENT_BOOL:
+			return bool_value;
+		default:
+			return Variant();
+	}
+}
+
+void JSONReader::_reset(const Ref<FileAccess> &p_file, const Ref<StreamPeer> &p_stream) {
+	file = p_file;
+	stream = p_stream;
+	chunk.clear();
+	chunk_pos = 0;
+	chunk_len = 0;
+	source_eof = file.is_null() && stream.is_null();
+
+	state = STATE_VALUE;
+	containers.clear();
+	skipping = false;
+	event = EVENT_NONE;
+	text.clear();
+	string_value = String();
+	string_ready = false;
+
+	line = 1;
+	err_str = String();
+	err_line = 0;
+}
+
+Error JSONReader::open(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, "Cannot open file '" + p_path + "'.");
+	_reset(f, Ref<StreamPeer>());
+	return OK;
+}
+
+Error JSONReader::open_file(const Ref<FileAccess> &p_file) {
+	ERR_FAIL_COND_V(p_file.is_null(), ERR_INVALID_PARAMETER);
+	_reset(p_file, Ref<StreamPeer>());
+	return OK;
+}
+
+Error JSONReader::open_stream(const Ref<StreamPeer> &p_stream) {
+	ERR_FAIL_COND_V(p_stream.is_null(), ERR_INVALID_PARAMETER);
+	_reset(Ref<FileAccess>(), p_stream);
+	return OK;
+}
+
+Error JSONReader::open_buffer(const Vector<uint8_t> &p_buffer) {
+	_reset(Ref<FileAccess>(), Ref<StreamPeer>());
+	chunk.resize(p_buffer.size());
+	if (p_buffer.size()) {
+		memcpy(chunk.ptr(), p_buffer.ptr(), p_buffer.size());
+	}
+	chunk_len = p_buffer.size();
+	return OK;
+}
+
+void JSONReader::close() {
+	_reset(Ref<FileAccess>(), Ref<StreamPeer>());
+}
+
+void JSONReader::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("open", "path"), &JSONReader::open);
+	ClassDB::bind_method(D_METHOD("open_file", "file"), &JSONReader::open_file);
+	ClassDB::bind_method(D_METHOD("open_stream", "stream"), &JSONReader::open_stream);
+	ClassDB::bind_method(D_METHOD("open_buffer", "buffer"), &JSONReader::open_buffer);
+	ClassDB::bind_method(D_METHOD("close"), &JSONReader::close);
+
+	ClassDB::bind_method(D_METHOD("read"), &JSONReader::read);
+	ClassDB::bind_method(D_METHOD("skip"), &JSONReader::skip);
+	ClassDB::bind_method(D_METHOD("read_value"), &JSONReader::_read_value_bind);
+
+	ClassDB::bind_method(D_METHOD("get_event_type"), &JSONReader::get_event_type);
+	ClassDB::bind_method(D_METHOD("get_depth"), &JSONReader::get_depth);
+	ClassDB::bind_method(D_METHOD("get_string"), &JSONReader::get_string);
+	ClassDB::bind_method(D_METHOD("get_bool"), &JSONReader::get_bool);
+	ClassDB::bind_method(D_METHOD("is_integer"), &JSONReader::is_integer);
+	ClassDB::bind_method(D_METHOD("get_int"), &JSONReader::get_int);
+	ClassDB::bind_method(D_METHOD("get_float"), &JSONReader::get_float);
+	ClassDB::bind_method(D_METHOD("get_value"), &JSONReader::get_value);
+
+	ClassDB::bind_method(D_METHOD("get_error_line"), &JSONReader::get_error_line);
+	ClassDB::bind_method(D_METHOD("get_error_message"), &JSONReader::get_error_message);
+
+	BIND_ENUM_CONSTANT(EVENT_NONE);
+	BIND_ENUM_CONSTANT(EVENT_OBJECT_BEGIN);
+	BIND_ENUM_CONSTANT(EVENT_OBJECT_END);
+	BIND_ENUM_CONSTANT(EVENT_ARRAY_BEGIN);
+	BIND_ENUM_CONSTANT(EVENT_ARRAY_END);
+	BIND_ENUM_CONSTANT(EVENT_KEY);
+	BIND_ENUM_CONSTANT(EVENT_STRING);
+	BIND_ENUM_CONSTANT(EVENT_NUMBER);
+	BIND_ENUM_CONSTANT(EVENT_BOOL);
+	BIND_ENUM_CONSTANT(EVENT_NULL);
+}
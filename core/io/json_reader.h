@@ -0,0 +1,152 @@
+/**************************************************************************/
+/*  json_reader.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+#include "core/io/file_access.h"
+#include "core/io/stream_peer.h"
+#include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
+
+// Pull parser that reads JSON from a file or stream in chunks, without keeping the whole text in memory.
+class JSONReader : public RefCounted {
+	GDCLASS(JSONReader, RefCounted);
+
+public:
+	enum EventType {
+		EVENT_NONE,
+		EVENT_OBJECT_BEGIN,
+		EVENT_OBJECT_END,
+		EVENT_ARRAY_BEGIN,
+		EVENT_ARRAY_END,
+		EVENT_KEY,
+		EVENT_STRING,
+		EVENT_NUMBER,
+		EVENT_BOOL,
+		EVENT_NULL,
+	};
+
+	enum {
+		READ_CHUNK_SIZE = 65536,
+	};
+
+private:
+	enum State {
+		STATE_VALUE,
+		STATE_ARRAY_FIRST,
+		STATE_OBJECT_FIRST,
+		STATE_KEY,
+		STATE_AFTER_VALUE,
+	};
+
+	Ref<FileAccess> file;
+	Ref<StreamPeer> stream;
+
+	LocalVector<uint8_t> chunk;
+	uint32_t chunk_pos = 0;
+	uint32_t chunk_len = 0;
+	bool source_eof = true;
+
+	State state = STATE_VALUE;
+	LocalVector<EventType> containers; // Begin events of the containers that are currently open.
+	bool skipping = false;
+
+	EventType event = EVENT_NONE;
+	LocalVector<char> text; // UTF-8 of the current key or string, characters of the current number.
+	String string_value;
+	bool string_ready = false;
+	bool bool_value = false;
+	bool number_is_integer = false;
+	int64_t int_value = 0;
+
+	int line = 1;
+	String err_str;
+	int err_line = 0;
+
+	bool _refill();
+	_FORCE_INLINE_ int _peek_char() {
+		if (chunk_pos == chunk_len && !_refill()) {
+			return -1;
+		}
+		return chunk[chunk_pos];
+	}
+	_FORCE_INLINE_ int _next_char() {
+		int c = _peek_char();
+		if (c >= 0) {
+			chunk_pos++;
+			if (c == '\n') {
+				line++;
+			}
+		}
+		return c;
+	}
+	int _skip_whitespace();
+
+	Error _set_error(const String &p_message);
+	Error _parse_string();
+	Error _parse_number();
+	Error _parse_literal();
+	Error _parse_value_start(int p_char);
+	Error _end_container();
+	void _reset(const Ref<FileAccess> &p_file, const Ref<StreamPeer> &p_stream);
+
+	Variant _read_value_bind();
+
+protected:
+	static void _bind_methods();
+
+public:
+	Error open(const String &p_path);
+	Error open_file(const Ref<FileAccess> &p_file);
+	Error open_stream(const Ref<StreamPeer> &p_stream);
+	Error open_buffer(const Vector<uint8_t> &p_buffer);
+	void close();
+
+	Error read();
+	Error skip();
+	Error read_value(Variant &r_value);
+
+	EventType get_event_type() const { return event; }
+	int get_depth() const { return containers.size(); }
+	String get_string();
+	bool get_bool() const;
+	bool is_integer() const;
+	int64_t get_int() const;
+	double get_float() const;
+	Variant get_value();
+
+	int get_error_line() const { return err_line; }
+	String get_error_message() const { return err_str; }
+};
+
+VARIANT_ENUM_CAST(JSONReader::EventType);
+
+#endif // JSON_READER_H
@@ -0,0 +1,363 @@
+/**************************************************************************/
+/*  json_writer.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "json_writer.h"
+
+#include "core/io/json.h"
+
+void JSONWriter::_write_raw(const char *p_data, int p_len) {
+	const uint32_t ofs = pending.size();
+	pending.resize(ofs + p_len);
+	memcpy(pending.ptr() + ofs, p_data, p_len);
+	if (pending.size() >= WRITE_CHUNK_SIZE) {
+		flush();
+	}
+}
+
+void JSONWriter::_write_raw(const String &p_text) {
+	CharString utf8 = p_text.utf8();
+	_write_raw(utf8.get_data(), utf8.length());
+}
+
+void JSONWriter::_write_newline(int p_depth) {
+	if (indent.is_empty()) {
+		return;
+	}
+	_write_raw("\n", 1);
+	for (int i = 0; i < p_depth; i++) {
+		_write_raw(indent);
+	}
+}
+
+Error JSONWriter::_begin_value() {
+	ERR_FAIL_COND_V_MSG(file.is_null() && stream.is_null(), ERR_UNCONFIGURED, "The writer is not open.");
+
+	if (containers.is_empty()) {
+		if (has_root) {
+			// Further documents go on their own line, as in JSON Lines.
+			_write_raw("\n", 1);
+		}
+		has_root = true;
+		return OK;
+	}
+
+	Container &top = containers[containers.size() - 1];
+	if (top.is_object) {
+		ERR_FAIL_COND_V_MSG(!expecting_value, ERR_INVALID_PARAMETER, "Values in an object must be preceded by a key.");
+		expecting_value = false;
+		return OK;
+	}
+
+	if (!top.empty) {
+		_write_raw(",", 1);
+	}
+	top.empty = false;
+	_write_newline(containers.size());
+	return OK;
+}
+
+Error JSONWriter::_write_scalar(const String &p_json) {
+	Error err = _begin_value();
+	if (err) {
+		return err;
+	}
+	_write_raw(p_json);
+	return OK;
+}
+
+Error JSONWriter::begin_object() {
+	Error err = _begin_value();
+	if (err) {
+		return err;
+	}
+	_write_raw("{", 1);
+	Container container;
+	container.is_object = true;
+	containers.push_back(container);
+	return OK;
+}
+
+Error JSONWriter::end_object() {
+	ERR_FAIL_COND_V_MSG(containers.is_empty() || !containers[containers.size() - 1].is_object, ERR_INVALID_PARAMETER, "No object to end.");
+	ERR_FAIL_COND_V_MSG(expecting_value, ERR_INVALID_PARAMETER, "The last key has no value.");
+	const bool empty = containers[containers.size() - 1].empty;
+	containers.resize(containers.size() - 1);
+	if (empty && !indent.is_empty()) {
+		// JSON.stringify() leaves an empty line between the braces of an empty object, but not of an empty array.
+		_write_raw("\n", 1);
+	}
+	_write_newline(containers.size());
+	_write_raw("}", 1);
+	return OK;
+}
+
+Error JSONWriter::begin_array() {
+	Error err = _begin_value();
+	if (err) {
+		return err;
+	}
+	_write_raw("[", 1);
+	containers.push_back(Container());
+	return OK;
+}
+
+Error JSONWriter::end_array() {
+	ERR_FAIL_COND_V_MSG(containers.is_empty() || containers[containers.size() - 1].is_object, ERR_INVALID_PARAMETER, "No array to end.");
+	const bool empty = containers[containers.size() - 1].empty;
+	containers.resize(containers.size() - 1);
+	if (!empty) {
+		_write_newline(containers.size());
+	}
+	_write_raw("]", 1);
+	return OK;
+}
+
+Error JSONWriter::write_key(const String &p_key) {
+	ERR_FAIL_COND_V_MSG(containers.is_empty() || !containers[containers.size() - 1].is_object, ERR_INVALID_PARAMETER, "Keys can only be written inside an object.");
+	ERR_FAIL_COND_V_MSG(expecting_value, ERR_INVALID_PARAMETER, "The previous key has no value.");
+
+	Container &top = containers[containers.size() - 1];
+	if (!top.empty) {
+		_write_raw(",", 1);
+	}
+	top.empty = false;
+	_write_newline(containers.size());
+	_write_raw("\"" + p_key.json_escape() + "\"");
+	if (indent.is_empty()) {
+		_write_raw(":", 1);
+	} else {
+		_write_raw(": ", 2);
+	}
+	expecting_value = true;
+	return OK;
+}
+
+Error JSONWriter::write_string(const String &p_value) {
+	return _write_scalar("\"" + p_value.json_escape() + "\"");
+}
+
+Error JSONWriter::write_int(int64_t p_value) {
+	return _write_scalar(itos(p_value));
+}
+
+Error JSONWriter::write_float(double p_value) {
+	HashSet<const void *> markers;
+	return _write_scalar(JSON::_stringify(p_value, String(), 0, sort_keys, markers, full_precision));
+}
+
+Error JSONWriter::write_bool(bool p_value) {
+	return _write_scalar(p_value ? "true" : "false");
+}
+
+Error JSONWriter::write_null() {
+	return _write_scalar("null");
+}
+
+Error JSONWriter::_write_value(const Variant &p_value, HashSet<const void *> &p_markers) {
+	ERR_FAIL_COND_V_MSG(containers.size() > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "JSON structure is too deep. Bailing.");
+
+	switch (p_value.get_type()) {
+		case Variant::PACKED_INT32_ARRAY:
+		case Variant::PACKED_INT64_ARRAY:
+		case Variant::PACKED_FLOAT32_ARRAY:
+		case Variant::PACKED_FLOAT64_ARRAY:
+		case Variant::PACKED_STRING_ARRAY:
+		case Variant::ARRAY: {
+			Array a = p_value;
+			ERR_FAIL_COND_V_MSG(p_markers.has(a.id()), ERR_INVALID_PARAMETER, "Converting circular structure to JSON.");
+			p_markers.insert(a.id());
+
+			Error err = begin_array();
+			for (int i = 0; i < a.size() && err == OK; i++) {
+				err = _write_value(a[i], p_markers);
+			}
+			if (err == OK) {
+				err = end_array();
+			}
+
+			p_markers.erase(a.id());
+			return err;
+		}
+		case Variant::DICTIONARY: {
+			Dictionary d = p_value;
+			ERR_FAIL_COND_V_MSG(p_markers.has(d.id()), ERR_INVALID_PARAMETER, "Converting circular structure to JSON.");
+			p_markers.insert(d.id());
+
+			List<Variant> keys;
+			d.get_key_list(&keys);
+			if (sort_keys) {
+				keys.sort();
+			}
+
+			Error err = begin_object();
+			for (List<Variant>::Element *E = keys.front(); E && err == OK; E = E->next()) {
+				err = write_key(String(E->get()));
+				if (err == OK) {
+					err = _write_value(d[E->get()], p_markers);
+				}
+			}
+			if (err == OK) {
+				err = end_object();
+			}
+
+			p_markers.erase(d.id());
+			return err;
+		}
+		default: {
+			return _write_scalar(JSON::_stringify(p_value, String(), 0, sort_keys, p_markers, full_precision));
+		}
+	}
+}
+
+Error JSONWriter::write_value(const Variant &p_value) {
+	HashSet<const void *> markers;
+	return _write_value(p_value, markers);
+}
+
+Error JSONWriter::flush() {
+	if (pending.is_empty()) {
+		return OK;
+	}
+
+	Error err = OK;
+	if (file.is_valid()) {
+		file->store_buffer(pending.ptr(), pending.size());
+		err = file->get_error();
+	} else if (stream.is_valid()) {
+		err = stream->put_data(pending.ptr(), pending.size());
+	} else {
+		err = ERR_UNCONFIGURED;
+	}
+	pending.clear();
+	return err;
+}
+
+void JSONWriter::_reset(const Ref<FileAccess> &p_file, const Ref<StreamPeer> &p_stream) {
+	file = p_file;
+	stream = p_stream;
+	pending.clear();
+	containers.clear();
+	expecting_value = false;
+	has_root = false;
+}
+
+Error JSONWriter::open(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, "Cannot open file '" + p_path + "'.");
+	close();
+	_reset(f, Ref<StreamPeer>());
+	return OK;
+}
+
+Error JSONWriter::open_file(const Ref<FileAccess> &p_file) {
+	ERR_FAIL_COND_V(p_file.is_null(), ERR_INVALID_PARAMETER);
+	close();
+	_reset(p_file, Ref<StreamPeer>());
+	return OK;
+}
+
+Error JSONWriter::open_stream(const Ref<StreamPeer> &p_stream) {
+	ERR_FAIL_COND_V(p_stream.is_null(), ERR_INVALID_PARAMETER);
+	close();
+	_reset(Ref<FileAccess>(), p_stream);
+	return OK;
+}
+
+Error JSONWriter::close() {
+	if (file.is_null() && stream.is_null()) {
+		return OK;
+	}
+
+	Error err = flush();
+	const bool complete = containers.is_empty() && !expecting_value;
+	_reset(Ref<FileAccess>(), Ref<StreamPeer>());
+	ERR_FAIL_COND_V_MSG(!complete, ERR_INVALID_DATA, "Closed the writer before ending all objects and arrays.");
+	return err;
+}
+
+void JSONWriter::set_indent(const String &p_indent) {
+	indent = p_indent;
+}
+
+String JSONWriter::get_indent() const {
+	return indent;
+}
+
+void JSONWriter::set_sort_keys(bool p_sort_keys) {
+	sort_keys = p_sort_keys;
+}
+
+bool JSONWriter::is_sort_keys() const {
+	return sort_keys;
+}
+
+void JSONWriter::set_full_precision(bool p_full_precision) {
+	full_precision = p_full_precision;
+}
+
+bool JSONWriter::is_full_precision() const {
+	return full_precision;
+}
+
+void JSONWriter::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("open", "path"), &JSONWriter::open);
+	ClassDB::bind_method(D_METHOD("open_file", "file"), &JSONWriter::open_file);
+	ClassDB::bind_method(D_METHOD("open_stream", "stream"), &JSONWriter::open_stream);
+	ClassDB::bind_method(D_METHOD("flush"), &JSONWriter::flush);
+	ClassDB::bind_method(D_METHOD("close"), &JSONWriter::close);
+
+	ClassDB::bind_method(D_METHOD("set_indent", "indent"), &JSONWriter::set_indent);
+	ClassDB::bind_method(D_METHOD("get_indent"), &JSONWriter::get_indent);
+	ClassDB::bind_method(D_METHOD("set_sort_keys", "enabled"), &JSONWriter::set_sort_keys);
+	ClassDB::bind_method(D_METHOD("is_sort_keys"), &JSONWriter::is_sort_keys);
+	ClassDB::bind_method(D_METHOD("set_full_precision", "enabled"), &JSONWriter::set_full_precision);
+	ClassDB::bind_method(D_METHOD("is_full_precision"), &JSONWriter::is_full_precision);
+
+	ClassDB::bind_method(D_METHOD("begin_object"), &JSONWriter::begin_object);
+	ClassDB::bind_method(D_METHOD("end_object"), &JSONWriter::end_object);
+	ClassDB::bind_method(D_METHOD("begin_array"), &JSONWriter::begin_array);
+	ClassDB::bind_method(D_METHOD("end_array"), &JSONWriter::end_array);
+	ClassDB::bind_method(D_METHOD("write_key", "key"), &JSONWriter::write_key);
+	ClassDB::bind_method(D_METHOD("write_string", "value"), &JSONWriter::write_string);
+	ClassDB::bind_method(D_METHOD("write_int", "value"), &JSONWriter::write_int);
+	ClassDB::bind_method(D_METHOD("write_float", "value"), &JSONWriter::write_float);
+	ClassDB::bind_method(D_METHOD("write_bool", "value"), &JSONWriter::write_bool);
+	ClassDB::bind_method(D_METHOD("write_null"), &JSONWriter::write_null);
+	ClassDB::bind_method(D_METHOD("write_value", "value"), &JSONWriter::write_value);
+
+	ADD_PROPERTY(PropertyInfo(Variant::STRING, "indent"), "set_indent", "get_indent");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "sort_keys"), "set_sort_keys", "is_sort_keys");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "full_precision"), "set_full_precision", "is_full_precision");
+}
+
+JSONWriter::~JSONWriter() {
+	flush();
+}
@@ -0,0 +1,107 @@
+/**************************************************************************/
+/*  json_writer.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include "core/io/file_access.h"
+#include "core/io/stream_peer.h"
+#include "core/object/ref_counted.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+
+// Writes JSON to a file or stream as it is produced, without building the whole text in memory.
+class JSONWriter : public RefCounted {
+	GDCLASS(JSONWriter, RefCounted);
+
+public:
+	enum {
+		WRITE_CHUNK_SIZE = 65536,
+	};
+
+private:
+	struct Container {
+		bool is_object = false;
+		bool empty = true;
+	};
+
+	Ref<FileAccess> file;
+	Ref<StreamPeer> stream;
+	LocalVector<uint8_t> pending;
+
+	LocalVector<Container> containers;
+	bool expecting_value = false; // A key was written, its value comes next.
+	bool has_root = false;
+
+	String indent;
+	bool sort_keys = true;
+	bool full_precision = false;
+
+	void _reset(const Ref<FileAccess> &p_file, const Ref<StreamPeer> &p_stream);
+	void _write_raw(const char *p_data, int p_len);
+	void _write_raw(const String &p_text);
+	void _write_newline(int p_depth);
+	Error _begin_value();
+	Error _write_scalar(const String &p_json);
+	Error _write_value(const Variant &p_value, HashSet<const void *> &p_markers);
+
+protected:
+	static void _bind_methods();
+
+public:
+	Error open(const String &p_path);
+	Error open_file(const Ref<FileAccess> &p_file);
+	Error open_stream(const Ref<StreamPeer> &p_stream);
+	Error flush();
+	Error close();
+
+	void set_indent(const String &p_indent);
+	String get_indent() const;
+	void set_sort_keys(bool p_sort_keys);
+	bool is_sort_keys() const;
+	void set_full_precision(bool p_full_precision);
+	bool is_full_precision() const;
+
+	Error begin_object();
+	Error end_object();
+	Error begin_array();
+	Error end_array();
+	Error write_key(const String &p_key);
+	Error write_string(const String &p_value);
+	Error write_int(int64_t p_value);
+	Error write_float(double p_value);
+	Error write_bool(bool p_value);
+	Error write_null();
+	Error write_value(const Variant &p_value);
+
+	~JSONWriter();
+};
+
+#endif // JSON_WRITER_H
@@ -35,6 +35,8 @@
 #include "core/object/script_language.h"
 #include "core/os/keyboard.h"
 #include "core/string/print_string.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 
 #include <limits.h>
 #include <stdio.h>
@@ -74,6 +76,182 @@ ObjectID EncodedObjectAsID::get_object_id() const {
 #define HEADER_DATA_FIELD_TYPED_ARRAY_CLASS_NAME (0b10 << 16)
 #define HEADER_DATA_FIELD_TYPED_ARRAY_SCRIPT (0b11 << 16)
 
+// Compact encoding only (see `encode_variant()`), older decoders don't know about these.
+
+// For `Variant::STRING` and `Variant::STRING_NAME`.
+// A definition is a regular string that is also appended to the string table of the buffer,
+// a reference only stores the index of an earlier definition as a 32-bit integer.
+#define HEADER_DATA_FLAG_STRING_DEF (1 << 16)
+#define HEADER_DATA_FLAG_STRING_REF (1 << 17)
+
+// For `Variant::ARRAY` with a builtin type.
+// Elements are stored back to back without their own headers, see `_get_packed_array_element_size()`.
+#define HEADER_DATA_FLAG_ARRAY_PACKED (1 << 18)
+#define HEADER_DATA_FLAG_ARRAY_PACKED_64 (1 << 19)
+
+// Packed arrays are stored as little-endian scalars, so whole arrays can be copied at once
+// as long as the host is little-endian and the scalar types match.
+template <typename T>
+static _FORCE_INLINE_ void _decode_scalars(T *r_dst, const uint8_t *p_src, int64_t p_count) {
+	static_assert(sizeof(T) == 4 || sizeof(T) == 8);
+#ifdef BIG_ENDIAN_ENABLED
+	for (int64_t i = 0; i < p_count; i++) {
+		if constexpr (sizeof(T) == 4) {
+			uint32_t u = decode_uint32(p_src + i * 4);
+			memcpy(&r_dst[i], &u, 4);
+		} else {
+			uint64_t u = decode_uint64(p_src + i * 8);
+			memcpy(&r_dst[i], &u, 8);
+		}
+	}
+#else
+	memcpy(r_dst, p_src, p_count * sizeof(T));
+#endif // BIG_ENDIAN_ENABLED
+}
+
+template <typename T>
+static _FORCE_INLINE_ void _encode_scalars(const T *p_src, uint8_t *r_dst, int64_t p_count) {
+	static_assert(sizeof(T) == 4 || sizeof(T) == 8);
+	if (p_count == 0) {
+		return; // Empty arrays have no data pointer.
+	}
+#ifdef BIG_ENDIAN_ENABLED
+	for (int64_t i = 0; i < p_count; i++) {
+		if constexpr (sizeof(T) == 4) {
+			uint32_t u;
+			memcpy(&u, &p_src[i], 4);
+			encode_uint32(u, r_dst + i * 4);
+		} else {
+			uint64_t u;
+			memcpy(&u, &p_src[i], 8);
+			encode_uint64(u, r_dst + i * 8);
+		}
+	}
+#else
+	memcpy(r_dst, p_src, p_count * sizeof(T));
+#endif // BIG_ENDIAN_ENABLED
+}
+
+// Returns the size of one element of a packed typed array, or 0 if the type can't be packed.
+static int _get_packed_array_element_size(Variant::Type p_type, bool p_64) {
+	const int real_size = p_64 ? sizeof(double) : sizeof(float);
+	switch (p_type) {
+		case Variant::INT:
+		case Variant::FLOAT:
+			return 8;
+		case Variant::VECTOR2:
+			return real_size * 2;
+		case Variant::VECTOR2I:
+			return 4 * 2;
+		case Variant::VECTOR3:
+			return real_size * 3;
+		case Variant::VECTOR3I:
+			return 4 * 3;
+		case Variant::VECTOR4:
+			return real_size * 4;
+		case Variant::VECTOR4I:
+			return 4 * 4;
+		case Variant::COLOR:
+			return 4 * 4; // Colors should always be in single-precision.
+		default:
+			return 0;
+	}
+}
+
+static void _decode_packed_array_element(Variant &r_variant, Variant::Type p_type, bool p_64, const uint8_t *p_buf) {
+#define DECODE_REAL(m_ofs) (p_64 ? (real_t)decode_double(p_buf + (m_ofs) * sizeof(double)) : (real_t)decode_float(p_buf + (m_ofs) * sizeof(float)))
+	switch (p_type) {
+		case Variant::INT: {
+			r_variant = (int64_t)decode_uint64(p_buf);
+		} break;
+		case Variant::FLOAT: {
+			r_variant = decode_double(p_buf);
+		} break;
+		case Variant::VECTOR2: {
+			r_variant = Vector2(DECODE_REAL(0), DECODE_REAL(1));
+		} break;
+		case Variant::VECTOR2I: {
+			r_variant = Vector2i(decode_uint32(p_buf), decode_uint32(p_buf + 4));
+		} break;
+		case Variant::VECTOR3: {
+			r_variant = Vector3(DECODE_REAL(0), DECODE_REAL(1), DECODE_REAL(2));
+		} break;
+		case Variant::VECTOR3I: {
+			r_variant = Vector3i(decode_uint32(p_buf), decode_uint32(p_buf + 4), decode_uint32(p_buf + 8));
+		} break;
+		case Variant::VECTOR4: {
+			r_variant = Vector4(DECODE_REAL(0), DECODE_REAL(1), DECODE_REAL(2), DECODE_REAL(3));
+		} break;
+		case Variant::VECTOR4I: {
+			r_variant = Vector4i(decode_uint32(p_buf), decode_uint32(p_buf + 4), decode_uint32(p_buf + 8), decode_uint32(p_buf + 12));
+		} break;
+		case Variant::COLOR: {
+			r_variant = Color(decode_float(p_buf), decode_float(p_buf + 4), decode_float(p_buf + 8), decode_float(p_buf + 12));
+		} break;
+		default: {
+			ERR_FAIL();
+		}
+	}
+#undef DECODE_REAL
+}
+
+static void _encode_packed_array_element(const Variant &p_variant, Variant::Type p_type, uint8_t *p_buf) {
+	switch (p_type) {
+		case Variant::INT: {
+			encode_uint64(p_variant.operator int64_t(), p_buf);
+		} break;
+		case Variant::FLOAT: {
+			encode_double(p_variant.operator double(), p_buf);
+		} break;
+		case Variant::VECTOR2: {
+			Vector2 v = p_variant;
+			encode_real(v.x, p_buf + sizeof(real_t) * 0);
+			encode_real(v.y, p_buf + sizeof(real_t) * 1);
+		} break;
+		case Variant::VECTOR2I: {
+			Vector2i v = p_variant;
+			encode_uint32(v.x, p_buf + 4 * 0);
+			encode_uint32(v.y, p_buf + 4 * 1);
+		} break;
+		case Variant::VECTOR3: {
+			Vector3 v = p_variant;
+			encode_real(v.x, p_buf + sizeof(real_t) * 0);
+			encode_real(v.y, p_buf + sizeof(real_t) * 1);
+			encode_real(v.z, p_buf + sizeof(real_t) * 2);
+		} break;
+		case Variant::VECTOR3I: {
+			Vector3i v = p_variant;
+			encode_uint32(v.x, p_buf + 4 * 0);
+			encode_uint32(v.y, p_buf + 4 * 1);
+			encode_uint32(v.z, p_buf + 4 * 2);
+		} break;
+		case Variant::VECTOR4: {
+			Vector4 v = p_variant;
+			encode_real(v.x, p_buf + sizeof(real_t) * 0);
+			encode_real(v.y, p_buf + sizeof(real_t) * 1);
+			encode_real(v.z, p_buf + sizeof(real_t) * 2);
+			encode_real(v.w, p_buf + sizeof(real_t) * 3);
+		} break;
+		case Variant::VECTOR4I: {
+			Vector4i v = p_variant;
+			encode_uint32(v.x, p_buf + 4 * 0);
+			encode_uint32(v.y, p_buf + 4 * 1);
+			encode_uint32(v.z, p_buf + 4 * 2);
+			encode_uint32(v.w, p_buf + 4 * 3);
+		} break;
+		case Variant::COLOR: {
+			Color c = p_variant;
+			encode_float(c.r, p_buf + 4 * 0);
+			encode_float(c.g, p_buf + 4 * 1);
+			encode_float(c.b, p_buf + 4 * 2);
+			encode_float(c.a, p_buf + 4 * 3);
+		} break;
+		default: {
+			ERR_FAIL();
+		}
+	}
+}
+
 static Error _decode_string(const uint8_t *&buf, int &len, int *r_len, String &r_string) {
 	ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
 
@@ -109,7 +287,32 @@ static Error _decode_string(const uint8_t *&buf, int &len, int *r_len, String &r
 	return OK;
 }
 
-Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects, int p_depth) {
+static Error _decode_string_entry(uint32_t p_header, const uint8_t *&buf, int &len, int *r_len, LocalVector<String> &r_strings, String &r_string) {
+	if (p_header & HEADER_DATA_FLAG_STRING_REF) {
+		ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
+		uint32_t index = decode_uint32(buf);
+		ERR_FAIL_UNSIGNED_INDEX_V(index, r_strings.size(), ERR_INVALID_DATA);
+		r_string = r_strings[index];
+
+		buf += 4;
+		len -= 4;
+		if (r_len) {
+			(*r_len) += 4;
+		}
+		return OK;
+	}
+
+	Error err = _decode_string(buf, len, r_len, r_string);
+	if (err) {
+		return err;
+	}
+	if (p_header & HEADER_DATA_FLAG_STRING_DEF) {
+		r_strings.push_back(r_string);
+	}
+	return OK;
+}
+
+static Error _decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects, int p_depth, LocalVector<String> &r_strings) {
 	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Variant is too deep. Bailing.");
 	const uint8_t *buf = p_buffer;
 	int len = p_len;
@@ -180,7 +383,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 		} break;
 		case Variant::STRING: {
 			String str;
-			Error err = _decode_string(buf, len, r_len, str);
+			Error err = _decode_string_entry(header, buf, len, r_len, r_strings, str);
 			if (err) {
 				return err;
 			}
@@ -555,7 +758,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 		} break;
 		case Variant::STRING_NAME: {
 			String str;
-			Error err = _decode_string(buf, len, r_len, str);
+			Error err = _decode_string_entry(header, buf, len, r_len, r_strings, str);
 			if (err) {
 				return err;
 			}
@@ -684,7 +887,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 						Variant value;
 						int used;
-						err = decode_variant(value, buf, len, &used, p_allow_objects, p_depth + 1);
+						err = _decode_variant(value, buf, len, &used, p_allow_objects, p_depth + 1, r_strings);
 						if (err) {
 							return err;
 						}
@@ -749,7 +952,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				Variant key, value;
 
 				int used;
-				Error err = decode_variant(key, buf, len, &used, p_allow_objects, p_depth + 1);
+				Error err = _decode_variant(key, buf, len, &used, p_allow_objects, p_depth + 1, r_strings);
 				ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
 
 				buf += used;
@@ -758,7 +961,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					(*r_len) += used;
 				}
 
-				err = decode_variant(value, buf, len, &used, p_allow_objects, p_depth + 1);
+				err = _decode_variant(value, buf, len, &used, p_allow_objects, p_depth + 1, r_strings);
 				ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
 
 				buf += used;
@@ -850,16 +1053,48 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				varr.set_typed(builtin_type, class_name, script);
 			}
 
-			for (int i = 0; i < count; i++) {
-				int used = 0;
-				Variant v;
-				Error err = decode_variant(v, buf, len, &used, p_allow_objects, p_depth + 1);
-				ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
-				buf += used;
-				len -= used;
-				varr.push_back(v);
+			if (header & HEADER_DATA_FLAG_ARRAY_PACKED) {
+				ERR_FAIL_COND_V((header & HEADER_DATA_FIELD_TYPED_ARRAY_MASK) != HEADER_DATA_FIELD_TYPED_ARRAY_BUILTIN, ERR_INVALID_DATA);
+				const bool is_64 = header & HEADER_DATA_FLAG_ARRAY_PACKED_64;
+				const int element_size = _get_packed_array_element_size(builtin_type, is_64);
+				ERR_FAIL_COND_V(element_size == 0, ERR_INVALID_DATA);
+				ERR_FAIL_MUL_OF(count, element_size, ERR_INVALID_DATA);
+				ERR_FAIL_COND_V(count * element_size > len, ERR_INVALID_DATA);
+
+				// The array is typed, so elements can be written without going through validation.
+				varr.resize(count);
+				for (int i = 0; i < count; i++) {
+					_decode_packed_array_element(varr[i], builtin_type, is_64, buf + i * element_size);
+				}
+
+				buf += count * element_size;
+				len -= count * element_size;
 				if (r_len) {
-					(*r_len) += used;
+					(*r_len) += count * element_size;
+				}
+			} else {
+				// Every element takes at least its header, don't trust the count any further than that.
+				ERR_FAIL_COND_V(count > len / 4, ERR_INVALID_DATA);
+				varr.resize(count);
+
+				for (int i = 0; i < count; i++) {
+					int used = 0;
+					Error err;
+					if (builtin_type == Variant::VARIANT_MAX) {
+						err = _decode_variant(varr[i], buf, len, &used, p_allow_objects, p_depth + 1, r_strings);
+					} else {
+						Variant v;
+						err = _decode_variant(v, buf, len, &used, p_allow_objects, p_depth + 1, r_strings);
+						if (err == OK) {
+							varr.set(i, v);
+						}
+					}
+					ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
+					buf += used;
+					len -= used;
+					if (r_len) {
+						(*r_len) += used;
+					}
 				}
 			}
 
@@ -879,10 +1114,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			if (count) {
 				data.resize(count);
-				uint8_t *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = buf[i];
-				}
+				memcpy(data.ptrw(), buf, count);
 			}
 
 			r_variant = data;
@@ -906,12 +1138,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			Vector<int32_t> data;
 
 			if (count) {
-				//const int*rbuf=(const int*)buf;
 				data.resize(count);
-				int32_t *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = decode_uint32(&buf[i * 4]);
-				}
+				_decode_scalars(data.ptrw(), buf, count);
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -930,12 +1158,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			Vector<int64_t> data;
 
 			if (count) {
-				//const int*rbuf=(const int*)buf;
 				data.resize(count);
-				int64_t *w = data.ptrw();
-				for (int64_t i = 0; i < count; i++) {
-					w[i] = decode_uint64(&buf[i * 8]);
-				}
+				_decode_scalars(data.ptrw(), buf, count);
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -954,12 +1178,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			Vector<float> data;
 
 			if (count) {
-				//const float*rbuf=(const float*)buf;
 				data.resize(count);
-				float *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = decode_float(&buf[i * 4]);
-				}
+				_decode_scalars(data.ptrw(), buf, count);
 			}
 			r_variant = data;
 
@@ -980,10 +1200,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			if (count) {
 				data.resize(count);
-				double *w = data.ptrw();
-				for (int64_t i = 0; i < count; i++) {
-					w[i] = decode_double(&buf[i * 8]);
-				}
+				_decode_scalars(data.ptrw(), buf, count);
 			}
 			r_variant = data;
 
@@ -1037,10 +1254,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector2 *w = varray.ptrw();
 
+#ifdef REAL_T_IS_DOUBLE
+					_decode_scalars((real_t *)w, buf, count * 2);
+#else
 					for (int32_t i = 0; i < count; i++) {
 						w[i].x = decode_double(buf + i * sizeof(double) * 2 + sizeof(double) * 0);
 						w[i].y = decode_double(buf + i * sizeof(double) * 2 + sizeof(double) * 1);
 					}
+#endif // REAL_T_IS_DOUBLE
 
 					int adv = sizeof(double) * 2 * count;
 
@@ -1062,10 +1283,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector2 *w = varray.ptrw();
 
+#ifndef REAL_T_IS_DOUBLE
+					_decode_scalars((real_t *)w, buf, count * 2);
+#else
 					for (int32_t i = 0; i < count; i++) {
 						w[i].x = decode_float(buf + i * sizeof(float) * 2 + sizeof(float) * 0);
 						w[i].y = decode_float(buf + i * sizeof(float) * 2 + sizeof(float) * 1);
 					}
+#endif // REAL_T_IS_DOUBLE
 
 					int adv = sizeof(float) * 2 * count;
 
@@ -1097,11 +1322,15 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector3 *w = varray.ptrw();
 
+#ifdef REAL_T_IS_DOUBLE
+					_decode_scalars((real_t *)w, buf, count * 3);
+#else
 					for (int32_t i = 0; i < count; i++) {
 						w[i].x = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 0);
 						w[i].y = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 1);
 						w[i].z = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 2);
 					}
+#endif // REAL_T_IS_DOUBLE
 
 					int adv = sizeof(double) * 3 * count;
 
@@ -1123,11 +1352,15 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector3 *w = varray.ptrw();
 
+#ifndef REAL_T_IS_DOUBLE
+					_decode_scalars((real_t *)w, buf, count * 3);
+#else
 					for (int32_t i = 0; i < count; i++) {
 						w[i].x = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 0);
 						w[i].y = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 1);
 						w[i].z = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 2);
 					}
+#endif // REAL_T_IS_DOUBLE
 
 					int adv = sizeof(float) * 3 * count;
 
@@ -1160,13 +1393,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				carray.resize(count);
 				Color *w = carray.ptrw();
 
-				for (int32_t i = 0; i < count; i++) {
-					// Colors should always be in single-precision.
-					w[i].r = decode_float(buf + i * 4 * 4 + 4 * 0);
-					w[i].g = decode_float(buf + i * 4 * 4 + 4 * 1);
-					w[i].b = decode_float(buf + i * 4 * 4 + 4 * 2);
-					w[i].a = decode_float(buf + i * 4 * 4 + 4 * 3);
-				}
+				// Colors should always be in single-precision.
+				_decode_scalars((float *)w, buf, count * 4);
 
 				int adv = 4 * 4 * count;
 
@@ -1199,12 +1427,16 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector4 *w = varray.ptrw();
 
+#ifdef REAL_T_IS_DOUBLE
+					_decode_scalars((real_t *)w, buf, count * 4);
+#else
 					for (int32_t i = 0; i < count; i++) {
 						w[i].x = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 0);
 						w[i].y = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 1);
 						w[i].z = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 2);
 						w[i].w = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 3);
 					}
+#endif // REAL_T_IS_DOUBLE
 
 					int adv = sizeof(double) * 4 * count;
 
@@ -1226,12 +1458,16 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector4 *w = varray.ptrw();
 
+#ifndef REAL_T_IS_DOUBLE
+					_decode_scalars((real_t *)w, buf, count * 4);
+#else
 					for (int32_t i = 0; i < count; i++) {
 						w[i].x = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 0);
 						w[i].y = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 1);
 						w[i].z = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 2);
 						w[i].w = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 3);
 					}
+#endif // REAL_T_IS_DOUBLE
 
 					int adv = sizeof(float) * 4 * count;
 
@@ -1253,7 +1489,19 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 	return OK;
 }
 
+Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects, int p_depth) {
+	LocalVector<String> strings;
+	return _decode_variant(r_variant, p_buffer, p_len, r_len, p_allow_objects, p_depth, strings);
+}
+
 static void _encode_string(const String &p_string, uint8_t *&buf, int &r_len) {
+	if (!buf) {
+		// Only measuring, no need to convert.
+		r_len += 4 + p_string.utf8_length();
+		r_len += (4 - r_len % 4) % 4; // Pad.
+		return;
+	}
+
 	CharString utf8 = p_string.utf8();
 
 	if (buf) {
@@ -1272,15 +1520,34 @@ static void _encode_string(const String &p_string, uint8_t *&buf, int &r_len) {
 	}
 }
 
-Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects, int p_depth) {
+// `p_strings` is only set for compact encoding, see `encode_variant()`.
+static Error _encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects, int p_depth, HashMap<String, uint32_t> *p_strings) {
 	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Potential infinite recursion detected. Bailing.");
 	uint8_t *buf = r_buffer;
 
 	r_len = 0;
 
 	uint32_t header = p_variant.get_type();
+	uint32_t string_index = 0;
+	int packed_element_size = 0;
 
 	switch (p_variant.get_type()) {
+		case Variant::STRING:
+		case Variant::STRING_NAME: {
+			if (p_strings) {
+				String str = p_variant;
+				if (!str.is_empty()) {
+					const uint32_t *index = p_strings->getptr(str);
+					if (index) {
+						header |= HEADER_DATA_FLAG_STRING_REF;
+						string_index = *index;
+					} else {
+						header |= HEADER_DATA_FLAG_STRING_DEF;
+						p_strings->insert(str, p_strings->size());
+					}
+				}
+			}
+		} break;
 		case Variant::INT: {
 			int64_t val = p_variant;
 			if (val > (int64_t)INT_MAX || val < (int64_t)INT_MIN) {
@@ -1322,6 +1589,17 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 					// No need to check `p_full_objects` since for `Variant::OBJECT`
 					// `array.get_typed_class_name()` should be non-empty.
 					header |= HEADER_DATA_FIELD_TYPED_ARRAY_BUILTIN;
+
+					if (p_strings) {
+						const bool is_64 = sizeof(real_t) == sizeof(double);
+						packed_element_size = _get_packed_array_element_size(Variant::Type(array.get_typed_builtin()), is_64);
+						if (packed_element_size) {
+							header |= HEADER_DATA_FLAG_ARRAY_PACKED;
+							if (is_64) {
+								header |= HEADER_DATA_FLAG_ARRAY_PACKED_64;
+							}
+						}
+					}
 				}
 			}
 		} break;
@@ -1447,7 +1725,15 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 		} break;
 		case Variant::STRING:
 		case Variant::STRING_NAME: {
-			_encode_string(p_variant, buf, r_len);
+			if (header & HEADER_DATA_FLAG_STRING_REF) {
+				if (buf) {
+					encode_uint32(string_index, buf);
+					buf += 4;
+				}
+				r_len += 4;
+			} else {
+				_encode_string(p_variant, buf, r_len);
+			}
 
 		} break;
 
@@ -1709,7 +1995,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 						}
 
 						int len;
-						Error err = encode_variant(value, buf, len, p_full_objects, p_depth + 1);
+						Error err = _encode_variant(value, buf, len, p_full_objects, p_depth + 1, p_strings);
 						ERR_FAIL_COND_V(err, err);
 						ERR_FAIL_COND_V(len % 4, ERR_BUG);
 						r_len += len;
@@ -1759,7 +2045,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
 			for (const Variant &E : keys) {
 				int len;
-				Error err = encode_variant(E, buf, len, p_full_objects, p_depth + 1);
+				Error err = _encode_variant(E, buf, len, p_full_objects, p_depth + 1, p_strings);
 				ERR_FAIL_COND_V(err, err);
 				ERR_FAIL_COND_V(len % 4, ERR_BUG);
 				r_len += len;
@@ -1768,7 +2054,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 				}
 				Variant *v = d.getptr(E);
 				ERR_FAIL_NULL_V(v, ERR_BUG);
-				err = encode_variant(*v, buf, len, p_full_objects, p_depth + 1);
+				err = _encode_variant(*v, buf, len, p_full_objects, p_depth + 1, p_strings);
 				ERR_FAIL_COND_V(err, err);
 				ERR_FAIL_COND_V(len % 4, ERR_BUG);
 				r_len += len;
@@ -1811,9 +2097,21 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			}
 			r_len += 4;
 
+			if (packed_element_size) {
+				const Variant::Type type = Variant::Type(array.get_typed_builtin());
+				if (buf) {
+					for (const Variant &var : array) {
+						_encode_packed_array_element(var, type, buf);
+						buf += packed_element_size;
+					}
+				}
+				r_len += packed_element_size * array.size();
+				break;
+			}
+
 			for (const Variant &var : array) {
 				int len;
-				Error err = encode_variant(var, buf, len, p_full_objects, p_depth + 1);
+				Error err = _encode_variant(var, buf, len, p_full_objects, p_depth + 1, p_strings);
 				ERR_FAIL_COND_V(err, err);
 				ERR_FAIL_COND_V(len % 4, ERR_BUG);
 				if (buf) {
@@ -1856,10 +2154,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(datalen, buf);
 				buf += 4;
-				const int32_t *r = data.ptr();
-				for (int32_t i = 0; i < datalen; i++) {
-					encode_uint32(r[i], &buf[i * datasize]);
-				}
+				_encode_scalars(data.ptr(), buf, datalen);
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1873,10 +2168,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(datalen, buf);
 				buf += 4;
-				const int64_t *r = data.ptr();
-				for (int64_t i = 0; i < datalen; i++) {
-					encode_uint64(r[i], &buf[i * datasize]);
-				}
+				_encode_scalars(data.ptr(), buf, datalen);
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1890,10 +2182,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(datalen, buf);
 				buf += 4;
-				const float *r = data.ptr();
-				for (int i = 0; i < datalen; i++) {
-					encode_float(r[i], &buf[i * datasize]);
-				}
+				_encode_scalars(data.ptr(), buf, datalen);
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1907,10 +2196,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(datalen, buf);
 				buf += 4;
-				const double *r = data.ptr();
-				for (int i = 0; i < datalen; i++) {
-					encode_double(r[i], &buf[i * datasize]);
-				}
+				_encode_scalars(data.ptr(), buf, datalen);
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1959,13 +2245,8 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			r_len += 4;
 
 			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Vector2 v = data.get(i);
-
-					encode_real(v.x, &buf[0]);
-					encode_real(v.y, &buf[sizeof(real_t)]);
-					buf += sizeof(real_t) * 2;
-				}
+				_encode_scalars((const real_t *)data.ptr(), buf, len * 2);
+				buf += sizeof(real_t) * 2 * len;
 			}
 
 			r_len += sizeof(real_t) * 2 * len;
@@ -1983,14 +2264,8 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			r_len += 4;
 
 			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Vector3 v = data.get(i);
-
-					encode_real(v.x, &buf[0]);
-					encode_real(v.y, &buf[sizeof(real_t)]);
-					encode_real(v.z, &buf[sizeof(real_t) * 2]);
-					buf += sizeof(real_t) * 3;
-				}
+				_encode_scalars((const real_t *)data.ptr(), buf, len * 3);
+				buf += sizeof(real_t) * 3 * len;
 			}
 
 			r_len += sizeof(real_t) * 3 * len;
@@ -2008,15 +2283,9 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			r_len += 4;
 
 			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Color c = data.get(i);
-
-					encode_float(c.r, &buf[0]);
-					encode_float(c.g, &buf[4]);
-					encode_float(c.b, &buf[8]);
-					encode_float(c.a, &buf[12]);
-					buf += 4 * 4; // Colors should always be in single-precision.
-				}
+				// Colors should always be in single-precision.
+				_encode_scalars((const float *)data.ptr(), buf, len * 4);
+				buf += 4 * 4 * len;
 			}
 
 			r_len += 4 * 4 * len;
@@ -2034,15 +2303,8 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			r_len += 4;
 
 			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Vector4 v = data.get(i);
-
-					encode_real(v.x, &buf[0]);
-					encode_real(v.y, &buf[sizeof(real_t)]);
-					encode_real(v.z, &buf[sizeof(real_t) * 2]);
-					encode_real(v.w, &buf[sizeof(real_t) * 3]);
-					buf += sizeof(real_t) * 4;
-				}
+				_encode_scalars((const real_t *)data.ptr(), buf, len * 4);
+				buf += sizeof(real_t) * 4 * len;
 			}
 
 			r_len += sizeof(real_t) * 4 * len;
@@ -2056,6 +2318,14 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 	return OK;
 }
 
+Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects, int p_depth, bool p_compact) {
+	if (p_compact) {
+		HashMap<String, uint32_t> strings;
+		return _encode_variant(p_variant, r_buffer, r_len, p_full_objects, p_depth, &strings);
+	}
+	return _encode_variant(p_variant, r_buffer, r_len, p_full_objects, p_depth, nullptr);
+}
+
 Vector<float> vector3_to_float32_array(const Vector3 *vecs, size_t count) {
 	// We always allocate a new array, and we don't memcpy.
 	// We also don't consider returning a pointer to the passed vectors when sizeof(real_t) == 4.
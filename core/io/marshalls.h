@@ -213,7 +213,11 @@ public:
 };
 
 Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = nullptr, bool p_allow_objects = false, int p_depth = 0);
-Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false, int p_depth = 0);
+// Passing a null `r_buffer` only computes the encoded size in `r_len`.
+// `p_compact` deduplicates strings and stores builtin typed arrays without per-element headers.
+// Only decoders from this version onward understand the result, so keep it to data that is read back
+// by the same engine (e.g. save files, caches) rather than network peers or the debugger.
+Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false, int p_depth = 0, bool p_compact = false);
 
 Vector<float> vector3_to_float32_array(const Vector3 *vecs, size_t count);
 
@@ -530,6 +530,105 @@ String Resource::get_id_for_path(const String &p_path) const {
 }
 #endif
 
+uint64_t Resource::_estimate_variant_size(const Variant &p_variant, HashSet<const Resource *> &r_visited, int p_depth) {
+	if (p_depth > 8) {
+		return 0;
+	}
+
+	switch (p_variant.get_type()) {
+		case Variant::STRING: {
+			return uint64_t(String(p_variant).length()) * sizeof(char32_t);
+		}
+		case Variant::OBJECT: {
+			Ref<Resource> res = p_variant;
+			// External resources are tracked by the cache on their own.
+			if (res.is_valid() && res->is_built_in()) {
+				return res->_get_memory_usage_estimate(r_visited);
+			}
+			return 0;
+		}
+		case Variant::DICTIONARY: {
+			Dictionary d = p_variant;
+			uint64_t size = 0;
+			for (const Variant &key : d.keys()) {
+				size += sizeof(Variant) * 2;
+				size += _estimate_variant_size(key, r_visited, p_depth + 1);
+				size += _estimate_variant_size(d[key], r_visited, p_depth + 1);
+			}
+			return size;
+		}
+		case Variant::ARRAY: {
+			Array a = p_variant;
+			uint64_t size = uint64_t(a.size()) * sizeof(Variant);
+			for (int i = 0; i < a.size(); i++) {
+				size += _estimate_variant_size(a[i], r_visited, p_depth + 1);
+			}
+			return size;
+		}
+		case Variant::PACKED_BYTE_ARRAY: {
+			return uint64_t(PackedByteArray(p_variant).size());
+		}
+		case Variant::PACKED_INT32_ARRAY: {
+			return uint64_t(PackedInt32Array(p_variant).size()) * sizeof(int32_t);
+		}
+		case Variant::PACKED_INT64_ARRAY: {
+			return uint64_t(PackedInt64Array(p_variant).size()) * sizeof(int64_t);
+		}
+		case Variant::PACKED_FLOAT32_ARRAY: {
+			return uint64_t(PackedFloat32Array(p_variant).size()) * sizeof(float);
+		}
+		case Variant::PACKED_FLOAT64_ARRAY: {
+			return uint64_t(PackedFloat64Array(p_variant).size()) * sizeof(double);
+		}
+		case Variant::PACKED_STRING_ARRAY: {
+			PackedStringArray strings = p_variant;
+			uint64_t size = uint64_t(strings.size()) * sizeof(String);
+			for (const String &str : strings) {
+				size += uint64_t(str.length()) * sizeof(char32_t);
+			}
+			return size;
+		}
+		case Variant::PACKED_VECTOR2_ARRAY: {
+			return uint64_t(PackedVector2Array(p_variant).size()) * sizeof(Vector2);
+		}
+		case Variant::PACKED_VECTOR3_ARRAY: {
+			return uint64_t(PackedVector3Array(p_variant).size()) * sizeof(Vector3);
+		}
+		case Variant::PACKED_COLOR_ARRAY: {
+			return uint64_t(PackedColorArray(p_variant).size()) * sizeof(Color);
+		}
+		default: {
+			// Stored inline in the Variant, or small enough not to matter.
+			return 0;
+		}
+	}
+}
+
+uint64_t Resource::_get_memory_usage_estimate(HashSet<const Resource *> &r_visited) const {
+	if (r_visited.has(this)) {
+		return 0;
+	}
+	r_visited.insert(this);
+
+	uint64_t size = sizeof(Resource);
+
+	List<PropertyInfo> plist;
+	get_property_list(&plist);
+	for (const PropertyInfo &E : plist) {
+		if (!(E.usage & PROPERTY_USAGE_STORAGE)) {
+			continue;
+		}
+		size += _estimate_variant_size(get(E.name), r_visited);
+	}
+
+	return size;
+}
+
+uint64_t Resource::get_memory_usage_estimate() const {
+	HashSet<const Resource *> visited;
+	return _get_memory_usage_estimate(visited);
+}
+
 void Resource::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_path", "path"), &Resource::_set_path);
 	ClassDB::bind_method(D_METHOD("take_over_path", "path"), &Resource::_take_over_path);
@@ -593,7 +692,17 @@ Mutex ResourceCache::lock;
 RWLock ResourceCache::path_cache_lock;
 #endif
 
+List<ResourceCache::RetainedResource> ResourceCache::retained_lru;
+HashMap<Resource *, List<ResourceCache::RetainedResource>::Element *> ResourceCache::retained;
+uint64_t ResourceCache::retained_budget = 0;
+uint64_t ResourceCache::retained_memory = 0;
+uint64_t ResourceCache::retained_hits = 0;
+uint64_t ResourceCache::retained_misses = 0;
+uint64_t ResourceCache::retained_evictions = 0;
+
 void ResourceCache::clear() {
+	clear_retained();
+
 	if (!resources.is_empty()) {
 		if (OS::get_singleton()->is_stdout_verbose()) {
 			ERR_PRINT(vformat("%d resources still in use at exit.", resources.size()));
@@ -683,3 +792,116 @@ int ResourceCache::get_cached_resource_count() {
 
 	return rc;
 }
+
+// Must be called with the lock held. Evicted references are handed back so the
+// caller can drop them after unlocking, as freeing a resource takes the lock too.
+void ResourceCache::_evict_retained(LocalVector<Ref<Resource>> &r_evicted) {
+	while (retained_memory > retained_budget && retained_lru.back()) {
+		List<RetainedResource>::Element *E = retained_lru.back();
+		retained_memory -= E->get().size;
+		retained.erase(E->get().resource.ptr());
+		r_evicted.push_back(E->get().resource);
+		retained_lru.erase(E);
+		retained_evictions++;
+	}
+}
+
+void ResourceCache::_retain_loaded(const Ref<Resource> &p_resource) {
+	ERR_FAIL_COND(p_resource.is_null());
+
+	// Estimating may walk the whole resource, so do it before taking the lock.
+	uint64_t size = retained_budget > 0 ? p_resource->get_memory_usage_estimate() : 0;
+
+	LocalVector<Ref<Resource>> evicted;
+	lock.lock();
+
+	retained_misses++;
+
+	if (retained_budget == 0 || size > retained_budget) {
+		lock.unlock();
+		return;
+	}
+
+	List<RetainedResource>::Element **existing = retained.getptr(p_resource.ptr());
+	if (existing) {
+		retained_memory -= (*existing)->get().size;
+		(*existing)->get().size = size;
+		retained_lru.move_to_front(*existing);
+	} else {
+		RetainedResource entry;
+		entry.resource = p_resource;
+		entry.size = size;
+		retained.insert(p_resource.ptr(), retained_lru.push_front(entry));
+	}
+	retained_memory += size;
+
+	_evict_retained(evicted);
+
+	lock.unlock();
+}
+
+void ResourceCache::_touch_retained(const Ref<Resource> &p_resource) {
+	lock.lock();
+
+	List<RetainedResource>::Element **E = retained.getptr(p_resource.ptr());
+	if (E) {
+		retained_lru.move_to_front(*E);
+		// Only the retained entry and the caller hold it, so without the
+		// retained cache this request would have gone back to disk.
+		if (p_resource->get_reference_count() == 2) {
+			retained_hits++;
+		}
+	}
+
+	lock.unlock();
+}
+
+void ResourceCache::set_retained_budget(uint64_t p_bytes) {
+	LocalVector<Ref<Resource>> evicted;
+	lock.lock();
+	retained_budget = p_bytes;
+	_evict_retained(evicted);
+	lock.unlock();
+}
+
+uint64_t ResourceCache::get_retained_budget() {
+	MutexLock mutex_lock(lock);
+	return retained_budget;
+}
+
+uint64_t ResourceCache::get_retained_memory() {
+	MutexLock mutex_lock(lock);
+	return retained_memory;
+}
+
+int ResourceCache::get_retained_count() {
+	MutexLock mutex_lock(lock);
+	return retained.size();
+}
+
+uint64_t ResourceCache::get_retained_hits() {
+	MutexLock mutex_lock(lock);
+	return retained_hits;
+}
+
+uint64_t ResourceCache::get_retained_misses() {
+	MutexLock mutex_lock(lock);
+	return retained_misses;
+}
+
+uint64_t ResourceCache::get_retained_evictions() {
+	MutexLock mutex_lock(lock);
+	return retained_evictions;
+}
+
+void ResourceCache::clear_retained() {
+	LocalVector<Ref<Resource>> to_release;
+	lock.lock();
+	for (const RetainedResource &E : retained_lru) {
+		to_release.push_back(E.resource);
+	}
+	retained_lru.clear();
+	retained.clear();
+	retained_memory = 0;
+	lock.unlock();
+}
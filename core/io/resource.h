@@ -35,6 +35,8 @@
 #include "core/object/class_db.h"
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/ref_counted.h"
+#include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
 
@@ -87,6 +89,12 @@ protected:
 	virtual void reset_local_to_scene();
 	GDVIRTUAL0(_setup_local_to_scene);
 
+	// Approximate memory held by this resource, used to budget the retained resource cache.
+	// The default walks stored properties and built-in sub-resources; resources whose data
+	// lives in a server should override it to report that size without reading it back.
+	virtual uint64_t _get_memory_usage_estimate(HashSet<const Resource *> &r_visited) const;
+	static uint64_t _estimate_variant_size(const Variant &p_variant, HashSet<const Resource *> &r_visited, int p_depth = 0);
+
 public:
 	static Node *(*_get_local_scene_func)(); //used by editor
 	static void (*_update_configuration_warning)(); //used by editor
@@ -142,6 +150,8 @@ public:
 
 	virtual RID get_rid() const; // some resources may offer conversion to RID
 
+	uint64_t get_memory_usage_estimate() const;
+
 #ifdef TOOLS_ENABLED
 	//helps keep IDs same number when loading/saving scenes. -1 clears ID and it Returns -1 when no id stored
 	void set_id_for_path(const String &p_path, const String &p_id);
@@ -157,6 +167,25 @@ class ResourceCache {
 	friend class ResourceLoader; //need the lock
 	static Mutex lock;
 	static HashMap<String, Resource *> resources;
+
+	// Recently loaded resources kept alive after their last user releases them, so that
+	// loading them again does not hit the disk. Front of the list is most recently used.
+	struct RetainedResource {
+		Ref<Resource> resource;
+		uint64_t size = 0;
+	};
+	static List<RetainedResource> retained_lru;
+	static HashMap<Resource *, List<RetainedResource>::Element *> retained;
+	static uint64_t retained_budget;
+	static uint64_t retained_memory;
+	static uint64_t retained_hits;
+	static uint64_t retained_misses;
+	static uint64_t retained_evictions;
+
+	static void _evict_retained(LocalVector<Ref<Resource>> &r_evicted);
+	static void _retain_loaded(const Ref<Resource> &p_resource);
+	static void _touch_retained(const Ref<Resource> &p_resource);
+
 #ifdef TOOLS_ENABLED
 	static HashMap<String, HashMap<String, String>> resource_path_cache; // Each tscn has a set of resource paths and IDs.
 	static RWLock path_cache_lock;
@@ -170,6 +199,15 @@ public:
 	static Ref<Resource> get_ref(const String &p_path);
 	static void get_cached_resources(List<Ref<Resource>> *p_resources);
 	static int get_cached_resource_count();
+
+	static void set_retained_budget(uint64_t p_bytes);
+	static uint64_t get_retained_budget();
+	static uint64_t get_retained_memory();
+	static int get_retained_count();
+	static uint64_t get_retained_hits();
+	static uint64_t get_retained_misses();
+	static uint64_t get_retained_evictions();
+	static void clear_retained();
 };
 
 #endif // RESOURCE_H
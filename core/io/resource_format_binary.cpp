@@ -685,6 +685,7 @@ Error ResourceLoaderBinary::load() {
 		return error;
 	}
 
+	HashSet<String> pending_dependencies;
 	for (int i = 0; i < external_resources.size(); i++) {
 		String path = external_resources[i].path;
 
@@ -698,7 +699,22 @@ Error ResourceLoaderBinary::load() {
 		}
 
 		external_resources.write[i].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
-		external_resources.write[i].load_token = ResourceLoader::_load_start(path, external_resources[i].type, use_sub_threads ? ResourceLoader::LOAD_THREAD_DISTRIBUTE : ResourceLoader::LOAD_THREAD_FROM_CURRENT, cache_mode_for_external);
+
+		if (cache_mode_for_external == ResourceFormatLoader::CACHE_MODE_IGNORE || cache_mode_for_external == ResourceFormatLoader::CACHE_MODE_IGNORE_DEEP || !ResourceCache::has(path)) {
+			pending_dependencies.insert(path);
+		}
+	}
+
+	// Start all dependencies before waiting on any of them, so when there are enough of them
+	// they load concurrently in the WorkerThreadPool instead of one after the other.
+	ResourceLoader::LoadThreadMode dependency_thread_mode = ResourceLoader::LOAD_THREAD_FROM_CURRENT;
+	if (use_sub_threads || ResourceLoader::can_load_dependencies_in_parallel(pending_dependencies.size())) {
+		dependency_thread_mode = ResourceLoader::LOAD_THREAD_DISTRIBUTE;
+	}
+
+	for (int i = 0; i < external_resources.size(); i++) {
+		const String &path = external_resources[i].path;
+		external_resources.write[i].load_token = ResourceLoader::_load_start(path, external_resources[i].type, dependency_thread_mode, cache_mode_for_external);
 		if (!external_resources[i].load_token.is_valid()) {
 			if (!ResourceLoader::get_abort_on_missing_resources()) {
 				ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
@@ -920,8 +936,14 @@ String ResourceLoaderBinary::get_unicode_string() {
 	if (len == 0) {
 		return String();
 	}
-	f->get_buffer((uint8_t *)&str_buf[0], len);
 	String s;
+	const uint8_t *view = f->get_buffer_view(len);
+	if (view) {
+		// Parse straight from the mapped file, skipping the copy into str_buf.
+		s.parse_utf8((const char *)view, len);
+		return s;
+	}
+	f->get_buffer((uint8_t *)&str_buf[0], len);
 	s.parse_utf8(&str_buf[0]);
 	return s;
 }
@@ -363,6 +363,7 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 				}
 			}
 			load_task.resource->set_path(load_task.local_path, replacing);
+			ResourceCache::_retain_loaded(load_task.resource);
 		} else {
 			load_task.resource->set_path_cache(load_task.local_path);
 		}
@@ -508,6 +509,7 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 			if (p_cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE) {
 				Ref<Resource> existing = ResourceCache::get_ref(local_path);
 				if (existing.is_valid()) {
+					ResourceCache::_touch_retained(existing);
 					//referencing is fine
 					load_task.resource = existing;
 					load_task.status = THREAD_LOAD_LOADED;
@@ -784,6 +786,22 @@ bool ResourceLoader::_ensure_load_progress() {
 	return true;
 }
 
+bool ResourceLoader::can_load_dependencies_in_parallel(int p_pending_count) {
+#ifdef THREADS_ENABLED
+	if (parallel_dependency_threshold <= 0 || p_pending_count < parallel_dependency_threshold) {
+		return false;
+	}
+	// A blocking wait on the main thread would stall dependencies that need to sync with the
+	// rendering server, which only progresses on the main thread unless it has its own.
+	if (Thread::is_main_thread() && OS::get_singleton()->get_render_thread_mode() != OS::RENDER_SEPARATE_THREAD) {
+		return false;
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
 Ref<Resource> ResourceLoader::ensure_resource_ref_override_for_outer_load(const String &p_path, const String &p_res_type) {
 	ERR_FAIL_COND_V(load_nesting == 0, Ref<Resource>()); // It makes no sense to use this from nesting level 0.
 	const String &local_path = _validate_local_path(p_path);
@@ -1305,6 +1323,7 @@ DependencyErrorNotify ResourceLoader::dep_err_notify = nullptr;
 
 bool ResourceLoader::create_missing_resources_if_class_unavailable = false;
 bool ResourceLoader::abort_on_missing_resource = true;
+int ResourceLoader::parallel_dependency_threshold = 4;
 bool ResourceLoader::timestamp_on_load = false;
 
 thread_local int ResourceLoader::load_nesting = 0;
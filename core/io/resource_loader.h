@@ -146,6 +146,7 @@ private:
 	static DependencyErrorNotify dep_err_notify;
 	static bool abort_on_missing_resource;
 	static bool create_missing_resources_if_class_unavailable;
+	static int parallel_dependency_threshold;
 	static HashMap<String, Vector<String>> translation_remaps;
 	static HashMap<String, String> path_remaps;
 
@@ -253,6 +254,11 @@ public:
 	static void set_abort_on_missing_resources(bool p_abort) { abort_on_missing_resource = p_abort; }
 	static bool get_abort_on_missing_resources() { return abort_on_missing_resource; }
 
+	// Minimum number of not yet cached dependencies for a loader to fan them out to the WorkerThreadPool, 0 to disable.
+	static void set_parallel_dependency_threshold(int p_threshold) { parallel_dependency_threshold = p_threshold; }
+	static int get_parallel_dependency_threshold() { return parallel_dependency_threshold; }
+	static bool can_load_dependencies_in_parallel(int p_pending_count);
+
 	static String path_remap(const String &p_path);
 	static String import_remap(const String &p_path);
 
@@ -52,6 +52,7 @@
 // and pairable_mask is either 0 if static, or set to all if non static
 
 #include "bvh_tree.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/mutex.h"
 
 #define BVHTREE_CLASS BVH_Tree<T, NUM_TREES, 2, MAX_ITEMS, USER_PAIR_TEST_FUNCTION, USER_CULL_TEST_FUNCTION, USE_PAIRS, BOUNDS, POINT>
@@ -88,6 +89,14 @@ public:
 		tree.params_set_pairing_expansion(p_value);
 	}
 
+	// When at least this many items changed since the last update, the pairing culls
+	// run in parallel on the WorkerThreadPool (0 disables). The pair callbacks are still
+	// sent from the updating thread, in the same order as when culling serially.
+	void params_set_parallel_pairing_threshold(uint32_t p_threshold) {
+		BVH_LOCKED_FUNCTION
+		_parallel_pairing_threshold = p_threshold;
+	}
+
 	void set_pair_callback(PairCallback p_callback, void *p_userdata) {
 		BVH_LOCKED_FUNCTION
 		pair_callback = p_callback;
@@ -344,6 +353,58 @@ public:
 		}
 	}
 
+	// Concurrent culls.
+	// While one thread holds lock_for_concurrent_culls(), the BVH cannot be modified,
+	// and any number of threads may call the *_unlocked() cull tests at the same time,
+	// as long as each of them passes its own hits buffer.
+	void lock_for_concurrent_culls() {
+		if (BVH_THREAD_SAFE && _thread_safe) {
+			_mutex.lock();
+		}
+	}
+
+	void unlock_for_concurrent_culls() {
+		if (BVH_THREAD_SAFE && _thread_safe) {
+			_mutex.unlock();
+		}
+	}
+
+	int cull_aabb_unlocked(const BOUNDS &p_aabb, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask, int *p_subindex_array, LocalVector<uint32_t, uint32_t, true> &r_hits) {
+		typename BVHTREE_CLASS::CullParams params;
+
+		params.result_count_overall = 0;
+		params.result_max = p_result_max;
+		params.result_array = p_result_array;
+		params.subindex_array = p_subindex_array;
+		params.tree_collision_mask = p_tree_collision_mask;
+		params.abb.from(p_aabb);
+		params.tester = p_tester;
+		params.hits = &r_hits;
+
+		tree.cull_aabb(params);
+
+		return params.result_count_overall;
+	}
+
+	int cull_segment_unlocked(const POINT &p_from, const POINT &p_to, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask, int *p_subindex_array, LocalVector<uint32_t, uint32_t, true> &r_hits) {
+		typename BVHTREE_CLASS::CullParams params;
+
+		params.result_count_overall = 0;
+		params.result_max = p_result_max;
+		params.result_array = p_result_array;
+		params.subindex_array = p_subindex_array;
+		params.tester = p_tester;
+		params.tree_collision_mask = p_tree_collision_mask;
+		params.hits = &r_hits;
+
+		params.segment.from = p_from;
+		params.segment.to = p_to;
+
+		tree.cull_segment(params);
+
+		return params.result_count_overall;
+	}
+
 	// cull tests
 	int cull_aabb(const BOUNDS &p_aabb, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
 		BVH_LOCKED_FUNCTION
@@ -444,26 +505,41 @@ private:
 		params.result_array = nullptr;
 		params.subindex_array = nullptr;
 
-		for (const BVHHandle &h : changed_items) {
+		// The culls only read the tree, so they can all be done up front in parallel,
+		// leaving the callbacks (which may not be thread safe) for the loop below.
+		uint32_t changed_count = changed_items.size();
+		bool parallel_culls = _parallel_pairing_threshold && changed_count >= _parallel_pairing_threshold;
+		if (parallel_culls) {
+			if (_pairing_hits.size() < changed_count) {
+				_pairing_hits.resize(changed_count);
+			}
+			WorkerThreadPool::get_singleton()->parallel_for(this, &BVH_Manager::_cull_changed_items, (void *)nullptr, 0, changed_count, 0, SNAME("BVHPairingCulls"));
+		}
+
+		for (uint32_t n = 0; n < changed_count; n++) {
+			const BVHHandle &h = changed_items[n];
+
 			// use the expanded aabb for pairing
 			const BOUNDS &expanded_aabb = tree._pairs[h.id()].expanded_aabb;
 			BVHABB_CLASS abb;
 			abb.from(expanded_aabb);
 
-			tree.item_fill_cullparams(h, params);
-
 			// find all the existing paired aabbs that are no longer
 			// paired, and send callbacks
 			_find_leavers(h, abb, p_full_check);
 
 			uint32_t changed_item_ref_id = h.id();
 
-			params.abb = abb;
+			if (!parallel_culls) {
+				tree.item_fill_cullparams(h, params);
+				params.abb = abb;
 
-			params.result_count_overall = 0; // might not be needed
-			tree.cull_aabb(params, false);
+				params.result_count_overall = 0; // might not be needed
+				tree.cull_aabb(params, false);
+			}
 
-			for (const uint32_t ref_id : tree._cull_hits) {
+			const LocalVector<uint32_t, uint32_t, true> &hits = parallel_culls ? _pairing_hits[n] : tree._cull_hits;
+			for (const uint32_t ref_id : hits) {
 				// don't collide against ourself
 				if (ref_id == changed_item_ref_id) {
 					continue;
@@ -480,6 +556,25 @@ private:
 		_reset();
 	}
 
+	void _cull_changed_items(uint32_t p_from, uint32_t p_to, void *p_userdata) {
+		typename BVHTREE_CLASS::CullParams params;
+
+		params.result_max = INT_MAX;
+		params.result_array = nullptr;
+		params.subindex_array = nullptr;
+
+		for (uint32_t n = p_from; n < p_to; n++) {
+			const BVHHandle &h = changed_items[n];
+
+			tree.item_fill_cullparams(h, params);
+			params.abb.from(tree._pairs[h.id()].expanded_aabb);
+			params.hits = &_pairing_hits[n];
+
+			params.result_count_overall = 0;
+			tree.cull_aabb(params, false);
+		}
+	}
+
 public:
 	void item_get_AABB(BVHHandle p_handle, BOUNDS &r_aabb) {
 		DEV_ASSERT(!p_handle.is_invalid());
@@ -773,6 +868,10 @@ private:
 	LocalVector<BVHHandle, uint32_t, true> changed_items;
 	uint32_t _tick = 1; // Start from 1 so items with 0 indicate never updated.
 
+	// Pairing cull results of each changed item, when culling in parallel.
+	LocalVector<LocalVector<uint32_t, uint32_t, true>> _pairing_hits;
+	uint32_t _parallel_pairing_threshold = 0;
+
 	class BVHLockedFunction {
 	public:
 		BVHLockedFunction(Mutex *p_mutex, bool p_thread_safe) {
@@ -87,28 +87,44 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 	bool low_priority = p_task->low_priority;
 #endif
 
+	LocalVector<Task *> released_to_process_inline;
+
 	if (p_task->group) {
 		// Handling a group
+		Group *group = p_task->group;
 		bool do_post = false;
 
 		while (true) {
-			uint32_t work_index = p_task->group->index.postincrement();
+			// Claim a chunk of elements (a single one unless this is a range group).
+			uint32_t grain = group->grain.get();
+			uint32_t from = group->index.postadd(grain);
 
-			if (work_index >= p_task->group->max) {
+			if (from >= group->max) {
 				break;
 			}
+			uint32_t to = MIN(from + grain, group->max);
+			uint64_t chunk_begin_usec = group->auto_grain ? OS::get_singleton()->get_ticks_usec() : 0;
+
 			if (p_task->native_group_func) {
-				p_task->native_group_func(p_task->native_func_userdata, work_index);
+				for (uint32_t i = from; i < to; i++) {
+					p_task->native_group_func(p_task->native_func_userdata, i);
+				}
 			} else if (p_task->template_userdata) {
-				p_task->template_userdata->callback_indexed(work_index);
+				p_task->template_userdata->callback_range(from, to);
 			} else {
-				p_task->callable.call(work_index);
+				for (uint32_t i = from; i < to; i++) {
+					p_task->callable.call(i);
+				}
+			}
+
+			if (group->auto_grain) {
+				_adapt_group_grain(group, to - from, OS::get_singleton()->get_ticks_usec() - chunk_begin_usec);
 			}
 
 			// This is the only way to ensure posting is done when all tasks are really complete.
-			uint32_t completed_amount = p_task->group->completed_index.increment();
+			uint32_t completed_amount = group->completed_index.add(to - from);
 
-			if (completed_amount == p_task->group->max) {
+			if (completed_amount == group->max) {
 				do_post = true;
 			}
 		}
@@ -118,8 +134,11 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		}
 
 		if (do_post) {
-			p_task->group->done_semaphore.post();
+			task_mutex.lock();
 			p_task->group->completed.set_to(true);
+			_release_dependents(p_task->group->dependents, released_to_process_inline);
+			task_mutex.unlock();
+			p_task->group->done_semaphore.post();
 		}
 		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = p_task->group->finished.increment();
@@ -158,6 +177,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 				threads[i].signaled = true;
 			}
 		}
+		_release_dependents(p_task->dependents, released_to_process_inline);
 	}
 
 #ifdef THREADS_ENABLED
@@ -178,14 +198,21 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 
 	set_current_thread_safe_for_nodes(safe_for_nodes_backup);
 	MessageQueue::set_thread_singleton_override(call_queue_backup);
+#else
+	task_mutex.unlock();
 #endif
+
+	for (Task *task : released_to_process_inline) {
+		_process_task(task);
+	}
 }
 
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
 	while (true) {
 		Task *task_to_process = nullptr;
-		{
+		// Tasks this thread posted itself can be taken without locking.
+		if (!thread_data->work_queue.pop(task_to_process)) {
 			MutexLock lock(singleton->task_mutex);
 			if (singleton->exit_threads) {
 				return;
@@ -196,8 +223,11 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 				task_to_process = singleton->task_queue.first()->self();
 				singleton->task_queue.remove(singleton->task_queue.first());
 			} else {
-				thread_data->cond_var.wait(lock);
-				DEV_ASSERT(singleton->exit_threads || thread_data->signaled);
+				task_to_process = singleton->_steal_task(thread_data);
+				if (!task_to_process && !singleton->_has_stealable_tasks()) {
+					thread_data->cond_var.wait(lock);
+					DEV_ASSERT(singleton->exit_threads || thread_data->signaled);
+				}
 			}
 		}
 
@@ -220,6 +250,12 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 		return;
 	}
 
+	_post_tasks(p_tasks, p_count, p_high_priority);
+
+	task_mutex.unlock();
+}
+
+void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority) {
 	uint32_t to_process = 0;
 	uint32_t to_promote = 0;
 
@@ -228,7 +264,12 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
 		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
-			task_queue.add_last(&p_tasks[i]->task_elem);
+			if (caller_pool_thread) {
+				// Keep it close to the thread posting it; idle threads will steal it if needed.
+				caller_pool_thread->work_queue.push(p_tasks[i]);
+			} else {
+				task_queue.add_last(&p_tasks[i]->task_elem);
+			}
 			if (!p_high_priority) {
 				low_priority_threads_used++;
 			}
@@ -241,8 +282,53 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 	}
 
 	_notify_threads(caller_pool_thread, to_process, to_promote);
+}
 
-	task_mutex.unlock();
+uint32_t WorkerThreadPool::_link_dependencies(Task **p_tasks, uint32_t p_count, const TaskID *p_dependencies, uint32_t p_dependency_count) {
+	uint32_t pending = 0;
+	for (uint32_t i = 0; i < p_dependency_count; i++) {
+		LocalVector<Task *> *dependents = nullptr;
+		if (Task **taskp = tasks.getptr(p_dependencies[i])) {
+			if (!(*taskp)->completed) {
+				dependents = &(*taskp)->dependents;
+			}
+		} else if (Group **groupp = groups.getptr(p_dependencies[i])) {
+			if (!(*groupp)->completed.is_set()) {
+				dependents = &(*groupp)->dependents;
+			}
+		} else {
+			// Not tracked anymore means it was completed and awaited already.
+			ERR_CONTINUE_MSG(p_dependencies[i] <= 0 || p_dependencies[i] >= (TaskID)last_task, vformat("Invalid Task ID or Group ID %d.", p_dependencies[i]));
+		}
+
+		if (dependents) {
+			for (uint32_t j = 0; j < p_count; j++) {
+				dependents->push_back(p_tasks[j]);
+			}
+			pending++;
+		}
+	}
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		p_tasks[i]->pending_dependencies = pending;
+	}
+	return pending;
+}
+
+void WorkerThreadPool::_release_dependents(LocalVector<Task *> &p_dependents, LocalVector<Task *> &r_to_process_inline) {
+	for (Task *dependent : p_dependents) {
+		DEV_ASSERT(dependent->pending_dependencies > 0);
+		dependent->pending_dependencies--;
+		if (dependent->pending_dependencies == 0) {
+			if (threads.size() == 0) {
+				// Same fallback as in _post_tasks_and_unlock(), but the caller must do it once unlocked.
+				r_to_process_inline.push_back(dependent);
+			} else {
+				_post_tasks(&dependent, 1, !dependent->low_priority);
+			}
+		}
+	}
+	p_dependents.clear();
 }
 
 void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count) {
@@ -321,11 +407,36 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 	}
 }
 
+WorkerThreadPool::Task *WorkerThreadPool::_steal_task(const ThreadData *p_thief) {
+	uint32_t thread_count = threads.size();
+	uint32_t start = p_thief ? p_thief->index + 1 : 0;
+	for (uint32_t i = 0; i < thread_count; i++) {
+		ThreadData &victim = threads[(start + i) % thread_count];
+		if (&victim == p_thief) {
+			continue;
+		}
+		Task *task = nullptr;
+		if (victim.work_queue.steal(task)) {
+			return task;
+		}
+	}
+	return nullptr;
+}
+
+bool WorkerThreadPool::_has_stealable_tasks() const {
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		if (!threads[i].work_queue.is_empty()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const TaskID *p_dependencies, uint32_t p_dependency_count) {
 	task_mutex.lock();
 	// Get a free task
 	Task *task = task_allocator.alloc();
@@ -336,8 +447,15 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	task->native_func_userdata = p_userdata;
 	task->description = p_description;
 	task->template_userdata = p_template_userdata;
+	task->low_priority = !p_high_priority;
 	tasks.insert(id, task);
 
+	if (p_dependency_count && _link_dependencies(&task, 1, p_dependencies, p_dependency_count)) {
+		// Will be posted once the last dependency completes.
+		task_mutex.unlock();
+		return id;
+	}
+
 	_post_tasks_and_unlock(&task, 1, p_high_priority);
 
 	return id;
@@ -347,6 +465,14 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_task(const Callable &p_action, bo
 	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description);
 }
 
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task_with_dependencies(void (*p_func)(void *), void *p_userdata, const TaskID *p_dependencies, uint32_t p_dependency_count, bool p_high_priority, const String &p_description) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, p_dependencies, p_dependency_count);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::add_task_with_dependencies(const Callable &p_action, const Vector<TaskID> &p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, p_dependencies.ptr(), p_dependencies.size());
+}
+
 bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
 	task_mutex.lock();
 	const Task *const *taskp = tasks.getptr(p_task_id);
@@ -472,7 +598,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (!exit_threads && was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = (task_queue.first() || _has_stealable_tasks()) ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -491,12 +617,17 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 					}
 				}
 
-				if (singleton->task_queue.first()) {
-					task_to_process = task_queue.first()->self();
-					task_queue.remove(task_queue.first());
+				// Own tasks first, since the awaited one is likely among them.
+				if (!p_caller_pool_thread->work_queue.pop(task_to_process)) {
+					if (task_queue.first()) {
+						task_to_process = task_queue.first()->self();
+						task_queue.remove(task_queue.first());
+					} else {
+						task_to_process = _steal_task(p_caller_pool_thread);
+					}
 				}
 
-				if (!task_to_process) {
+				if (!task_to_process && !_has_stealable_tasks()) {
 					p_caller_pool_thread->awaited_task = p_task;
 
 					_unlock_unlockable_mutexes();
@@ -550,8 +681,22 @@ void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
 	task_mutex.unlock();
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+void WorkerThreadPool::_adapt_group_grain(Group *p_group, uint32_t p_processed, uint64_t p_usec) {
+	uint32_t grain = p_group->grain.get();
+	if (p_processed < grain) {
+		return; // Tail of the range, not representative.
+	}
+	// Racy on purpose; concurrent adjustments all go in the direction measured.
+	if (p_usec < GROUP_CHUNK_TARGET_USEC / 2 && grain < p_group->max_grain) {
+		p_group->grain.set(MIN(grain * 2, p_group->max_grain));
+	} else if (p_usec > GROUP_CHUNK_TARGET_USEC * 2 && grain > 1) {
+		p_group->grain.set(grain / 2);
+	}
+}
+
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const TaskID *p_dependencies, uint32_t p_dependency_count, int p_grain) {
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
+	ERR_FAIL_COND_V(p_grain < 0, INVALID_TASK_ID);
 	if (p_tasks < 0) {
 		p_tasks = MAX(1u, threads.size());
 	}
@@ -561,6 +706,20 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 	GroupID id = last_task++;
 	group->max = p_elements;
 	group->self = id;
+	if (p_grain == 0) {
+		// Leave every task a few chunks to balance with, and start small so expensive elements
+		// don't end up bunched together before the first measurements come in.
+		int task_count = MAX(1, p_tasks);
+		group->auto_grain = true;
+		group->max_grain = MAX(1, p_elements / (task_count * 4));
+		group->grain.set(CLAMP(p_elements / (task_count * 64), 1, (int)group->max_grain));
+	} else {
+		// Every task claims one chunk past the end before it stops, so the claim index can
+		// overshoot by a chunk per task. Keep that from wrapping around.
+		uint32_t grain_limit = ((uint32_t)UINT32_MAX - (uint32_t)p_elements) / (uint32_t)(MAX(1, p_tasks) + 1);
+		group->max_grain = CLAMP((uint32_t)p_grain, 1u, MAX(1u, MIN((uint32_t)p_elements, grain_limit)));
+		group->grain.set(group->max_grain);
+	}
 
 	Task **tasks_posted = nullptr;
 	if (p_elements == 0) {
@@ -584,6 +743,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 			task->group = group;
 			task->callable = p_callable;
 			task->template_userdata = p_template_userdata;
+			task->low_priority = !p_high_priority;
 			tasks_posted[i] = task;
 			// No task ID is used.
 		}
@@ -591,6 +751,12 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 
 	groups[id] = group;
 
+	if (p_tasks && p_dependency_count && _link_dependencies(tasks_posted, p_tasks, p_dependencies, p_dependency_count)) {
+		// Will be posted once the last dependency completes.
+		task_mutex.unlock();
+		return id;
+	}
+
 	_post_tasks_and_unlock(tasks_posted, p_tasks, p_high_priority);
 
 	return id;
@@ -604,6 +770,21 @@ WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_act
 	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description);
 }
 
+WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task_with_dependencies(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, const TaskID *p_dependencies, uint32_t p_dependency_count, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies, p_dependency_count);
+}
+
+WorkerThreadPool::GroupID WorkerThreadPool::add_group_task_with_dependencies(const Callable &p_action, int p_elements, const Vector<TaskID> &p_dependencies, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies.ptr(), p_dependencies.size());
+}
+
+WorkerThreadPool::GroupID WorkerThreadPool::add_native_range_group_task(void (*p_func)(void *, uint32_t, uint32_t), void *p_userdata, int p_elements, int p_grain, int p_tasks, bool p_high_priority, const String &p_description) {
+	NativeRangeGroupUserData *ud = memnew(NativeRangeGroupUserData);
+	ud->func = p_func;
+	ud->userdata = p_userdata;
+	return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, p_high_priority, p_description, nullptr, 0, p_grain);
+}
+
 uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) const {
 	task_mutex.lock();
 	const Group *const *groupp = groups.getptr(p_group);
@@ -747,9 +928,14 @@ void WorkerThreadPool::finish() {
 		for (KeyValue<TaskID, Task *> &E : tasks) {
 			task_allocator.free(E.value);
 		}
+		tasks.clear();
 	}
 
 	threads.clear();
+	thread_ids.clear();
+	notify_index = 0;
+	low_priority_threads_used = 0;
+	exit_threads = false; // So init() can start the pool again.
 }
 
 void WorkerThreadPool::_bind_methods() {
@@ -757,7 +943,10 @@ void WorkerThreadPool::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_task_completed", "task_id"), &WorkerThreadPool::is_task_completed);
 	ClassDB::bind_method(D_METHOD("wait_for_task_completion", "task_id"), &WorkerThreadPool::wait_for_task_completion);
 
+	ClassDB::bind_method(D_METHOD("add_task_with_dependencies", "action", "dependencies", "high_priority", "description"), &WorkerThreadPool::add_task_with_dependencies, DEFVAL(false), DEFVAL(String()));
+
 	ClassDB::bind_method(D_METHOD("add_group_task", "action", "elements", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("add_group_task_with_dependencies", "action", "elements", "dependencies", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task_with_dependencies, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("is_group_task_completed", "group_id"), &WorkerThreadPool::is_group_task_completed);
 	ClassDB::bind_method(D_METHOD("get_group_processed_element_count", "group_id"), &WorkerThreadPool::get_group_processed_element_count);
 	ClassDB::bind_method(D_METHOD("wait_for_group_task_completion", "group_id"), &WorkerThreadPool::wait_for_group_task_completion);
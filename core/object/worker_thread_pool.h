@@ -40,6 +40,7 @@
 #include "core/templates/paged_allocator.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_deque.h"
 
 class WorkerThreadPool : public Object {
 	GDCLASS(WorkerThreadPool, Object)
@@ -57,18 +58,31 @@ private:
 	struct BaseTemplateUserdata {
 		virtual void callback() {}
 		virtual void callback_indexed(uint32_t p_index) {}
+		virtual void callback_range(uint32_t p_from, uint32_t p_to) {
+			for (uint32_t i = p_from; i < p_to; i++) {
+				callback_indexed(i);
+			}
+		}
 		virtual ~BaseTemplateUserdata() {}
 	};
 
+	// Range group tasks try to keep each claimed chunk of elements around this long:
+	// long enough to amortize claiming it, short enough to still balance the load.
+	static const uint32_t GROUP_CHUNK_TARGET_USEC = 50;
+
 	struct Group {
 		GroupID self = -1;
 		SafeNumeric<uint32_t> index;
 		SafeNumeric<uint32_t> completed_index;
 		uint32_t max = 0;
+		SafeNumeric<uint32_t> grain{ 1 }; // Elements claimed at once.
+		uint32_t max_grain = 1;
+		bool auto_grain = false; // Adapt grain to the measured cost of chunks.
 		Semaphore done_semaphore;
 		SafeFlag completed;
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
+		LocalVector<Task *> dependents; // Posted when the group completes.
 	};
 
 	struct Task {
@@ -88,6 +102,8 @@ private:
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
 		int pool_thread_index = -1;
+		uint32_t pending_dependencies = 0; // Not posted until this reaches zero.
+		LocalVector<Task *> dependents; // Posted when this task completes.
 
 		void free_template_userdata();
 		Task() :
@@ -118,6 +134,9 @@ private:
 		Task *current_task = nullptr;
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
+		// Tasks posted from this thread. Popped without locking by this thread and stolen by idle ones.
+		// Pushes still happen with task_mutex held, so checking for work before sleeping can't miss any.
+		WorkStealingDeque<Task *> work_queue;
 
 		ThreadData() :
 				ready_for_scripting(false),
@@ -154,11 +173,17 @@ private:
 
 	void _process_task(Task *task);
 
+	void _post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority);
 	void _post_tasks_and_unlock(Task **p_tasks, uint32_t p_count, bool p_high_priority);
+	uint32_t _link_dependencies(Task **p_tasks, uint32_t p_count, const TaskID *p_dependencies, uint32_t p_dependency_count);
+	void _release_dependents(LocalVector<Task *> &p_dependents, LocalVector<Task *> &r_to_process_inline);
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
 
 	bool _try_promote_low_priority_task();
 
+	Task *_steal_task(const ThreadData *p_thief);
+	bool _has_stealable_tasks() const;
+
 	static WorkerThreadPool *singleton;
 
 #ifdef THREADS_ENABLED
@@ -166,8 +191,9 @@ private:
 	static thread_local uintptr_t unlockable_mutexes[MAX_UNLOCKABLE_MUTEXES];
 #endif
 
-	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description);
-	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
+	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const TaskID *p_dependencies = nullptr, uint32_t p_dependency_count = 0);
+	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const TaskID *p_dependencies = nullptr, uint32_t p_dependency_count = 0, int p_grain = 1);
+	void _adapt_group_grain(Group *p_group, uint32_t p_processed, uint64_t p_usec);
 
 	template <typename C, typename M, typename U>
 	struct TaskUserData : public BaseTemplateUserdata {
@@ -187,6 +213,30 @@ private:
 		virtual void callback_indexed(uint32_t p_index) override {
 			(instance->*method)(p_index, userdata);
 		}
+		virtual void callback_range(uint32_t p_from, uint32_t p_to) override {
+			for (uint32_t i = p_from; i < p_to; i++) {
+				(instance->*method)(i, userdata);
+			}
+		}
+	};
+
+	template <typename C, typename M, typename U>
+	struct RangeGroupUserData : public BaseTemplateUserdata {
+		C *instance;
+		M method;
+		U userdata;
+		uint32_t offset = 0;
+		virtual void callback_range(uint32_t p_from, uint32_t p_to) override {
+			(instance->*method)(offset + p_from, offset + p_to, userdata);
+		}
+	};
+
+	struct NativeRangeGroupUserData : public BaseTemplateUserdata {
+		void (*func)(void *, uint32_t, uint32_t) = nullptr;
+		void *userdata = nullptr;
+		virtual void callback_range(uint32_t p_from, uint32_t p_to) override {
+			func(userdata, p_from, p_to);
+		}
 	};
 
 	void _wait_collaboratively(ThreadData *p_caller_pool_thread, Task *p_task);
@@ -214,6 +264,11 @@ public:
 	TaskID add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String());
 	TaskID add_task(const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
 
+	// Dependencies can be task or group IDs. The task is only posted once all of them have completed.
+	// A task with a single dependency works as a continuation of it.
+	TaskID add_native_task_with_dependencies(void (*p_func)(void *), void *p_userdata, const TaskID *p_dependencies, uint32_t p_dependency_count, bool p_high_priority = false, const String &p_description = String());
+	TaskID add_task_with_dependencies(const Callable &p_action, const Vector<TaskID> &p_dependencies, bool p_high_priority = false, const String &p_description = String());
+
 	bool is_task_completed(TaskID p_task_id) const;
 	Error wait_for_task_completion(TaskID p_task_id);
 
@@ -231,6 +286,44 @@ public:
 	}
 	GroupID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	GroupID add_group_task(const Callable &p_action, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+	GroupID add_native_group_task_with_dependencies(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, const TaskID *p_dependencies, uint32_t p_dependency_count, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+	GroupID add_group_task_with_dependencies(const Callable &p_action, int p_elements, const Vector<TaskID> &p_dependencies, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+
+	// Range group tasks hand out contiguous chunks of elements, calling the function once per chunk
+	// with the [from, to) range. A grain of 0 sizes chunks automatically from the measured per-element cost.
+	template <typename C, typename M, typename U>
+	GroupID add_template_range_group_task(C *p_instance, M p_method, U p_userdata, int p_elements, int p_grain = 0, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String()) {
+		typedef RangeGroupUserData<C, M, U> GroupUD;
+		GroupUD *ud = memnew(GroupUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, p_high_priority, p_description, nullptr, 0, p_grain);
+	}
+	GroupID add_native_range_group_task(void (*p_func)(void *, uint32_t, uint32_t), void *p_userdata, int p_elements, int p_grain = 0, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+
+	// Runs p_method(from, to, p_userdata) over chunks of [p_begin, p_end) and waits for all of them.
+	// Small ranges are run directly on the calling thread.
+	template <typename C, typename M, typename U>
+	void parallel_for(C *p_instance, M p_method, U p_userdata, uint32_t p_begin, uint32_t p_end, int p_grain = 0, const String &p_description = String()) {
+		if (p_end <= p_begin) {
+			return;
+		}
+		uint32_t count = p_end - p_begin;
+		if (threads.size() == 0 || count == 1 || (p_grain > 0 && count <= (uint32_t)p_grain)) {
+			(p_instance->*p_method)(p_begin, p_end, p_userdata);
+			return;
+		}
+		typedef RangeGroupUserData<C, M, U> GroupUD;
+		GroupUD *ud = memnew(GroupUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		ud->offset = p_begin;
+		GroupID group = _add_group_task(Callable(), nullptr, nullptr, ud, count, -1, true, p_description, nullptr, 0, p_grain);
+		wait_for_group_task_completion(group);
+	}
+
 	uint32_t get_group_processed_element_count(GroupID p_group) const;
 	bool is_group_task_completed(GroupID p_group) const;
 	void wait_for_group_task_completion(GroupID p_group);
@@ -0,0 +1,146 @@
+/**************************************************************************/
+/*  frame_allocator.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_allocator.h"
+
+#include "core/string/ustring.h"
+
+#include <string.h>
+
+thread_local FrameAllocator::Arena FrameAllocator::arena;
+
+void FrameAllocator::Arena::rewind() {
+	if (chunk_count > 1) {
+		// The frame did not fit in one chunk, replace them with one large enough for all of it.
+		size_t needed = peak;
+		while (chunk) {
+			Chunk *prev = chunk->prev;
+			memfree(chunk);
+			chunk = prev;
+		}
+		chunk_count = 0;
+		add_chunk(needed);
+	} else if (chunk) {
+		pos = (uint8_t *)chunk + CHUNK_HEADER_SIZE;
+	}
+	last = nullptr;
+	used = 0;
+	peak = 0;
+}
+
+void FrameAllocator::Arena::add_chunk(size_t p_min_size) {
+	size_t size = MAX(DEFAULT_CHUNK_SIZE, CHUNK_HEADER_SIZE + p_min_size);
+	Chunk *new_chunk = (Chunk *)memalloc(size);
+	CRASH_COND_MSG(!new_chunk, "Out of memory");
+	new_chunk->prev = chunk;
+	new_chunk->size = size;
+	chunk = new_chunk;
+	chunk_count++;
+
+	pos = (uint8_t *)new_chunk + CHUNK_HEADER_SIZE;
+	end = (uint8_t *)new_chunk + size;
+}
+
+FrameAllocator::Arena::~Arena() {
+	while (chunk) {
+		Chunk *prev = chunk->prev;
+		memfree(chunk);
+		chunk = prev;
+	}
+}
+
+void *FrameAllocator::alloc(size_t p_bytes) {
+	size_t size = (MAX(p_bytes, (size_t)1) + ALIGN - 1) & ~(ALIGN - 1);
+	if (unlikely(!arena.chunk || size > (size_t)(arena.end - arena.pos))) {
+		arena.add_chunk(size);
+	}
+
+	uint8_t *mem = arena.pos;
+	arena.pos += size;
+	arena.last = mem;
+	arena.live++;
+	arena.used += size;
+	arena.peak = MAX(arena.peak, arena.used);
+	return mem;
+}
+
+void *FrameAllocator::realloc(void *p_ptr, size_t p_old_bytes, size_t p_bytes) {
+	if (!p_ptr) {
+		return alloc(p_bytes);
+	}
+	if (p_bytes == 0) {
+		free(p_ptr);
+		return nullptr;
+	}
+
+	if (p_ptr == arena.last) {
+		// Grow or shrink the top allocation in place when it still fits.
+		size_t old_size = (size_t)(arena.pos - arena.last);
+		size_t size = (p_bytes + ALIGN - 1) & ~(ALIGN - 1);
+		if (size <= (size_t)(arena.end - arena.last)) {
+			arena.pos = arena.last + size;
+			arena.used = arena.used - old_size + size;
+			arena.peak = MAX(arena.peak, arena.used);
+			return p_ptr;
+		}
+	}
+
+	void *mem = alloc(p_bytes);
+	memcpy(mem, p_ptr, MIN(p_old_bytes, p_bytes));
+	free(p_ptr);
+	return mem;
+}
+
+void FrameAllocator::free(void *p_ptr) {
+	if (!p_ptr) {
+		return;
+	}
+	ERR_FAIL_COND_MSG(arena.live == 0, "Freeing scratch memory that was not allocated on this thread.");
+
+	arena.live--;
+	if (arena.live == 0) {
+		arena.rewind();
+	} else if (p_ptr == arena.last) {
+		arena.used -= (size_t)(arena.pos - arena.last);
+		arena.pos = arena.last;
+		arena.last = nullptr;
+	}
+}
+
+uint32_t FrameAllocator::get_live_allocation_count() {
+	return arena.live;
+}
+
+void FrameAllocator::end_frame() {
+	if (arena.live == 0) {
+		return;
+	}
+	WARN_PRINT_ONCE(itos(arena.live) + " scratch allocation(s) outlived the frame, their memory can't be reclaimed until they are freed.");
+}
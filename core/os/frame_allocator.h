@@ -0,0 +1,91 @@
+/**************************************************************************/
+/*  frame_allocator.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FRAME_ALLOCATOR_H
+#define FRAME_ALLOCATOR_H
+
+#include "core/templates/local_vector.h"
+
+// Bump allocator for short-lived scratch buffers (per-frame cull results,
+// temporary lists built and dropped inside a single function, etc.).
+//
+// Every thread owns its own arena, so allocations never lock. Memory is
+// reclaimed in bulk: freeing the most recent allocation rewinds the arena,
+// and once every allocation made on a thread has been freed the whole arena
+// is rewound. An arena that needed several chunks is then compacted into a
+// single chunk that fits its peak usage, so the next frame fits in one.
+// Main::iteration() calls end_frame(), which warns about allocations that
+// outlived the frame and keep the main thread's arena from being rewound.
+//
+// Allocations must be freed on the thread that made them, and must not
+// outlive the frame.
+class FrameAllocator {
+	struct Chunk {
+		Chunk *prev = nullptr;
+		size_t size = 0;
+	};
+
+	struct Arena {
+		Chunk *chunk = nullptr;
+		uint8_t *pos = nullptr;
+		uint8_t *end = nullptr;
+		uint8_t *last = nullptr; // Most recent allocation, can be grown or rewound in place.
+		uint32_t live = 0;
+		uint32_t chunk_count = 0;
+		size_t used = 0; // Bytes carved since the arena was last rewound.
+		size_t peak = 0; // Highest value of used since then.
+
+		void rewind();
+		void add_chunk(size_t p_min_size);
+		~Arena();
+	};
+
+	static constexpr size_t ALIGN = alignof(max_align_t);
+	static constexpr size_t CHUNK_HEADER_SIZE = (sizeof(Chunk) + ALIGN - 1) & ~(ALIGN - 1);
+	static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+	static thread_local Arena arena;
+
+public:
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_ptr, size_t p_old_bytes, size_t p_bytes);
+	static void free(void *p_ptr);
+
+	// Number of allocations on the calling thread's arena that have not been freed yet.
+	static uint32_t get_live_allocation_count();
+
+	static void end_frame();
+};
+
+// LocalVector whose storage lives on the calling thread's FrameAllocator arena.
+template <typename T, typename U = uint32_t, bool force_trivial = false>
+using FrameLocalVector = LocalVector<T, U, force_trivial, false, FrameAllocator>;
+
+#endif // FRAME_ALLOCATOR_H
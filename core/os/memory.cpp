@@ -36,6 +36,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#ifdef MEMORY_ARENA_ENABLED
+#include "core/os/spin_lock.h"
+
+#include <string.h>
+#endif
+
 void *operator new(size_t p_size, const char *p_description) {
 	return Memory::alloc_static(p_size, false);
 }
@@ -61,22 +67,274 @@ void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_d
 #ifdef DEBUG_ENABLED
 SafeNumeric<uint64_t> Memory::mem_usage;
 SafeNumeric<uint64_t> Memory::max_usage;
+SafeNumeric<uint64_t> Memory::total_alloc_count;
 #endif
 
 SafeNumeric<uint64_t> Memory::alloc_count;
 
+#ifdef MEMORY_ARENA_ENABLED
+
+// Small blocks are served from per-thread free lists, one per size class, so the
+// common alloc/free pair never touches a lock. Thread caches are refilled from and
+// drained to a shared pool in batches; the pool carves new blocks out of slabs.
+// Slabs are never handed back to the system, freed blocks are recycled instead.
+// Blocks freed on another thread simply join that thread's cache.
+
+static constexpr uint32_t ARENA_GRANULE = 16;
+static constexpr uint32_t ARENA_CLASS_SIZES[] = { 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024 };
+static constexpr int ARENA_CLASS_COUNT = sizeof(ARENA_CLASS_SIZES) / sizeof(ARENA_CLASS_SIZES[0]);
+static constexpr uint32_t ARENA_MAX_BLOCK = ARENA_CLASS_SIZES[ARENA_CLASS_COUNT - 1];
+static constexpr uint32_t ARENA_SLAB_SIZE = 64 * 1024;
+static constexpr uint32_t ARENA_BATCH = 32; // Blocks moved between a thread cache and the pool at once.
+static constexpr uint32_t ARENA_MAX_CACHED = ARENA_BATCH * 4;
+static constexpr uint32_t ARENA_STATS_BATCH = 64;
+
+static_assert(Memory::DATA_OFFSET % ARENA_GRANULE == 0, "Arena blocks must keep the data alignment.");
+
+struct ArenaClassTable {
+	uint8_t index[ARENA_MAX_BLOCK / ARENA_GRANULE + 1];
+
+	constexpr ArenaClassTable() :
+			index() {
+		int size_class = 0;
+		for (uint32_t i = 0; i < sizeof(index); i++) {
+			while (i * ARENA_GRANULE > ARENA_CLASS_SIZES[size_class]) {
+				size_class++;
+			}
+			index[i] = size_class;
+		}
+	}
+};
+
+static constexpr ArenaClassTable arena_class_table;
+
+struct ArenaBlock {
+	ArenaBlock *next;
+};
+
+struct ArenaPool {
+	SpinLock lock;
+	ArenaBlock *free_list = nullptr;
+};
+
+// Both need to be usable before static initialization runs, so keep them trivial.
+static ArenaPool arena_pools[ARENA_CLASS_COUNT];
+static thread_local struct ArenaThreadCache {
+	enum State : uint8_t {
+		STATE_UNUSED,
+		STATE_ACTIVE,
+		STATE_RELEASED,
+	};
+
+	ArenaBlock *free_list[ARENA_CLASS_COUNT];
+	uint32_t count[ARENA_CLASS_COUNT];
+	uint32_t pending_allocs[ARENA_CLASS_COUNT];
+	State state;
+} arena_thread_cache;
+
+static SafeNumeric<uint64_t> arena_allocs[ARENA_CLASS_COUNT];
+static SafeNumeric<uint64_t> arena_system_allocs;
+static SafeNumeric<uint64_t> arena_reserved;
+
+static _FORCE_INLINE_ int _arena_get_size_class(size_t p_bytes) {
+	return arena_class_table.index[(p_bytes + ARENA_GRANULE - 1) / ARENA_GRANULE];
+}
+
+static void _arena_pool_push(int p_class, ArenaBlock *p_first, ArenaBlock *p_last) {
+	ArenaPool &pool = arena_pools[p_class];
+	pool.lock.lock();
+	p_last->next = pool.free_list;
+	pool.free_list = p_first;
+	pool.lock.unlock();
+}
+
+// Detaches up to p_count blocks from the head of the thread cache and returns them to the pool.
+static void _arena_flush(ArenaThreadCache &p_cache, int p_class, uint32_t p_count) {
+	ArenaBlock *first = p_cache.free_list[p_class];
+	if (!first) {
+		return;
+	}
+	ArenaBlock *last = first;
+	uint32_t moved = 1;
+	while (moved < p_count && last->next) {
+		last = last->next;
+		moved++;
+	}
+	p_cache.free_list[p_class] = last->next;
+	p_cache.count[p_class] -= moved;
+	_arena_pool_push(p_class, first, last);
+}
+
+static void _arena_refill(ArenaThreadCache &p_cache, int p_class) {
+	ArenaPool &pool = arena_pools[p_class];
+
+	pool.lock.lock();
+	ArenaBlock *first = pool.free_list;
+	if (first) {
+		ArenaBlock *last = first;
+		uint32_t taken = 1;
+		while (taken < ARENA_BATCH && last->next) {
+			last = last->next;
+			taken++;
+		}
+		pool.free_list = last->next;
+		pool.lock.unlock();
+
+		last->next = p_cache.free_list[p_class];
+		p_cache.free_list[p_class] = first;
+		p_cache.count[p_class] += taken;
+		return;
+	}
+	pool.lock.unlock();
+
+	uint8_t *slab = (uint8_t *)malloc(ARENA_SLAB_SIZE);
+	if (!slab) {
+		return;
+	}
+	arena_reserved.add(ARENA_SLAB_SIZE);
+
+	// Keep one batch for this thread and give the rest of the slab to the pool.
+	const uint32_t block_size = ARENA_CLASS_SIZES[p_class];
+	const uint32_t block_count = ARENA_SLAB_SIZE / block_size;
+	for (uint32_t i = 0; i < block_count; i++) {
+		ArenaBlock *block = (ArenaBlock *)(slab + i * block_size);
+		block->next = (i + 1 < block_count) ? (ArenaBlock *)(slab + (i + 1) * block_size) : nullptr;
+	}
+
+	const uint32_t kept = MIN(ARENA_BATCH, block_count);
+	ArenaBlock *last_kept = (ArenaBlock *)(slab + (kept - 1) * block_size);
+	ArenaBlock *rest = last_kept->next;
+	last_kept->next = p_cache.free_list[p_class];
+	p_cache.free_list[p_class] = (ArenaBlock *)slab;
+	p_cache.count[p_class] += kept;
+
+	if (rest) {
+		_arena_pool_push(p_class, rest, (ArenaBlock *)(slab + (block_count - 1) * block_size));
+	}
+}
+
+// Hands every cached block back to the pool when the thread exits.
+static thread_local struct ArenaThreadCacheReleaser {
+	bool registered = false;
+
+	~ArenaThreadCacheReleaser() {
+		ArenaThreadCache &cache = arena_thread_cache;
+		for (int i = 0; i < ARENA_CLASS_COUNT; i++) {
+			_arena_flush(cache, i, UINT32_MAX);
+			arena_allocs[i].add(cache.pending_allocs[i]);
+			cache.pending_allocs[i] = 0;
+		}
+		cache.state = ArenaThreadCache::STATE_RELEASED;
+	}
+} arena_thread_cache_releaser;
+
+static _FORCE_INLINE_ ArenaThreadCache *_arena_get_thread_cache() {
+	ArenaThreadCache &cache = arena_thread_cache;
+	if (likely(cache.state == ArenaThreadCache::STATE_ACTIVE)) {
+		return &cache;
+	}
+	if (cache.state == ArenaThreadCache::STATE_RELEASED) {
+		// Thread is being torn down, its cache is gone.
+		return nullptr;
+	}
+	// First use on this thread, touching the releaser registers its destructor.
+	arena_thread_cache_releaser.registered = true;
+	cache.state = ArenaThreadCache::STATE_ACTIVE;
+	return &cache;
+}
+
+static void *_arena_alloc(size_t p_bytes) {
+	if (p_bytes > ARENA_MAX_BLOCK) {
+		arena_system_allocs.increment();
+		return malloc(p_bytes);
+	}
+
+	int size_class = _arena_get_size_class(p_bytes);
+	ArenaThreadCache *cache = _arena_get_thread_cache();
+	if (unlikely(!cache)) {
+		// Still sized to the class, so it can join the pool once freed.
+		arena_system_allocs.increment();
+		return malloc(ARENA_CLASS_SIZES[size_class]);
+	}
+
+	ArenaBlock *block = cache->free_list[size_class];
+	if (unlikely(!block)) {
+		_arena_refill(*cache, size_class);
+		block = cache->free_list[size_class];
+		if (!block) {
+			return nullptr;
+		}
+	}
+	cache->free_list[size_class] = block->next;
+	cache->count[size_class]--;
+
+	if (unlikely(++cache->pending_allocs[size_class] == ARENA_STATS_BATCH)) {
+		arena_allocs[size_class].add(ARENA_STATS_BATCH);
+		cache->pending_allocs[size_class] = 0;
+	}
+	return block;
+}
+
+static void _arena_free(void *p_mem, size_t p_bytes) {
+	if (p_bytes > ARENA_MAX_BLOCK) {
+		free(p_mem);
+		return;
+	}
+
+	int size_class = _arena_get_size_class(p_bytes);
+	ArenaBlock *block = (ArenaBlock *)p_mem;
+	ArenaThreadCache *cache = _arena_get_thread_cache();
+	if (unlikely(!cache)) {
+		_arena_pool_push(size_class, block, block);
+		return;
+	}
+
+	block->next = cache->free_list[size_class];
+	cache->free_list[size_class] = block;
+	if (unlikely(++cache->count[size_class] > ARENA_MAX_CACHED)) {
+		_arena_flush(*cache, size_class, ARENA_MAX_CACHED / 2);
+	}
+}
+
+static void *_arena_realloc(void *p_mem, size_t p_old_bytes, size_t p_bytes) {
+	if (p_old_bytes > ARENA_MAX_BLOCK && p_bytes > ARENA_MAX_BLOCK) {
+		return realloc(p_mem, p_bytes);
+	}
+	if (p_old_bytes <= ARENA_MAX_BLOCK && p_bytes <= ARENA_MAX_BLOCK && _arena_get_size_class(p_old_bytes) == _arena_get_size_class(p_bytes)) {
+		return p_mem;
+	}
+
+	void *mem = _arena_alloc(p_bytes);
+	if (!mem) {
+		return nullptr;
+	}
+	memcpy(mem, p_mem, MIN(p_old_bytes, p_bytes));
+	_arena_free(p_mem, p_old_bytes);
+	return mem;
+}
+
+#endif // MEMORY_ARENA_ENABLED
+
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(MEMORY_ARENA_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
 #endif
 
+#ifdef MEMORY_ARENA_ENABLED
+	// The arena needs the size header to find the block's class when freeing.
+	void *mem = _arena_alloc(p_bytes + DATA_OFFSET);
+#else
 	void *mem = malloc(p_bytes + (prepad ? DATA_OFFSET : 0));
+#endif
 
 	ERR_FAIL_NULL_V(mem, nullptr);
 
 	alloc_count.increment();
+#ifdef DEBUG_ENABLED
+	total_alloc_count.increment();
+#endif
 
 	if (prepad) {
 		uint8_t *s8 = (uint8_t *)mem;
@@ -101,7 +359,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_memory;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(MEMORY_ARENA_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -110,6 +368,9 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 	if (prepad) {
 		mem -= DATA_OFFSET;
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
+#ifdef MEMORY_ARENA_ENABLED
+		uint64_t old_bytes = *s;
+#endif
 
 #ifdef DEBUG_ENABLED
 		if (p_bytes > *s) {
@@ -121,12 +382,20 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 #endif
 
 		if (p_bytes == 0) {
+#ifdef MEMORY_ARENA_ENABLED
+			_arena_free(mem, old_bytes + DATA_OFFSET);
+#else
 			free(mem);
+#endif
 			return nullptr;
 		} else {
 			*s = p_bytes;
 
+#ifdef MEMORY_ARENA_ENABLED
+			mem = (uint8_t *)_arena_realloc(mem, old_bytes + DATA_OFFSET, p_bytes + DATA_OFFSET);
+#else
 			mem = (uint8_t *)realloc(mem, p_bytes + DATA_OFFSET);
+#endif
 			ERR_FAIL_NULL_V(mem, nullptr);
 
 			s = (uint64_t *)(mem + SIZE_OFFSET);
@@ -149,7 +418,7 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_ptr;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(MEMORY_ARENA_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -160,12 +429,18 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 	if (prepad) {
 		mem -= DATA_OFFSET;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(MEMORY_ARENA_ENABLED)
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
+#endif
+#ifdef DEBUG_ENABLED
 		mem_usage.sub(*s);
 #endif
 
+#ifdef MEMORY_ARENA_ENABLED
+		_arena_free(mem, *s + DATA_OFFSET);
+#else
 		free(mem);
+#endif
 	} else {
 		free(mem);
 	}
@@ -191,6 +466,57 @@ uint64_t Memory::get_mem_max_usage() {
 #endif
 }
 
+uint64_t Memory::get_mem_alloc_count() {
+#ifdef DEBUG_ENABLED
+	return total_alloc_count.get();
+#else
+	return 0;
+#endif
+}
+
+int Memory::get_arena_size_class_count() {
+#ifdef MEMORY_ARENA_ENABLED
+	return ARENA_CLASS_COUNT;
+#else
+	return 0;
+#endif
+}
+
+uint64_t Memory::get_arena_size_class_bytes(int p_class) {
+#ifdef MEMORY_ARENA_ENABLED
+	ERR_FAIL_INDEX_V(p_class, ARENA_CLASS_COUNT, 0);
+	// Report the usable size, the header is not available to the caller.
+	return ARENA_CLASS_SIZES[p_class] - DATA_OFFSET;
+#else
+	return 0;
+#endif
+}
+
+uint64_t Memory::get_arena_allocation_count(int p_class) {
+#ifdef MEMORY_ARENA_ENABLED
+	ERR_FAIL_INDEX_V(p_class, ARENA_CLASS_COUNT, 0);
+	return arena_allocs[p_class].get();
+#else
+	return 0;
+#endif
+}
+
+uint64_t Memory::get_arena_system_allocation_count() {
+#ifdef MEMORY_ARENA_ENABLED
+	return arena_system_allocs.get();
+#else
+	return 0;
+#endif
+}
+
+uint64_t Memory::get_arena_reserved() {
+#ifdef MEMORY_ARENA_ENABLED
+	return arena_reserved.get();
+#else
+	return 0;
+#endif
+}
+
 _GlobalNil::_GlobalNil() {
 	left = this;
 	right = this;
@@ -42,6 +42,7 @@ class Memory {
 #ifdef DEBUG_ENABLED
 	static SafeNumeric<uint64_t> mem_usage;
 	static SafeNumeric<uint64_t> max_usage;
+	static SafeNumeric<uint64_t> total_alloc_count;
 #endif
 
 	static SafeNumeric<uint64_t> alloc_count;
@@ -65,11 +66,21 @@ public:
 	static uint64_t get_mem_available();
 	static uint64_t get_mem_usage();
 	static uint64_t get_mem_max_usage();
+	static uint64_t get_mem_alloc_count(); // Allocations made since startup, only counted in debug builds.
+
+	// Statistics for the thread-local size-class arenas (`memory_arena=yes` builds).
+	// Counters are cumulative and updated in batches, so they may lag slightly behind.
+	static int get_arena_size_class_count();
+	static uint64_t get_arena_size_class_bytes(int p_class);
+	static uint64_t get_arena_allocation_count(int p_class);
+	static uint64_t get_arena_system_allocation_count();
+	static uint64_t get_arena_reserved();
 };
 
 class DefaultAllocator {
 public:
 	_FORCE_INLINE_ static void *alloc(size_t p_memory) { return Memory::alloc_static(p_memory, false); }
+	_FORCE_INLINE_ static void *realloc(void *p_ptr, size_t p_old_bytes, size_t p_bytes) { return Memory::realloc_static(p_ptr, p_bytes, false); }
 	_FORCE_INLINE_ static void free(void *p_ptr) { Memory::free_static(p_ptr, false); }
 };
 
@@ -45,9 +45,12 @@
 #include "core/io/config_file.h"
 #include "core/io/dir_access.h"
 #include "core/io/dtls_server.h"
+#include "core/io/file_access_compressed.h"
 #include "core/io/http_client.h"
 #include "core/io/image_loader.h"
 #include "core/io/json.h"
+#include "core/io/json_reader.h"
+#include "core/io/json_writer.h"
 #include "core/io/marshalls.h"
 #include "core/io/missing_resource.h"
 #include "core/io/packed_data_container.h"
@@ -247,6 +250,8 @@ void register_core_types() {
 
 	GDREGISTER_CLASS(XMLParser);
 	GDREGISTER_CLASS(JSON);
+	GDREGISTER_CLASS(JSONReader);
+	GDREGISTER_CLASS(JSONWriter);
 
 	GDREGISTER_CLASS(ConfigFile);
 
@@ -309,6 +314,9 @@ void register_core_settings() {
 
 	GLOBAL_DEF("threading/worker_pool/max_threads", -1);
 	GLOBAL_DEF("threading/worker_pool/low_priority_thread_ratio", 0.3);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "threading/resource_loader/parallel_dependency_threshold", PROPERTY_HINT_RANGE, "0,64,1,or_greater"), 4);
+
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "memory/limits/resource_cache/retained_budget_mb", PROPERTY_HINT_RANGE, "0,4096,1,or_greater"), 0);
 }
 
 void register_core_singletons() {
@@ -381,6 +389,7 @@ void unregister_core_types() {
 
 	// Destroy singletons in reverse order to ensure dependencies are not broken.
 
+	FileAccessCompressed::finalize();
 	memdelete(worker_thread_pool);
 
 	memdelete(_engine_debugger);
@@ -31,6 +31,7 @@
 #include "node_path.h"
 
 #include "core/string/print_string.h"
+#include "core/templates/small_vector.h"
 
 void NodePath::_update_hash_cache() const {
 	uint32_t h = data->absolute ? 1 : 0;
@@ -395,13 +396,15 @@ NodePath::NodePath(const String &p_path) {
 		return;
 	}
 
-	String path = p_path;
-	Vector<StringName> subpath;
+	const String &path = p_path;
+	SmallVector<StringName, 4> subpath;
 
 	bool absolute = (path[0] == '/');
 	bool last_is_slash = true;
 	int slices = 0;
 	int subpath_pos = path.find(":");
+	// Parse the node names in place instead of copying out the part before the subpath.
+	int path_len = subpath_pos != -1 ? subpath_pos : path.length();
 
 	if (subpath_pos != -1) {
 		int from = subpath_pos + 1;
@@ -421,11 +424,9 @@ NodePath::NodePath(const String &p_path) {
 				from = i + 1;
 			}
 		}
-
-		path = path.substr(0, subpath_pos);
 	}
 
-	for (int i = (int)absolute; i < path.length(); i++) {
+	for (int i = (int)absolute; i < path_len; i++) {
 		if (path[i] == '/') {
 			last_is_slash = true;
 		} else {
@@ -455,8 +456,8 @@ NodePath::NodePath(const String &p_path) {
 	int from = (int)absolute;
 	int slice = 0;
 
-	for (int i = (int)absolute; i < path.length() + 1; i++) {
-		if (path[i] == '/' || path[i] == 0) {
+	for (int i = (int)absolute; i < path_len + 1; i++) {
+		if (i == path_len || path[i] == '/') {
 			if (!last_is_slash) {
 				String name = path.substr(from, i - from);
 				ERR_FAIL_INDEX(slice, data->path.size());
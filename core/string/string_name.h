@@ -48,7 +48,12 @@ class StringName {
 	enum {
 		STRING_TABLE_BITS = 16,
 		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_MASK = STRING_TABLE_LEN - 1,
+		// Buckets are spread across independently locked shards, so threads
+		// interning unrelated names don't serialize on a single mutex.
+		STRING_TABLE_LOCK_BITS = 6,
+		STRING_TABLE_LOCK_LEN = 1 << STRING_TABLE_LOCK_BITS,
+		STRING_TABLE_LOCK_MASK = STRING_TABLE_LOCK_LEN - 1
 	};
 
 	struct _Data {
@@ -67,7 +72,17 @@ class StringName {
 		_Data() {}
 	};
 
+	// Padded to a cache line so neighboring shards don't false-share.
+	struct alignas(64) TableLock {
+		BinaryMutex mutex;
+	};
+
 	static _Data *_table[STRING_TABLE_LEN];
+	static TableLock _table_locks[STRING_TABLE_LOCK_LEN];
+
+	_FORCE_INLINE_ static BinaryMutex &_get_table_lock(uint32_t p_idx) {
+		return _table_locks[p_idx & STRING_TABLE_LOCK_MASK].mutex;
+	}
 
 	_Data *_data = nullptr;
 
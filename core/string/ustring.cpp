@@ -2176,13 +2176,9 @@ Error String::parse_utf8(const char *p_utf8, int p_len, bool p_skip_cr) {
 	}
 }
 
-CharString String::utf8() const {
+int String::utf8_length() const {
 	int l = length();
-	if (!l) {
-		return CharString();
-	}
-
-	const char32_t *d = &operator[](0);
+	const char32_t *d = get_data();
 	int fl = 0;
 	for (int i = 0; i < l; i++) {
 		uint32_t c = d[i];
@@ -2205,6 +2201,17 @@ CharString String::utf8() const {
 			print_unicode_error(vformat("Invalid unicode codepoint (%x), cannot represent as UTF-8", c), true);
 		}
 	}
+	return fl;
+}
+
+CharString String::utf8() const {
+	int l = length();
+	if (!l) {
+		return CharString();
+	}
+
+	const char32_t *d = &operator[](0);
+	int fl = utf8_length();
 
 	CharString utf8s;
 	if (fl == 0) {
@@ -0,0 +1,538 @@
+/**************************************************************************/
+/*  flat_hash_map.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FLAT_HASH_MAP_H
+#define FLAT_HASH_MAP_H
+
+#include "core/os/memory.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/pair.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FLAT_HASH_MAP_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define FLAT_HASH_MAP_NEON
+#endif
+
+/**
+ * A flat HashMap implementation in the style of Swiss tables.
+ * Keys and values are stored inline in a single slot array, next to an array
+ * of control bytes holding 7 bits of each key's hash. Lookups scan the control
+ * bytes of a whole group of slots at once (with SSE2 or NEON when available)
+ * and only compare keys whose hash bits match, so most lookups touch a single
+ * cache line of control bytes and a single slot. Inserting doesn't allocate
+ * unless the table has to grow.
+ *
+ * Unlike HashMap, iteration order is unspecified and any insertion may move
+ * existing elements, invalidating iterators and pointers returned by getptr().
+ * Prefer HashMap when either matters.
+ *
+ * The assignment operator copy the pairs from one map to the other.
+ */
+
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class FlatHashMap {
+public:
+	static constexpr uint32_t GROUP_SIZE = 16;
+	static constexpr uint32_t MIN_CAPACITY = GROUP_SIZE;
+
+private:
+	// Full slots store the low 7 bits of the hash, so the sign bit marks free ones.
+	static constexpr int8_t CTRL_EMPTY = -128;
+	static constexpr int8_t CTRL_DELETED = -2;
+
+	using Element = KeyValue<TKey, TValue>;
+
+	// Scans the control bytes of one group, producing a mask with one bit set per matching slot.
+	struct Group {
+#if defined(FLAT_HASH_MAP_SSE2)
+		static constexpr uint32_t SHIFT = 0;
+		__m128i ctrl;
+
+		_FORCE_INLINE_ explicit Group(const int8_t *p_ctrl) {
+			ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_ctrl));
+		}
+		_FORCE_INLINE_ uint64_t match(int8_t p_h2) const {
+			return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(p_h2)));
+		}
+		_FORCE_INLINE_ uint64_t match_empty() const {
+			return match(CTRL_EMPTY);
+		}
+		_FORCE_INLINE_ uint64_t match_free() const {
+			return (uint32_t)_mm_movemask_epi8(ctrl);
+		}
+#elif defined(FLAT_HASH_MAP_NEON)
+		// NEON has no movemask, narrow each byte to a nibble and keep one bit of it.
+		static constexpr uint32_t SHIFT = 2;
+		static constexpr uint64_t LANE_BITS = 0x8888888888888888ULL;
+		int8x16_t ctrl;
+
+		_FORCE_INLINE_ static uint64_t _to_mask(uint8x16_t p_cmp) {
+			uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(p_cmp), 4);
+			return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & LANE_BITS;
+		}
+
+		_FORCE_INLINE_ explicit Group(const int8_t *p_ctrl) {
+			ctrl = vld1q_s8(p_ctrl);
+		}
+		_FORCE_INLINE_ uint64_t match(int8_t p_h2) const {
+			return _to_mask(vceqq_s8(ctrl, vdupq_n_s8(p_h2)));
+		}
+		_FORCE_INLINE_ uint64_t match_empty() const {
+			return match(CTRL_EMPTY);
+		}
+		_FORCE_INLINE_ uint64_t match_free() const {
+			return _to_mask(vcltq_s8(ctrl, vdupq_n_s8(0)));
+		}
+#else
+		static constexpr uint32_t SHIFT = 0;
+		const int8_t *ctrl;
+
+		_FORCE_INLINE_ explicit Group(const int8_t *p_ctrl) {
+			ctrl = p_ctrl;
+		}
+		_FORCE_INLINE_ uint64_t match(int8_t p_h2) const {
+			uint64_t mask = 0;
+			for (uint32_t i = 0; i < GROUP_SIZE; i++) {
+				mask |= uint64_t(ctrl[i] == p_h2) << i;
+			}
+			return mask;
+		}
+		_FORCE_INLINE_ uint64_t match_empty() const {
+			return match(CTRL_EMPTY);
+		}
+		_FORCE_INLINE_ uint64_t match_free() const {
+			uint64_t mask = 0;
+			for (uint32_t i = 0; i < GROUP_SIZE; i++) {
+				mask |= uint64_t(ctrl[i] < 0) << i;
+			}
+			return mask;
+		}
+#endif
+
+		// Pops the lowest matching slot from the mask.
+		_FORCE_INLINE_ static uint32_t next(uint64_t &r_mask) {
+#if defined(__GNUC__) || defined(__clang__)
+			uint32_t slot = (uint32_t)__builtin_ctzll(r_mask) >> SHIFT;
+#else
+			uint32_t slot = 0;
+			while (!(r_mask & (uint64_t(1) << (slot << SHIFT)))) {
+				slot++;
+			}
+#endif
+			r_mask &= r_mask - 1;
+			return slot;
+		}
+	};
+
+	int8_t *ctrl = nullptr;
+	KeyValue<TKey, TValue> *slots = nullptr;
+	uint32_t capacity = 0;
+	uint32_t num_elements = 0;
+	uint32_t growth_left = 0; // Empty slots that can still be filled before rehashing.
+
+	static _FORCE_INLINE_ uint32_t _capacity_to_growth(uint32_t p_capacity) {
+		return p_capacity - p_capacity / 8; // Max load factor of 7/8.
+	}
+
+	static _FORCE_INLINE_ int8_t _h2(uint32_t p_hash) {
+		return int8_t(p_hash & 0x7F);
+	}
+
+	static _FORCE_INLINE_ uint32_t _h1(uint32_t p_hash) {
+		return p_hash >> 7;
+	}
+
+	bool _lookup_pos(const TKey &p_key, uint32_t &r_pos) const {
+		if (num_elements == 0) {
+			return false;
+		}
+
+		const uint32_t hash = Hasher::hash(p_key);
+		const int8_t h2 = _h2(hash);
+		const uint32_t group_mask = capacity / GROUP_SIZE - 1;
+		uint32_t group = _h1(hash) & group_mask;
+
+		// Triangular probing over groups visits every group once for power of two counts.
+		for (uint32_t step = 1;; step++) {
+			const Group g(ctrl + group * GROUP_SIZE);
+			uint64_t mask = g.match(h2);
+			while (mask) {
+				uint32_t pos = group * GROUP_SIZE + Group::next(mask);
+				if (likely(Comparator::compare(slots[pos].key, p_key))) {
+					r_pos = pos;
+					return true;
+				}
+			}
+			if (likely(g.match_empty())) {
+				return false;
+			}
+			group = (group + step) & group_mask;
+		}
+	}
+
+	uint32_t _find_free_pos(uint32_t p_hash) const {
+		const uint32_t group_mask = capacity / GROUP_SIZE - 1;
+		uint32_t group = _h1(p_hash) & group_mask;
+
+		for (uint32_t step = 1;; step++) {
+			uint64_t mask = Group(ctrl + group * GROUP_SIZE).match_free();
+			if (mask) {
+				return group * GROUP_SIZE + Group::next(mask);
+			}
+			group = (group + step) & group_mask;
+		}
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity) {
+		int8_t *old_ctrl = ctrl;
+		KeyValue<TKey, TValue> *old_slots = slots;
+		uint32_t old_capacity = capacity;
+
+		capacity = p_new_capacity;
+		ctrl = reinterpret_cast<int8_t *>(Memory::alloc_static(sizeof(int8_t) * capacity));
+		slots = reinterpret_cast<KeyValue<TKey, TValue> *>(Memory::alloc_static(sizeof(KeyValue<TKey, TValue>) * capacity));
+		memset(ctrl, CTRL_EMPTY, sizeof(int8_t) * capacity);
+		growth_left = _capacity_to_growth(capacity) - num_elements;
+
+		if (old_ctrl == nullptr) {
+			return;
+		}
+
+		for (uint32_t i = 0; i < old_capacity; i++) {
+			if (old_ctrl[i] < 0) {
+				continue;
+			}
+			uint32_t hash = Hasher::hash(old_slots[i].key);
+			uint32_t pos = _find_free_pos(hash);
+			ctrl[pos] = _h2(hash);
+			memnew_placement(&slots[pos], Element(old_slots[i]));
+			old_slots[i].~KeyValue<TKey, TValue>();
+		}
+
+		Memory::free_static(old_ctrl);
+		Memory::free_static(old_slots);
+	}
+
+	uint32_t _insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t hash = Hasher::hash(p_key);
+		if (unlikely(ctrl == nullptr)) {
+			_resize_and_rehash(MIN_CAPACITY);
+		}
+
+		uint32_t pos = _find_free_pos(hash);
+		if (unlikely(growth_left == 0 && ctrl[pos] == CTRL_EMPTY)) {
+			// Out of empty slots. Grow, unless tombstones are the reason and rehashing in place frees enough.
+			_resize_and_rehash(num_elements < _capacity_to_growth(capacity) / 2 ? capacity : capacity * 2);
+			pos = _find_free_pos(hash);
+		}
+
+		if (ctrl[pos] == CTRL_EMPTY) {
+			growth_left--;
+		}
+		ctrl[pos] = _h2(hash);
+		memnew_placement(&slots[pos], Element(p_key, p_value));
+		num_elements++;
+		return pos;
+	}
+
+	void _erase_pos(uint32_t p_pos) {
+		slots[p_pos].~KeyValue<TKey, TValue>();
+		num_elements--;
+
+		// Probing stops at groups with an empty slot, so none went past this group and the slot can
+		// become empty again. Otherwise leave a tombstone so longer probe sequences stay intact.
+		if (Group(ctrl + (p_pos / GROUP_SIZE) * GROUP_SIZE).match_empty()) {
+			ctrl[p_pos] = CTRL_EMPTY;
+			growth_left++;
+		} else {
+			ctrl[p_pos] = CTRL_DELETED;
+		}
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t get_capacity() const { return capacity; }
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+
+	/* Standard Godot Container API */
+
+	bool is_empty() const {
+		return num_elements == 0;
+	}
+
+	void clear() {
+		if (ctrl == nullptr) {
+			return;
+		}
+		if constexpr (!std::is_trivially_destructible_v<KeyValue<TKey, TValue>>) {
+			for (uint32_t i = 0; i < capacity && num_elements > 0; i++) {
+				if (ctrl[i] >= 0) {
+					slots[i].~KeyValue<TKey, TValue>();
+					num_elements--;
+				}
+			}
+		}
+		memset(ctrl, CTRL_EMPTY, sizeof(int8_t) * capacity);
+		num_elements = 0;
+		growth_left = _capacity_to_growth(capacity);
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND_MSG(!exists, "FlatHashMap key not found.");
+		return slots[pos].value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND_MSG(!exists, "FlatHashMap key not found.");
+		return slots[pos].value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t pos = 0;
+		if (_lookup_pos(p_key, pos)) {
+			return &slots[pos].value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t pos = 0;
+		if (_lookup_pos(p_key, pos)) {
+			return &slots[pos].value;
+		}
+		return nullptr;
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		uint32_t _pos = 0;
+		return _lookup_pos(p_key, _pos);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t pos = 0;
+		if (!_lookup_pos(p_key, pos)) {
+			return false;
+		}
+		_erase_pos(pos);
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	// If adding a known (possibly large) number of elements at once, must be larger than old capacity.
+	void reserve(uint32_t p_new_capacity) {
+		uint32_t new_capacity = MIN_CAPACITY;
+		while (_capacity_to_growth(new_capacity) < p_new_capacity) {
+			new_capacity *= 2;
+		}
+		if (new_capacity <= capacity) {
+			return;
+		}
+		_resize_and_rehash(new_capacity);
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> &operator*() const {
+			return map->slots[pos];
+		}
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> *operator->() const { return &map->slots[pos]; }
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			pos = map->_next_full(pos + 1);
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return pos == b.pos; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return pos != b.pos; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return map != nullptr && pos < map->capacity;
+		}
+
+		_FORCE_INLINE_ ConstIterator(const FlatHashMap *p_map, uint32_t p_pos) {
+			map = p_map;
+			pos = p_pos;
+		}
+		_FORCE_INLINE_ ConstIterator() {}
+
+	private:
+		const FlatHashMap *map = nullptr;
+		uint32_t pos = 0;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ KeyValue<TKey, TValue> &operator*() const {
+			return map->slots[pos];
+		}
+		_FORCE_INLINE_ KeyValue<TKey, TValue> *operator->() const { return &map->slots[pos]; }
+		_FORCE_INLINE_ Iterator &operator++() {
+			pos = map->_next_full(pos + 1);
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return pos == b.pos; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return pos != b.pos; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return map != nullptr && pos < map->capacity;
+		}
+
+		_FORCE_INLINE_ Iterator(FlatHashMap *p_map, uint32_t p_pos) {
+			map = p_map;
+			pos = p_pos;
+		}
+		_FORCE_INLINE_ Iterator() {}
+
+		operator ConstIterator() const {
+			return ConstIterator(map, pos);
+		}
+
+	private:
+		FlatHashMap *map = nullptr;
+		uint32_t pos = 0;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		return Iterator(this, _next_full(0));
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator(this, capacity);
+	}
+
+	_FORCE_INLINE_ Iterator find(const TKey &p_key) {
+		uint32_t pos = 0;
+		if (!_lookup_pos(p_key, pos)) {
+			return end();
+		}
+		return Iterator(this, pos);
+	}
+
+	_FORCE_INLINE_ void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			erase(p_iter->key);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(this, _next_full(0));
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(this, capacity);
+	}
+
+	_FORCE_INLINE_ ConstIterator find(const TKey &p_key) const {
+		uint32_t pos = 0;
+		if (!_lookup_pos(p_key, pos)) {
+			return end();
+		}
+		return ConstIterator(this, pos);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND(!exists);
+		return slots[pos].value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t pos = 0;
+		if (!_lookup_pos(p_key, pos)) {
+			pos = _insert(p_key, TValue());
+		}
+		return slots[pos].value;
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t pos = 0;
+		if (_lookup_pos(p_key, pos)) {
+			slots[pos].value = p_value;
+		} else {
+			pos = _insert(p_key, p_value);
+		}
+		return Iterator(this, pos);
+	}
+
+	/* Constructors */
+
+	FlatHashMap(const FlatHashMap &p_other) {
+		reserve(p_other.num_elements);
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			_insert(E.key, E.value);
+		}
+	}
+
+	void operator=(const FlatHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+		clear();
+		reserve(p_other.num_elements);
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			_insert(E.key, E.value);
+		}
+	}
+
+	FlatHashMap(uint32_t p_initial_capacity) {
+		reserve(p_initial_capacity);
+	}
+	FlatHashMap() {}
+
+	~FlatHashMap() {
+		clear();
+
+		if (ctrl != nullptr) {
+			Memory::free_static(ctrl);
+			Memory::free_static(slots);
+		}
+	}
+
+private:
+	uint32_t _next_full(uint32_t p_pos) const {
+		while (p_pos < capacity && ctrl[p_pos] < 0) {
+			p_pos++;
+		}
+		return p_pos;
+	}
+};
+
+#endif // FLAT_HASH_MAP_H
@@ -0,0 +1,205 @@
+/**************************************************************************/
+/*  small_vector.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include "core/error/error_macros.h"
+#include "core/os/memory.h"
+#include "core/templates/vector.h"
+
+#include <initializer_list>
+#include <type_traits>
+
+// A vector that keeps up to N elements inline, without allocating.
+// It only moves its elements to the heap once it grows past N, which makes it a good
+// fit for short lists built on hot paths (bound arguments, path components, etc.).
+// Like LocalVector, elements are relocated bitwise when the storage changes.
+template <typename T, uint32_t N, typename U = uint32_t>
+class SmallVector {
+	static_assert(N > 0, "SmallVector needs room for at least one inline element.");
+
+	U count = 0;
+	U capacity = N;
+	T *heap = nullptr;
+	alignas(T) uint8_t inline_data[sizeof(T) * N];
+
+	_FORCE_INLINE_ T *_data() { return heap ? heap : reinterpret_cast<T *>(inline_data); }
+	_FORCE_INLINE_ const T *_data() const { return heap ? heap : reinterpret_cast<const T *>(inline_data); }
+
+	void _grow(U p_capacity) {
+		if (heap) {
+			heap = (T *)memrealloc(heap, p_capacity * sizeof(T));
+			CRASH_COND_MSG(!heap, "Out of memory");
+		} else {
+			heap = (T *)memalloc(p_capacity * sizeof(T));
+			CRASH_COND_MSG(!heap, "Out of memory");
+			memcpy((void *)heap, inline_data, count * sizeof(T));
+		}
+		capacity = p_capacity;
+	}
+
+public:
+	_FORCE_INLINE_ T *ptr() { return _data(); }
+	_FORCE_INLINE_ const T *ptr() const { return _data(); }
+
+	_FORCE_INLINE_ U size() const { return count; }
+	_FORCE_INLINE_ bool is_empty() const { return count == 0; }
+	_FORCE_INLINE_ U get_capacity() const { return capacity; }
+
+	// Returns true while no heap allocation has been needed.
+	_FORCE_INLINE_ bool is_inline() const { return heap == nullptr; }
+
+	_FORCE_INLINE_ void push_back(T p_elem) {
+		if (unlikely(count == capacity)) {
+			_grow(capacity << 1);
+		}
+		memnew_placement(&_data()[count++], T(p_elem));
+	}
+
+	void remove_at(U p_index) {
+		ERR_FAIL_UNSIGNED_INDEX(p_index, count);
+		T *data = _data();
+		count--;
+		for (U i = p_index; i < count; i++) {
+			data[i] = data[i + 1];
+		}
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			data[count].~T();
+		}
+	}
+
+	void reserve(U p_size) {
+		if (p_size > capacity) {
+			_grow(nearest_power_of_2_templated(p_size));
+		}
+	}
+
+	void resize(U p_size) {
+		if (p_size < count) {
+			if constexpr (!std::is_trivially_destructible_v<T>) {
+				T *data = _data();
+				for (U i = p_size; i < count; i++) {
+					data[i].~T();
+				}
+			}
+			count = p_size;
+		} else if (p_size > count) {
+			reserve(p_size);
+			if constexpr (!std::is_trivially_constructible_v<T>) {
+				T *data = _data();
+				for (U i = count; i < p_size; i++) {
+					memnew_placement(&data[i], T);
+				}
+			}
+			count = p_size;
+		}
+	}
+
+	_FORCE_INLINE_ void clear() { resize(0); }
+	void reset() {
+		clear();
+		if (heap) {
+			memfree(heap);
+			heap = nullptr;
+			capacity = N;
+		}
+	}
+
+	_FORCE_INLINE_ const T &operator[](U p_index) const {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, count);
+		return _data()[p_index];
+	}
+	_FORCE_INLINE_ T &operator[](U p_index) {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, count);
+		return _data()[p_index];
+	}
+
+	_FORCE_INLINE_ T *begin() { return _data(); }
+	_FORCE_INLINE_ T *end() { return _data() + count; }
+	_FORCE_INLINE_ const T *begin() const { return _data(); }
+	_FORCE_INLINE_ const T *end() const { return _data() + count; }
+
+	int64_t find(const T &p_val, U p_from = 0) const {
+		const T *data = _data();
+		for (U i = p_from; i < count; i++) {
+			if (data[i] == p_val) {
+				return int64_t(i);
+			}
+		}
+		return -1;
+	}
+
+	bool has(const T &p_val) const {
+		return find(p_val) != -1;
+	}
+
+	operator Vector<T>() const {
+		Vector<T> ret;
+		ret.resize(count);
+		T *w = ret.ptrw();
+		const T *data = _data();
+		for (U i = 0; i < count; i++) {
+			w[i] = data[i];
+		}
+		return ret;
+	}
+
+	void operator=(const SmallVector &p_from) {
+		if (this == &p_from) {
+			return;
+		}
+		clear();
+		reserve(p_from.count);
+		for (const T &E : p_from) {
+			push_back(E);
+		}
+	}
+
+	_FORCE_INLINE_ SmallVector() {}
+	_FORCE_INLINE_ SmallVector(std::initializer_list<T> p_init) {
+		reserve(p_init.size());
+		for (const T &element : p_init) {
+			push_back(element);
+		}
+	}
+	SmallVector(const SmallVector &p_from) {
+		reserve(p_from.count);
+		for (const T &E : p_from) {
+			push_back(E);
+		}
+	}
+
+	_FORCE_INLINE_ ~SmallVector() {
+		reset();
+	}
+};
+
+#endif // SMALL_VECTOR_H
@@ -0,0 +1,184 @@
+/**************************************************************************/
+/*  work_stealing_deque.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef WORK_STEALING_DEQUE_H
+#define WORK_STEALING_DEQUE_H
+
+#include "core/os/memory.h"
+#include "core/typedefs.h"
+
+#include <atomic>
+#include <type_traits>
+
+// Chase-Lev work-stealing deque (as formulated for weak memory models by Lê et al., 2013).
+// - Only the owner thread may call push() and pop(); they operate on the bottom end (LIFO).
+// - Any thread may call steal(); it takes from the top end (FIFO).
+// - The ring buffer grows on demand. Replaced buffers are kept until the deque is destroyed,
+//   since a concurrent thief may still be reading from them.
+
+template <typename T>
+class WorkStealingDeque {
+	static_assert(std::is_trivially_copyable_v<T>);
+	static_assert(std::atomic<T>::is_always_lock_free);
+
+	struct Buffer {
+		int64_t mask = 0;
+		std::atomic<T> *items = nullptr;
+		Buffer *retired_next = nullptr;
+	};
+
+	static constexpr int64_t DEFAULT_CAPACITY = 64;
+
+	// Padded rather than aligned, so the deque can be stored in containers that only guarantee
+	// the alignment of max_align_t. Either way, top and bottom never share a cache line.
+	std::atomic<int64_t> top = 0; // Contended by thieves.
+	uint8_t top_padding[64 - sizeof(std::atomic<int64_t>)];
+	std::atomic<int64_t> bottom = 0; // Owned by the owner thread.
+	std::atomic<Buffer *> buffer = nullptr;
+	Buffer *retired = nullptr;
+
+	static Buffer *_alloc_buffer(int64_t p_capacity) {
+		Buffer *buf = memnew(Buffer);
+		buf->mask = p_capacity - 1;
+		buf->items = (std::atomic<T> *)memalloc(sizeof(std::atomic<T>) * p_capacity);
+		for (int64_t i = 0; i < p_capacity; i++) {
+			memnew_placement(&buf->items[i], std::atomic<T>);
+		}
+		return buf;
+	}
+
+	static void _free_buffer(Buffer *p_buffer) {
+		memfree(p_buffer->items);
+		memdelete(p_buffer);
+	}
+
+	Buffer *_grow(Buffer *p_buffer, int64_t p_top, int64_t p_bottom) {
+		Buffer *new_buf = _alloc_buffer((p_buffer->mask + 1) * 2);
+		for (int64_t i = p_top; i < p_bottom; i++) {
+			new_buf->items[i & new_buf->mask].store(p_buffer->items[i & p_buffer->mask].load(std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+		buffer.store(new_buf, std::memory_order_release);
+		p_buffer->retired_next = retired;
+		retired = p_buffer;
+		return new_buf;
+	}
+
+public:
+	// Owner thread only.
+	void push(T p_value) {
+		int64_t b = bottom.load(std::memory_order_relaxed);
+		int64_t t = top.load(std::memory_order_acquire);
+		Buffer *buf = buffer.load(std::memory_order_relaxed);
+		if (unlikely(b - t > buf->mask)) {
+			buf = _grow(buf, t, b);
+		}
+		buf->items[b & buf->mask].store(p_value, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		bottom.store(b + 1, std::memory_order_relaxed);
+	}
+
+	// Owner thread only.
+	bool pop(T &r_value) {
+		int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+		Buffer *buf = buffer.load(std::memory_order_relaxed);
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t t = top.load(std::memory_order_relaxed);
+
+		if (t > b) {
+			// Empty.
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		T value = buf->items[b & buf->mask].load(std::memory_order_relaxed);
+		if (t == b) {
+			// Last item; race against thieves for it.
+			bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			bottom.store(b + 1, std::memory_order_relaxed);
+			if (!won) {
+				return false;
+			}
+		}
+		r_value = value;
+		return true;
+	}
+
+	// Any thread. May fail spuriously if another thread wins the race for the same item.
+	bool steal(T &r_value) {
+		int64_t t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t b = bottom.load(std::memory_order_acquire);
+
+		if (t >= b) {
+			return false;
+		}
+
+		Buffer *buf = buffer.load(std::memory_order_acquire);
+		T value = buf->items[t & buf->mask].load(std::memory_order_relaxed);
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			return false;
+		}
+		r_value = value;
+		return true;
+	}
+
+	// Approximate when called concurrently with push(), pop() or steal().
+	_FORCE_INLINE_ bool is_empty() const {
+		return bottom.load(std::memory_order_acquire) <= top.load(std::memory_order_acquire);
+	}
+
+	_FORCE_INLINE_ int64_t size() const {
+		int64_t s = bottom.load(std::memory_order_acquire) - top.load(std::memory_order_acquire);
+		return s > 0 ? s : 0;
+	}
+
+	WorkStealingDeque(int64_t p_capacity = DEFAULT_CAPACITY) {
+		int64_t capacity = 1;
+		while (capacity < p_capacity) {
+			capacity <<= 1;
+		}
+		buffer.store(_alloc_buffer(capacity), std::memory_order_relaxed);
+	}
+
+	WorkStealingDeque(const WorkStealingDeque &) = delete;
+	WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+	~WorkStealingDeque() {
+		_free_buffer(buffer.load(std::memory_order_relaxed));
+		while (retired) {
+			Buffer *next = retired->retired_next;
+			_free_buffer(retired);
+			retired = next;
+		}
+	}
+};
+
+#endif // WORK_STEALING_DEQUE_H
@@ -123,12 +123,7 @@ Error Callable::rpcp(int p_id, const Variant **p_arguments, int p_argcount, Call
 }
 
 Callable Callable::bindp(const Variant **p_arguments, int p_argcount) const {
-	Vector<Variant> args;
-	args.resize(p_argcount);
-	for (int i = 0; i < p_argcount; i++) {
-		args.write[i] = *p_arguments[i];
-	}
-	return Callable(memnew(CallableCustomBind(*this, args)));
+	return Callable(memnew(CallableCustomBind(*this, p_arguments, p_argcount)));
 }
 
 Callable Callable::bindv(const Array &p_arguments) {
@@ -136,12 +131,12 @@ Callable Callable::bindv(const Array &p_arguments) {
 		return *this; // No point in creating a new callable if nothing is bound.
 	}
 
-	Vector<Variant> args;
-	args.resize(p_arguments.size());
-	for (int i = 0; i < p_arguments.size(); i++) {
-		args.write[i] = p_arguments[i];
+	int argcount = p_arguments.size();
+	const Variant **args = (const Variant **)alloca(sizeof(Variant *) * argcount);
+	for (int i = 0; i < argcount; i++) {
+		args[i] = &p_arguments[i];
 	}
-	return Callable(memnew(CallableCustomBind(*this, args)));
+	return Callable(memnew(CallableCustomBind(*this, args, argcount)));
 }
 
 Callable Callable::unbind(int p_argcount) const {
@@ -215,11 +210,30 @@ void Callable::get_bound_arguments_ref(Vector<Variant> &r_arguments, int &r_argc
 	}
 }
 
+bool Callable::get_bound_arguments_span(const Variant *&r_arguments, int &r_argcount) const {
+	if (!is_null() && is_custom()) {
+		return custom->get_bound_arguments_span(r_arguments, r_argcount);
+	}
+	r_arguments = nullptr;
+	r_argcount = 0;
+	return true;
+}
+
 Array Callable::get_bound_arguments() const {
+	Array ret;
+	const Variant *span;
+	int span_count;
+	if (get_bound_arguments_span(span, span_count)) {
+		ret.resize(span_count);
+		for (int i = 0; i < span_count; i++) {
+			ret[i] = span[i];
+		}
+		return ret;
+	}
+
 	Vector<Variant> arr;
 	int ac;
 	get_bound_arguments_ref(arr, ac);
-	Array ret;
 	ret.resize(arr.size());
 	for (int i = 0; i < arr.size(); i++) {
 		ret[i] = arr[i];
@@ -468,6 +482,15 @@ void CallableCustom::get_bound_arguments(Vector<Variant> &r_arguments, int &r_ar
 	r_argcount = 0;
 }
 
+bool CallableCustom::get_bound_arguments_span(const Variant *&r_arguments, int &r_argcount) const {
+	if (get_bound_arguments_count() != 0) {
+		return false; // Only get_bound_arguments() knows how to get them.
+	}
+	r_arguments = nullptr;
+	r_argcount = 0;
+	return true;
+}
+
 CallableCustom::CallableCustom() {
 	ref_count.init();
 }
@@ -112,6 +112,7 @@ public:
 	int get_argument_count(bool *r_is_valid = nullptr) const;
 	int get_bound_arguments_count() const;
 	void get_bound_arguments_ref(Vector<Variant> &r_arguments, int &r_argcount) const; // Internal engine use, the exposed one is below.
+	bool get_bound_arguments_span(const Variant *&r_arguments, int &r_argcount) const; // Same, without copying. Fails if they must be combined first.
 	Array get_bound_arguments() const;
 
 	uint32_t hash() const;
@@ -159,6 +160,7 @@ public:
 	virtual int get_argument_count(bool &r_is_valid) const;
 	virtual int get_bound_arguments_count() const;
 	virtual void get_bound_arguments(Vector<Variant> &r_arguments, int &r_argcount) const;
+	virtual bool get_bound_arguments_span(const Variant *&r_arguments, int &r_argcount) const;
 
 	CallableCustom();
 	virtual ~CallableCustom() {}
@@ -94,13 +94,22 @@ const Callable *CallableCustomBind::get_base_comparator() const {
 int CallableCustomBind::get_argument_count(bool &r_is_valid) const {
 	int ret = callable.get_argument_count(&r_is_valid);
 	if (r_is_valid) {
-		return ret - binds.size();
+		return ret - (int)binds.size();
 	}
 	return 0;
 }
 
 int CallableCustomBind::get_bound_arguments_count() const {
-	return callable.get_bound_arguments_count() + binds.size();
+	return callable.get_bound_arguments_count() + (int)binds.size();
+}
+
+bool CallableCustomBind::get_bound_arguments_span(const Variant *&r_arguments, int &r_argcount) const {
+	if (callable.get_bound_arguments_count() != 0) {
+		return false; // Has to be combined with the arguments bound by the wrapped callable.
+	}
+	r_arguments = binds.ptr();
+	r_argcount = binds.size();
+	return true;
 }
 
 void CallableCustomBind::get_bound_arguments(Vector<Variant> &r_arguments, int &r_argcount) const {
@@ -108,13 +117,14 @@ void CallableCustomBind::get_bound_arguments(Vector<Variant> &r_arguments, int &
 	int sub_count;
 	callable.get_bound_arguments_ref(sub_args, sub_count);
 
+	int bind_count = binds.size();
 	if (sub_count == 0) {
 		r_arguments = binds;
-		r_argcount = binds.size();
+		r_argcount = bind_count;
 		return;
 	}
 
-	int new_count = sub_count + binds.size();
+	int new_count = sub_count + bind_count;
 	r_argcount = new_count;
 
 	if (new_count <= 0) {
@@ -129,44 +139,57 @@ void CallableCustomBind::get_bound_arguments(Vector<Variant> &r_arguments, int &
 		for (int i = 0; i < sub_count; i++) {
 			r_arguments.write[i] = sub_args[i];
 		}
-		for (int i = 0; i < binds.size(); i++) {
+		for (int i = 0; i < bind_count; i++) {
 			r_arguments.write[i + sub_count] = binds[i];
 		}
 		r_argcount = new_count;
 	} else {
-		for (int i = 0; i < binds.size() + sub_count; i++) {
+		for (int i = 0; i < bind_count + sub_count; i++) {
 			r_arguments.write[i] = binds[i - sub_count];
 		}
 	}
 }
 
 void CallableCustomBind::call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const {
-	const Variant **args = (const Variant **)alloca(sizeof(Variant *) * (binds.size() + p_argcount));
+	int bind_count = binds.size();
+	const Variant **args = (const Variant **)alloca(sizeof(Variant *) * (bind_count + p_argcount));
 	for (int i = 0; i < p_argcount; i++) {
 		args[i] = (const Variant *)p_arguments[i];
 	}
-	for (int i = 0; i < binds.size(); i++) {
+	for (int i = 0; i < bind_count; i++) {
 		args[i + p_argcount] = (const Variant *)&binds[i];
 	}
 
-	callable.callp(args, p_argcount + binds.size(), r_return_value, r_call_error);
+	callable.callp(args, p_argcount + bind_count, r_return_value, r_call_error);
 }
 
 Error CallableCustomBind::rpc(int p_peer_id, const Variant **p_arguments, int p_argcount, Callable::CallError &r_call_error) const {
-	const Variant **args = (const Variant **)alloca(sizeof(Variant *) * (binds.size() + p_argcount));
+	int bind_count = binds.size();
+	const Variant **args = (const Variant **)alloca(sizeof(Variant *) * (bind_count + p_argcount));
 	for (int i = 0; i < p_argcount; i++) {
 		args[i] = (const Variant *)p_arguments[i];
 	}
-	for (int i = 0; i < binds.size(); i++) {
+	for (int i = 0; i < bind_count; i++) {
 		args[i + p_argcount] = (const Variant *)&binds[i];
 	}
 
-	return callable.rpcp(p_peer_id, args, p_argcount + binds.size(), r_call_error);
+	return callable.rpcp(p_peer_id, args, p_argcount + bind_count, r_call_error);
 }
 
 CallableCustomBind::CallableCustomBind(const Callable &p_callable, const Vector<Variant> &p_binds) {
 	callable = p_callable;
-	binds = p_binds;
+	binds.reserve(p_binds.size());
+	for (const Variant &E : p_binds) {
+		binds.push_back(E);
+	}
+}
+
+CallableCustomBind::CallableCustomBind(const Callable &p_callable, const Variant **p_binds, int p_bind_count) {
+	callable = p_callable;
+	binds.reserve(p_bind_count);
+	for (int i = 0; i < p_bind_count; i++) {
+		binds.push_back(*p_binds[i]);
+	}
 }
 
 CallableCustomBind::~CallableCustomBind() {
@@ -31,12 +31,13 @@
 #ifndef CALLABLE_BIND_H
 #define CALLABLE_BIND_H
 
+#include "core/templates/small_vector.h"
 #include "core/variant/callable.h"
 #include "core/variant/variant.h"
 
 class CallableCustomBind : public CallableCustom {
 	Callable callable;
-	Vector<Variant> binds;
+	SmallVector<Variant, 3> binds; // Most callables bind only a few arguments, keep them inline.
 
 	static bool _equal_func(const CallableCustom *p_a, const CallableCustom *p_b);
 	static bool _less_func(const CallableCustom *p_a, const CallableCustom *p_b);
@@ -56,10 +57,12 @@ public:
 	virtual int get_argument_count(bool &r_is_valid) const override;
 	virtual int get_bound_arguments_count() const override;
 	virtual void get_bound_arguments(Vector<Variant> &r_arguments, int &r_argcount) const override;
+	virtual bool get_bound_arguments_span(const Variant *&r_arguments, int &r_argcount) const override;
 	Callable get_callable() { return callable; }
 	Vector<Variant> get_binds() { return binds; }
 
 	CallableCustomBind(const Callable &p_callable, const Vector<Variant> &p_binds);
+	CallableCustomBind(const Callable &p_callable, const Variant **p_binds, int p_bind_count);
 	virtual ~CallableCustomBind();
 };
 
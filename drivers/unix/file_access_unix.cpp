@@ -37,6 +37,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -142,6 +143,12 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+	if (mapped) {
+		munmap(mapped, mapped_size);
+		mapped = nullptr;
+		mapped_size = 0;
+	}
+
 	fclose(f);
 	f = nullptr;
 
@@ -282,6 +289,70 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+const uint8_t *FileAccessUnix::map_read_only() {
+	ERR_FAIL_NULL_V_MSG(f, nullptr, "File must be opened before use.");
+	if (mapped) {
+		// Touching pages past the end of a truncated file raises SIGBUS, so check it still
+		// covers the mapping before handing it out again.
+		struct stat st = {};
+		if (fstat(fileno(f), &st) != 0 || (uint64_t)st.st_size < mapped_size) {
+			return nullptr;
+		}
+		return (const uint8_t *)mapped;
+	}
+	if (flags != READ) {
+		return nullptr; // Writes through the FILE buffer would not be visible in the mapping.
+	}
+
+	uint64_t size = get_length();
+	if (size == 0 || size > SIZE_MAX) {
+		return nullptr;
+	}
+	// Private, so writes to the file by other processes don't have to show up in the mapping.
+	void *mem = mmap(nullptr, (size_t)size, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+	if (mem == MAP_FAILED) {
+		return nullptr;
+	}
+	mapped = mem;
+	mapped_size = size;
+	return (const uint8_t *)mapped;
+}
+
+bool FileAccessUnix::can_get_buffer_at() const {
+	return f && flags == READ;
+}
+
+uint64_t FileAccessUnix::get_buffer_at(uint64_t p_position, uint8_t *p_dst, uint64_t p_length) {
+	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, 0);
+
+	if (mapped) {
+		if (p_position >= mapped_size) {
+			return 0;
+		}
+		uint64_t to_read = MIN(p_length, mapped_size - p_position);
+		memcpy(p_dst, (const uint8_t *)mapped + p_position, to_read);
+		return to_read;
+	}
+
+	// pread() leaves the stream position alone, so this can run alongside regular reads.
+	int fd = fileno(f);
+	uint64_t total = 0;
+	while (total < p_length) {
+		ssize_t read = ::pread(fd, p_dst + total, p_length - total, p_position + total);
+		if (read < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			break;
+		} else if (read == 0) {
+			break;
+		}
+		total += read;
+	}
+	return total;
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
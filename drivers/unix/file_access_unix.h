@@ -48,6 +48,8 @@ class FileAccessUnix : public FileAccess {
 	String save_path;
 	String path;
 	String path_src;
+	void *mapped = nullptr;
+	uint64_t mapped_size = 0;
 
 	void _close();
 
@@ -72,6 +74,9 @@ public:
 	virtual uint32_t get_32() const override;
 	virtual uint64_t get_64() const override;
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *map_read_only() override;
+	virtual bool can_get_buffer_at() const override;
+	virtual uint64_t get_buffer_at(uint64_t p_position, uint8_t *p_dst, uint64_t p_length) override;
 
 	virtual Error get_error() const override; ///< get last error
 
@@ -218,6 +218,15 @@ void FileAccessWindows::_close() {
 		return;
 	}
 
+	if (mapped) {
+		UnmapViewOfFile(mapped);
+		mapped = nullptr;
+	}
+	if (mapping) {
+		CloseHandle((HANDLE)mapping);
+		mapping = nullptr;
+	}
+
 	fclose(f);
 	f = nullptr;
 
@@ -411,6 +420,37 @@ uint64_t FileAccessWindows::get_buffer(uint8_t *p_dst, uint64_t p_length) const
 	return read;
 }
 
+const uint8_t *FileAccessWindows::map_read_only() {
+	ERR_FAIL_NULL_V_MSG(f, nullptr, "File must be opened before use.");
+	if (mapped) {
+		return (const uint8_t *)mapped;
+	}
+	if (flags != READ) {
+		return nullptr; // Writes through the FILE buffer would not be visible in the mapping.
+	}
+
+	uint64_t size = get_length();
+	if (size == 0 || size > SIZE_MAX) {
+		return nullptr;
+	}
+	HANDLE file_handle = (HANDLE)_get_osfhandle(_fileno(f));
+	if (file_handle == INVALID_HANDLE_VALUE) {
+		return nullptr;
+	}
+	HANDLE map_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (map_handle == nullptr) {
+		return nullptr;
+	}
+	void *mem = MapViewOfFile(map_handle, FILE_MAP_READ, 0, 0, 0);
+	if (mem == nullptr) {
+		CloseHandle(map_handle);
+		return nullptr;
+	}
+	mapping = map_handle;
+	mapped = mem;
+	return (const uint8_t *)mapped;
+}
+
 Error FileAccessWindows::get_error() const {
 	return last_error;
 }
@@ -47,6 +47,8 @@ class FileAccessWindows : public FileAccess {
 	String path;
 	String path_src;
 	String save_path;
+	void *mapping = nullptr; // HANDLE of the file mapping object.
+	void *mapped = nullptr;
 
 	void _close();
 
@@ -74,6 +76,7 @@ public:
 	virtual uint32_t get_32() const override;
 	virtual uint64_t get_64() const override;
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *map_read_only() override;
 
 	virtual Error get_error() const override; ///< get last error
 
@@ -46,6 +46,7 @@
 #include "core/io/ip.h"
 #include "core/io/resource_loader.h"
 #include "core/object/message_queue.h"
+#include "core/os/frame_allocator.h"
 #include "core/os/os.h"
 #include "core/os/time.h"
 #include "core/register_core_types.h"
@@ -1803,11 +1804,17 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			float low_priority_ratio = GLOBAL_GET("threading/worker_pool/low_priority_thread_ratio");
 			WorkerThreadPool::get_singleton()->init(worker_threads, low_priority_ratio);
 		}
+		ResourceLoader::set_parallel_dependency_threshold(GLOBAL_GET("threading/resource_loader/parallel_dependency_threshold"));
 #else
 		WorkerThreadPool::get_singleton()->init(0, 0);
 #endif
 	}
 
+	// The editor reloads resources on its own terms, so only running projects retain them.
+	if (!editor && !project_manager) {
+		ResourceCache::set_retained_budget(uint64_t(int(GLOBAL_GET("memory/limits/resource_cache/retained_budget_mb"))) * 1024 * 1024);
+	}
+
 #ifdef TOOLS_ENABLED
 	if (editor) {
 		Engine::get_singleton()->set_editor_hint(true);
@@ -4174,6 +4181,11 @@ bool Main::iteration() {
 
 	iterating--;
 
+	if (iterating == 0) {
+		// Nested iterations (e.g. from progress dialogs) run inside the outer frame.
+		FrameAllocator::end_frame();
+	}
+
 	if (movie_writer) {
 		movie_writer->add_frame();
 	}
@@ -4267,6 +4279,9 @@ void Main::cleanup(bool p_force) {
 
 	OS::get_singleton()->delete_main_loop();
 
+	// Retained resources may hold server data, release them before the servers go away.
+	ResourceCache::clear_retained();
+
 	OS::get_singleton()->_cmdline.clear();
 	OS::get_singleton()->_user_args.clear();
 	OS::get_singleton()->_execpath = "";
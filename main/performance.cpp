@@ -30,6 +30,7 @@
 
 #include "performance.h"
 
+#include "core/io/resource.h"
 #include "core/os/os.h"
 #include "core/variant/typed_array.h"
 #include "scene/main/node.h"
@@ -91,6 +92,10 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_MERGE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_CONNECTION_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_FREE_COUNT);
+	BIND_ENUM_CONSTANT(RESOURCE_CACHE_HITS);
+	BIND_ENUM_CONSTANT(RESOURCE_CACHE_MISSES);
+	BIND_ENUM_CONSTANT(RESOURCE_CACHE_EVICTIONS);
+	BIND_ENUM_CONSTANT(RESOURCE_CACHE_RETAINED_MEMORY);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -103,6 +108,25 @@ int Performance::_get_node_count() const {
 	return sml->get_node_count();
 }
 
+uint64_t Performance::_get_memory_arena_allocations(int p_class) {
+	if (p_class < 0) {
+		return Memory::get_arena_system_allocation_count();
+	}
+	return Memory::get_arena_allocation_count(p_class);
+}
+
+void Performance::_add_memory_arena_monitors() {
+	// Only present in builds with `memory_arena=yes`.
+	if (Memory::get_arena_size_class_count() == 0) {
+		return;
+	}
+	for (int i = 0; i < Memory::get_arena_size_class_count(); i++) {
+		add_custom_monitor(vformat("memory_arena/allocs_%d", Memory::get_arena_size_class_bytes(i)), callable_mp_static(&Performance::_get_memory_arena_allocations), varray(i));
+	}
+	add_custom_monitor("memory_arena/allocs_system", callable_mp_static(&Performance::_get_memory_arena_allocations), varray(-1));
+	add_custom_monitor("memory_arena/reserved", callable_mp_static(&Memory::get_arena_reserved), Vector<Variant>());
+}
+
 String Performance::get_monitor_name(Monitor p_monitor) const {
 	ERR_FAIL_INDEX_V(p_monitor, MONITOR_MAX, String());
 	static const char *names[MONITOR_MAX] = {
@@ -141,6 +165,10 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation/edges_merged"),
 		PNAME("navigation/edges_connected"),
 		PNAME("navigation/edges_free"),
+		PNAME("resource_cache/hits"),
+		PNAME("resource_cache/misses"),
+		PNAME("resource_cache/evictions"),
+		PNAME("resource_cache/retained_memory"),
 
 	};
 
@@ -225,6 +253,14 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT);
 		case NAVIGATION_EDGE_FREE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT);
+		case RESOURCE_CACHE_HITS:
+			return ResourceCache::get_retained_hits();
+		case RESOURCE_CACHE_MISSES:
+			return ResourceCache::get_retained_misses();
+		case RESOURCE_CACHE_EVICTIONS:
+			return ResourceCache::get_retained_evictions();
+		case RESOURCE_CACHE_RETAINED_MEMORY:
+			return ResourceCache::get_retained_memory();
 
 		default: {
 		}
@@ -272,6 +308,10 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
 
 	};
 
@@ -339,6 +379,8 @@ Performance::Performance() {
 	_navigation_process_time = 0;
 	_monitor_modification_time = 0;
 	singleton = this;
+
+	_add_memory_arena_monitors();
 }
 
 Performance::MonitorCall::MonitorCall(Callable p_callable, Vector<Variant> p_arguments) {
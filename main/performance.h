@@ -48,6 +48,9 @@ class Performance : public Object {
 
 	int _get_node_count() const;
 
+	static uint64_t _get_memory_arena_allocations(int p_class);
+	void _add_memory_arena_monitors();
+
 	double _process_time;
 	double _physics_process_time;
 	double _navigation_process_time;
@@ -100,6 +103,10 @@ public:
 		NAVIGATION_EDGE_MERGE_COUNT,
 		NAVIGATION_EDGE_CONNECTION_COUNT,
 		NAVIGATION_EDGE_FREE_COUNT,
+		RESOURCE_CACHE_HITS,
+		RESOURCE_CACHE_MISSES,
+		RESOURCE_CACHE_EVICTIONS,
+		RESOURCE_CACHE_RETAINED_MEMORY,
 		MONITOR_MAX
 	};
 
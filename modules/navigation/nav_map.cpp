@@ -1343,6 +1343,18 @@ void NavMap::compute_single_avoidance_step_3d(uint32_t index, NavAgent **agent)
 	(*(agent + index))->update();
 }
 
+void NavMap::compute_avoidance_steps_2d(uint32_t p_from, uint32_t p_to, NavAgent **agent) {
+	for (uint32_t i = p_from; i < p_to; i++) {
+		compute_single_avoidance_step_2d(i, agent);
+	}
+}
+
+void NavMap::compute_avoidance_steps_3d(uint32_t p_from, uint32_t p_to, NavAgent **agent) {
+	for (uint32_t i = p_from; i < p_to; i++) {
+		compute_single_avoidance_step_3d(i, agent);
+	}
+}
+
 void NavMap::step(real_t p_deltatime) {
 	deltatime = p_deltatime;
 
@@ -1351,8 +1363,7 @@ void NavMap::step(real_t p_deltatime) {
 
 	if (active_2d_avoidance_agents.size() > 0) {
 		if (use_threads && avoidance_use_multiple_threads) {
-			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::compute_single_avoidance_step_2d, active_2d_avoidance_agents.ptr(), active_2d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents2D"));
-			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			WorkerThreadPool::get_singleton()->parallel_for(this, &NavMap::compute_avoidance_steps_2d, active_2d_avoidance_agents.ptr(), 0, active_2d_avoidance_agents.size(), 0, SNAME("RVOAvoidanceAgents2D"));
 		} else {
 			for (NavAgent *agent : active_2d_avoidance_agents) {
 				agent->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
@@ -1365,8 +1376,7 @@ void NavMap::step(real_t p_deltatime) {
 
 	if (active_3d_avoidance_agents.size() > 0) {
 		if (use_threads && avoidance_use_multiple_threads) {
-			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::compute_single_avoidance_step_3d, active_3d_avoidance_agents.ptr(), active_3d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents3D"));
-			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			WorkerThreadPool::get_singleton()->parallel_for(this, &NavMap::compute_avoidance_steps_3d, active_3d_avoidance_agents.ptr(), 0, active_3d_avoidance_agents.size(), 0, SNAME("RVOAvoidanceAgents3D"));
 		} else {
 			for (NavAgent *agent : active_3d_avoidance_agents) {
 				agent->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
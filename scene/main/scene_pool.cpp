@@ -0,0 +1,321 @@
+/**************************************************************************/
+/*  scene_pool.cpp                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "scene_pool.h"
+
+void ScenePool::_prewarm_func(void *p_userdata) {
+	ScenePool *pool = (ScenePool *)p_userdata;
+	pool->_prewarm();
+}
+
+void ScenePool::_prewarm() {
+	while (true) {
+		Ref<PackedScene> to_instantiate;
+		{
+			MutexLock lock(mutex);
+			if (prewarm_pending == 0) {
+				prewarm_running = false;
+				return;
+			}
+			prewarm_pending--;
+			to_instantiate = scene;
+		}
+
+		// Nodes outside of the tree can be built on any thread.
+		Node *node = to_instantiate->instantiate();
+		if (node) {
+			_store(node);
+		}
+	}
+}
+
+void ScenePool::_store(Node *p_node) {
+	{
+		MutexLock lock(mutex);
+		if (max_size <= 0 || (int)available.size() < max_size) {
+			available.push_back(p_node);
+			return;
+		}
+	}
+	memdelete(p_node);
+}
+
+void ScenePool::_build_reset_state() {
+	reset_state_built = true;
+	reset_state.clear();
+
+	Node *base = scene->instantiate();
+	ERR_FAIL_NULL(base);
+
+	Ref<SceneState> state = scene->get_state();
+	for (int i = 0; i < state->get_node_count(); i++) {
+		NodeReset entry;
+		if (i > 0) {
+			entry.path = state->get_node_path(i);
+		}
+
+		Node *node = entry.path.is_empty() ? base : base->get_node_or_null(entry.path);
+		if (!node) {
+			continue;
+		}
+
+		List<PropertyInfo> plist;
+		node->get_property_list(&plist);
+		for (const PropertyInfo &E : plist) {
+			if (!(E.usage & PROPERTY_USAGE_STORAGE) || E.name == CoreStringName(script)) {
+				continue;
+			}
+
+			Variant value = node->get(E.name);
+			if (value.get_type() == Variant::OBJECT) {
+				// Node references belong to the instance, and local resources are unique to it.
+				Ref<Resource> res = value;
+				if (Object::cast_to<Node>(value) || (res.is_valid() && res->is_local_to_scene())) {
+					continue;
+				}
+			}
+			entry.properties.push_back(Pair<StringName, Variant>(E.name, value));
+		}
+
+		List<StringName> meta;
+		node->get_meta_list(&meta);
+		for (const StringName &E : meta) {
+			entry.meta.push_back(E);
+		}
+
+		entry.child_count = node->get_child_count(true);
+
+		reset_state.push_back(entry);
+	}
+
+	// The copy used as reference is as fresh as it gets.
+	_store(base);
+}
+
+bool ScenePool::_reset(Node *p_node) const {
+	for (const NodeReset &entry : reset_state) {
+		Node *node = entry.path.is_empty() ? p_node : p_node->get_node_or_null(entry.path);
+		if (!node || node->get_child_count(true) != entry.child_count) {
+			// The instance was restructured or got children added at runtime, it can't be reused.
+			return false;
+		}
+
+		for (const Pair<StringName, Variant> &E : entry.properties) {
+			if (node->get(E.first) == E.second) {
+				continue;
+			}
+			// Don't share containers between instances.
+			if (E.second.get_type() == Variant::ARRAY || E.second.get_type() == Variant::DICTIONARY) {
+				node->set(E.first, E.second.duplicate(true));
+			} else {
+				node->set(E.first, E.second);
+			}
+		}
+
+		// Metadata added since is not part of the stored properties above.
+		List<StringName> meta;
+		node->get_meta_list(&meta);
+		for (const StringName &E : meta) {
+			if (!entry.meta.has(E)) {
+				node->remove_meta(E);
+			}
+		}
+
+		node->request_ready();
+	}
+
+	return true;
+}
+
+void ScenePool::set_scene(const Ref<PackedScene> &p_scene) {
+	if (scene == p_scene) {
+		return;
+	}
+
+	clear();
+	scene = p_scene;
+	reset_state.clear();
+	reset_state_built = false;
+}
+
+Ref<PackedScene> ScenePool::get_scene() const {
+	return scene;
+}
+
+void ScenePool::set_max_size(int p_max_size) {
+	ERR_FAIL_COND(p_max_size < 0);
+
+	LocalVector<Node *> excess;
+	{
+		MutexLock lock(mutex);
+		max_size = p_max_size;
+		while (max_size > 0 && (int)available.size() > max_size) {
+			excess.push_back(available[available.size() - 1]);
+			available.resize(available.size() - 1);
+		}
+	}
+
+	for (Node *node : excess) {
+		memdelete(node);
+	}
+}
+
+int ScenePool::get_max_size() const {
+	return max_size;
+}
+
+Node *ScenePool::acquire() {
+	ERR_FAIL_COND_V_MSG(scene.is_null(), nullptr, "ScenePool has no scene to instantiate.");
+
+	{
+		MutexLock lock(mutex);
+		if (!available.is_empty()) {
+			Node *node = available[available.size() - 1];
+			available.resize(available.size() - 1);
+			return node;
+		}
+	}
+
+	return scene->instantiate();
+}
+
+void ScenePool::release(Node *p_node) {
+	ERR_FAIL_NULL(p_node);
+	ERR_FAIL_COND_MSG(scene.is_null(), "ScenePool has no scene to recycle instances of.");
+	ERR_FAIL_COND_MSG(p_node->is_queued_for_deletion(), "Can't release a node that is queued for deletion.");
+	ERR_FAIL_COND_MSG(!scene->is_built_in() && p_node->get_scene_file_path() != scene->get_path(), vformat("Node \"%s\" was not instantiated from \"%s\".", p_node->get_name(), scene->get_path()));
+	{
+		MutexLock lock(mutex);
+		ERR_FAIL_COND_MSG(available.has(p_node), vformat("Node \"%s\" was already released to the pool.", p_node->get_name()));
+	}
+
+	Node *parent = p_node->get_parent();
+	if (parent) {
+		parent->remove_child(p_node);
+	}
+
+	if (!reset_state_built) {
+		_build_reset_state();
+	}
+
+	if (!_reset(p_node)) {
+		memdelete(p_node);
+		return;
+	}
+
+	_store(p_node);
+}
+
+void ScenePool::prewarm(int p_count) {
+	ERR_FAIL_COND_MSG(scene.is_null(), "ScenePool has no scene to instantiate.");
+	ERR_FAIL_COND(p_count < 0);
+
+	bool start = false;
+	{
+		MutexLock lock(mutex);
+		prewarm_pending += p_count;
+		if (max_size > 0) {
+			prewarm_pending = MIN(prewarm_pending, MAX(max_size - (int)available.size(), 0));
+		}
+		if (prewarm_pending > 0 && !prewarm_running) {
+			prewarm_running = true;
+			start = true;
+		}
+	}
+
+	if (start) {
+		// A previous run may still be returning, it has to be waited on before starting another one.
+		if (prewarm_task != WorkerThreadPool::INVALID_TASK_ID) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(prewarm_task);
+		}
+		prewarm_task = WorkerThreadPool::get_singleton()->add_native_task(&ScenePool::_prewarm_func, this, false, "Prewarm ScenePool");
+	}
+}
+
+bool ScenePool::is_prewarming() const {
+	MutexLock lock(mutex);
+	return prewarm_running;
+}
+
+void ScenePool::wait_for_prewarm() {
+	if (prewarm_task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(prewarm_task);
+		prewarm_task = WorkerThreadPool::INVALID_TASK_ID;
+	}
+}
+
+int ScenePool::get_available_count() const {
+	MutexLock lock(mutex);
+	return available.size();
+}
+
+void ScenePool::clear() {
+	{
+		MutexLock lock(mutex);
+		prewarm_pending = 0;
+	}
+	wait_for_prewarm();
+
+	LocalVector<Node *> to_free;
+	{
+		MutexLock lock(mutex);
+		to_free = available;
+		available.clear();
+	}
+
+	for (Node *node : to_free) {
+		memdelete(node);
+	}
+}
+
+void ScenePool::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_scene", "scene"), &ScenePool::set_scene);
+	ClassDB::bind_method(D_METHOD("get_scene"), &ScenePool::get_scene);
+	ClassDB::bind_method(D_METHOD("set_max_size", "max_size"), &ScenePool::set_max_size);
+	ClassDB::bind_method(D_METHOD("get_max_size"), &ScenePool::get_max_size);
+
+	ClassDB::bind_method(D_METHOD("acquire"), &ScenePool::acquire);
+	ClassDB::bind_method(D_METHOD("release", "node"), &ScenePool::release);
+	ClassDB::bind_method(D_METHOD("prewarm", "count"), &ScenePool::prewarm);
+	ClassDB::bind_method(D_METHOD("is_prewarming"), &ScenePool::is_prewarming);
+	ClassDB::bind_method(D_METHOD("wait_for_prewarm"), &ScenePool::wait_for_prewarm);
+	ClassDB::bind_method(D_METHOD("get_available_count"), &ScenePool::get_available_count);
+	ClassDB::bind_method(D_METHOD("clear"), &ScenePool::clear);
+
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "scene", PROPERTY_HINT_RESOURCE_TYPE, "PackedScene"), "set_scene", "get_scene");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_size", PROPERTY_HINT_RANGE, "0,4096,1,or_greater"), "set_max_size", "get_max_size");
+}
+
+ScenePool::ScenePool() {
+}
+
+ScenePool::~ScenePool() {
+	clear();
+}
@@ -0,0 +1,91 @@
+/**************************************************************************/
+/*  scene_pool.h                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SCENE_POOL_H
+#define SCENE_POOL_H
+
+#include "core/object/worker_thread_pool.h"
+#include "scene/resources/packed_scene.h"
+
+class ScenePool : public RefCounted {
+	GDCLASS(ScenePool, RefCounted);
+
+	// Properties restored on every node stored in the scene when an instance is released,
+	// captured from a freshly instantiated copy. Signal connections and groups are not tracked.
+	struct NodeReset {
+		NodePath path;
+		LocalVector<Pair<StringName, Variant>> properties;
+		LocalVector<StringName> meta;
+		int child_count = 0;
+	};
+
+	Ref<PackedScene> scene;
+	int max_size = 0;
+
+	mutable Mutex mutex;
+	LocalVector<Node *> available;
+	LocalVector<NodeReset> reset_state;
+	bool reset_state_built = false;
+
+	WorkerThreadPool::TaskID prewarm_task = WorkerThreadPool::INVALID_TASK_ID;
+	int prewarm_pending = 0;
+	bool prewarm_running = false;
+
+	static void _prewarm_func(void *p_userdata);
+	void _prewarm();
+	void _build_reset_state();
+	bool _reset(Node *p_node) const;
+	void _store(Node *p_node);
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_scene(const Ref<PackedScene> &p_scene);
+	Ref<PackedScene> get_scene() const;
+
+	void set_max_size(int p_max_size);
+	int get_max_size() const;
+
+	Node *acquire();
+	void release(Node *p_node);
+
+	void prewarm(int p_count);
+	bool is_prewarming() const;
+	void wait_for_prewarm();
+
+	int get_available_count() const;
+	void clear();
+
+	ScenePool();
+	~ScenePool();
+};
+
+#endif // SCENE_POOL_H
@@ -98,6 +98,7 @@
 #include "scene/main/missing_node.h"
 #include "scene/main/multiplayer_api.h"
 #include "scene/main/resource_preloader.h"
+#include "scene/main/scene_pool.h"
 #include "scene/main/scene_tree.h"
 #include "scene/main/shader_globals_override.h"
 #include "scene/main/status_indicator.h"
@@ -331,6 +332,14 @@ void register_scene_types() {
 	resource_loader_stream_texture.instantiate();
 	ResourceLoader::add_resource_format_loader(resource_loader_stream_texture);
 
+	GLOBAL_DEF("rendering/textures/streaming/enabled", false);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "rendering/textures/streaming/initial_size", PROPERTY_HINT_RANGE, "1,4096,1,or_greater"), 64);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "rendering/textures/streaming/memory_budget_mb", PROPERTY_HINT_RANGE, "0,16384,1,or_greater,suffix:MiB"), 512);
+	// The editor always works with full resolution textures.
+	CompressedTexture2D::set_streaming_enabled(GLOBAL_GET("rendering/textures/streaming/enabled") && !Engine::get_singleton()->is_editor_hint());
+	CompressedTexture2D::set_streaming_initial_size(GLOBAL_GET("rendering/textures/streaming/initial_size"));
+	CompressedTexture2D::set_streaming_budget(uint64_t(int(GLOBAL_GET("rendering/textures/streaming/memory_budget_mb"))) << 20);
+
 	resource_loader_texture_layered.instantiate();
 	ResourceLoader::add_resource_format_loader(resource_loader_texture_layered);
 
@@ -1018,6 +1027,7 @@ void register_scene_types() {
 
 	GDREGISTER_ABSTRACT_CLASS(SceneState);
 	GDREGISTER_CLASS(PackedScene);
+	GDREGISTER_CLASS(ScenePool);
 
 	GDREGISTER_CLASS(SceneTree);
 	GDREGISTER_ABSTRACT_CLASS(SceneTreeTimer); // sorry, you can't create it
@@ -32,7 +32,14 @@
 
 #include "scene/resources/bit_map.h"
 
-Error CompressedTexture2D::_load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit) {
+bool CompressedTexture2D::streaming_enabled = false;
+int CompressedTexture2D::streaming_initial_size = 64;
+uint64_t CompressedTexture2D::streaming_budget = 0;
+uint64_t CompressedTexture2D::streaming_resident_bytes = 0;
+SelfList<CompressedTexture2D>::List CompressedTexture2D::streaming_lru;
+Mutex CompressedTexture2D::streaming_mutex;
+
+Error CompressedTexture2D::_load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit, int *r_full_size) {
 	alpha_cache.unref();
 
 	ERR_FAIL_COND_V(image.is_null(), ERR_INVALID_PARAMETER);
@@ -75,11 +82,11 @@ Error CompressedTexture2D::_load_data(const String &p_path, int &r_width, int &r
 	r_request_normal = false;
 
 #endif
-	if (!(df & FORMAT_BIT_STREAM)) {
+	if (!(df & FORMAT_BIT_STREAM) && !streaming_enabled) {
 		p_size_limit = 0;
 	}
 
-	image = load_image_from_file(f, p_size_limit);
+	image = load_image_from_file(f, p_size_limit, r_full_size);
 
 	if (image.is_null() || image->is_empty()) {
 		return ERR_CANT_OPEN;
@@ -88,6 +95,126 @@ Error CompressedTexture2D::_load_data(const String &p_path, int &r_width, int &r
 	return OK;
 }
 
+void CompressedTexture2D::_update_streaming(const Ref<Image> &p_image, int p_full_size) {
+	MutexLock lock(streaming_mutex);
+
+	streaming_resident_bytes -= streaming_bytes;
+	streaming_full_size = p_full_size;
+	streaming_size = MAX(p_image->get_width(), p_image->get_height());
+	streaming_bytes = p_image->get_data().size();
+	streaming_resident_bytes += streaming_bytes;
+
+	// Most recently requested last, eviction starts from the front.
+	if (streaming_element.in_list()) {
+		streaming_lru.remove(&streaming_element);
+	}
+	streaming_lru.add_last(&streaming_element);
+}
+
+void CompressedTexture2D::_clear_streaming() {
+	MutexLock lock(streaming_mutex);
+
+	if (streaming_element.in_list()) {
+		streaming_lru.remove(&streaming_element);
+		streaming_resident_bytes -= streaming_bytes;
+	}
+	streaming_full_size = 0;
+	streaming_size = 0;
+	streaming_bytes = 0;
+}
+
+Error CompressedTexture2D::_stream_to_size(int p_size_limit) {
+	int lw, lh;
+	bool request_3d;
+	bool request_normal;
+	bool request_roughness;
+	int mipmap_limit;
+	int full_size = 0;
+
+	Ref<Image> image;
+	image.instantiate();
+	Error err = _load_data(path_to_file, lw, lh, image, request_3d, request_normal, request_roughness, mipmap_limit, p_size_limit, &full_size);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Unable to stream mipmaps from file: %s.", path_to_file));
+
+	RID new_texture = RS::get_singleton()->texture_2d_create(image);
+	RS::get_singleton()->texture_replace(texture, new_texture);
+	if (lw || lh) {
+		RS::get_singleton()->texture_set_size_override(texture, lw, lh);
+	}
+
+	_update_streaming(image, full_size);
+	return OK;
+}
+
+void CompressedTexture2D::_enforce_streaming_budget(const CompressedTexture2D *p_except) {
+	while (true) {
+		Ref<CompressedTexture2D> victim;
+		{
+			MutexLock lock(streaming_mutex);
+			if (streaming_budget == 0 || streaming_resident_bytes <= streaming_budget) {
+				return;
+			}
+
+			for (SelfList<CompressedTexture2D> *E = streaming_lru.first(); E; E = E->next()) {
+				CompressedTexture2D *tex = E->self();
+				if (tex == p_except || tex->streaming_size <= streaming_initial_size) {
+					continue;
+				}
+				victim = Ref<CompressedTexture2D>(tex); // Stays null if it's already being freed.
+				if (victim.is_valid()) {
+					break;
+				}
+			}
+		}
+
+		if (victim.is_null() || victim->_stream_to_size(streaming_initial_size) != OK) {
+			return; // Nothing else can be dropped.
+		}
+	}
+}
+
+uint64_t CompressedTexture2D::get_streaming_resident_bytes() {
+	MutexLock lock(streaming_mutex);
+	return streaming_resident_bytes;
+}
+
+bool CompressedTexture2D::is_streaming() const {
+	MutexLock lock(streaming_mutex);
+	return streaming_element.in_list();
+}
+
+int CompressedTexture2D::get_streaming_size() const {
+	MutexLock lock(streaming_mutex);
+	return streaming_element.in_list() ? streaming_size : MAX(w, h);
+}
+
+void CompressedTexture2D::request_streaming_size(int p_size) {
+	ERR_FAIL_COND(p_size < 0);
+
+	int full_size;
+	{
+		MutexLock lock(streaming_mutex);
+		if (!streaming_element.in_list()) {
+			return; // Fully loaded already.
+		}
+
+		streaming_lru.remove(&streaming_element);
+		streaming_lru.add_last(&streaming_element);
+		if (p_size <= streaming_size || streaming_size >= streaming_full_size) {
+			return;
+		}
+		full_size = streaming_full_size;
+	}
+
+	int size_limit = next_power_of_2((uint32_t)p_size);
+	if (size_limit >= full_size) {
+		size_limit = 0;
+	}
+	if (_stream_to_size(size_limit) == OK) {
+		_enforce_streaming_budget(this);
+	}
+}
+
 void CompressedTexture2D::set_path(const String &p_path, bool p_take_over) {
 	if (texture.is_valid()) {
 		RenderingServer::get_singleton()->texture_set_path(texture, p_path);
@@ -134,8 +261,9 @@ Error CompressedTexture2D::load(const String &p_path) {
 	bool request_normal;
 	bool request_roughness;
 	int mipmap_limit;
+	int full_size = 0;
 
-	Error err = _load_data(p_path, lw, lh, image, request_3d, request_normal, request_roughness, mipmap_limit);
+	Error err = _load_data(p_path, lw, lh, image, request_3d, request_normal, request_roughness, mipmap_limit, streaming_enabled ? streaming_initial_size : 0, &full_size);
 	if (err) {
 		return err;
 	}
@@ -155,6 +283,11 @@ Error CompressedTexture2D::load(const String &p_path) {
 	path_to_file = p_path;
 	format = image->get_format();
 
+	_clear_streaming();
+	if (full_size > MAX(image->get_width(), image->get_height())) {
+		_update_streaming(image, full_size);
+	}
+
 	if (get_path().is_empty()) {
 		//temporarily set path if no path set for resource, helps find errors
 		RenderingServer::get_singleton()->texture_set_path(texture, p_path);
@@ -296,13 +429,30 @@ void CompressedTexture2D::reload_from_file() {
 void CompressedTexture2D::_validate_property(PropertyInfo &p_property) const {
 }
 
-Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_size_limit) {
+uint64_t CompressedTexture2D::_get_memory_usage_estimate(HashSet<const Resource *> &r_visited) const {
+	{
+		MutexLock lock(streaming_mutex);
+		if (streaming_bytes > 0) {
+			return sizeof(CompressedTexture2D) + streaming_bytes;
+		}
+	}
+	return sizeof(CompressedTexture2D) + Image::get_image_data_size(w, h, format, false);
+}
+
+Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_size_limit, int *r_full_size) {
 	uint32_t data_format = f->get_32();
 	uint32_t w = f->get_16();
 	uint32_t h = f->get_16();
 	uint32_t mipmaps = f->get_32();
 	Image::Format format = Image::Format(f->get_32());
 
+	if (r_full_size) {
+		*r_full_size = MAX(w, h);
+	}
+	if (data_format != DATA_FORMAT_IMAGE) {
+		p_size_limit = 0; // Only raw image data can skip mipmaps.
+	}
+
 	if (data_format == DATA_FORMAT_PNG || data_format == DATA_FORMAT_WEBP) {
 		//look for a PNG or WebP file inside
 
@@ -421,18 +571,20 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 		return img;
 	} else if (data_format == DATA_FORMAT_IMAGE) {
 		int size = Image::get_image_data_size(w, h, format, mipmaps ? true : false);
+		uint64_t data_start = f->get_position();
 
 		for (uint32_t i = 0; i < mipmaps + 1; i++) {
 			int tw, th;
 			int ofs = Image::get_image_mipmap_offset_and_dimensions(w, h, format, i, tw, th);
 
-			if (p_size_limit > 0 && i < mipmaps && (p_size_limit > tw || p_size_limit > th)) {
-				if (ofs) {
-					f->seek(f->get_position() + ofs);
-				}
+			if (p_size_limit > 0 && i < mipmaps && (tw > p_size_limit || th > p_size_limit)) {
 				continue; //oops, size limit enforced, go to next
 			}
 
+			if (ofs) {
+				f->seek(data_start + ofs);
+			}
+
 			Vector<uint8_t> data;
 			data.resize(size - ofs);
 
@@ -453,13 +605,18 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 void CompressedTexture2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("load", "path"), &CompressedTexture2D::load);
 	ClassDB::bind_method(D_METHOD("get_load_path"), &CompressedTexture2D::get_load_path);
+	ClassDB::bind_method(D_METHOD("is_streaming"), &CompressedTexture2D::is_streaming);
+	ClassDB::bind_method(D_METHOD("get_streaming_size"), &CompressedTexture2D::get_streaming_size);
+	ClassDB::bind_method(D_METHOD("request_streaming_size", "size"), &CompressedTexture2D::request_streaming_size);
 
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "load_path", PROPERTY_HINT_FILE, "*.ctex"), "load", "get_load_path");
 }
 
-CompressedTexture2D::CompressedTexture2D() {}
+CompressedTexture2D::CompressedTexture2D() :
+		streaming_element(this) {}
 
 CompressedTexture2D::~CompressedTexture2D() {
+	_clear_streaming();
 	if (texture.is_valid()) {
 		ERR_FAIL_NULL(RenderingServer::get_singleton());
 		RS::get_singleton()->free(texture);
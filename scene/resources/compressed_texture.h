@@ -31,6 +31,7 @@
 #ifndef COMPRESSED_TEXTURE_H
 #define COMPRESSED_TEXTURE_H
 
+#include "core/templates/self_list.h"
 #include "scene/resources/texture.h"
 
 class BitMap;
@@ -67,7 +68,27 @@ private:
 	int h = 0;
 	mutable Ref<BitMap> alpha_cache;
 
-	Error _load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit = 0);
+	// Mip streaming: when enabled, mipmapped textures first load only the mips that fit in the
+	// initial size, and higher ones once requested. Upgraded textures are kept in an LRU list,
+	// and the least recently requested ones drop back to the initial size when over budget.
+	static bool streaming_enabled;
+	static int streaming_initial_size;
+	static uint64_t streaming_budget;
+	static uint64_t streaming_resident_bytes;
+	static SelfList<CompressedTexture2D>::List streaming_lru;
+	static Mutex streaming_mutex;
+
+	SelfList<CompressedTexture2D> streaming_element;
+	int streaming_full_size = 0; // Largest side of the full size mip.
+	int streaming_size = 0; // Largest side of the highest mip currently loaded.
+	uint64_t streaming_bytes = 0;
+
+	void _update_streaming(const Ref<Image> &p_image, int p_full_size);
+	void _clear_streaming();
+	Error _stream_to_size(int p_size_limit);
+	static void _enforce_streaming_budget(const CompressedTexture2D *p_except);
+
+	Error _load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit = 0, int *r_full_size = nullptr);
 	virtual void reload_from_file() override;
 
 	static void _requested_3d(void *p_ud);
@@ -78,8 +99,18 @@ protected:
 	static void _bind_methods();
 	void _validate_property(PropertyInfo &p_property) const;
 
+	virtual uint64_t _get_memory_usage_estimate(HashSet<const Resource *> &r_visited) const override;
+
 public:
-	static Ref<Image> load_image_from_file(Ref<FileAccess> p_file, int p_size_limit);
+	static Ref<Image> load_image_from_file(Ref<FileAccess> p_file, int p_size_limit, int *r_full_size = nullptr);
+
+	static void set_streaming_enabled(bool p_enabled) { streaming_enabled = p_enabled; }
+	static bool is_streaming_enabled() { return streaming_enabled; }
+	static void set_streaming_initial_size(int p_size) { streaming_initial_size = MAX(p_size, 1); }
+	static int get_streaming_initial_size() { return streaming_initial_size; }
+	static void set_streaming_budget(uint64_t p_bytes) { streaming_budget = p_bytes; }
+	static uint64_t get_streaming_budget() { return streaming_budget; }
+	static uint64_t get_streaming_resident_bytes();
 
 	typedef void (*TextureFormatRequestCallback)(const Ref<CompressedTexture2D> &);
 	typedef void (*TextureFormatRoughnessRequestCallback)(const Ref<CompressedTexture2D> &, const String &p_normal_path, RS::TextureDetectRoughnessChannel p_roughness_channel);
@@ -107,6 +138,10 @@ public:
 
 	virtual Ref<Image> get_image() const override;
 
+	bool is_streaming() const;
+	int get_streaming_size() const;
+	void request_streaming_size(int p_size);
+
 	CompressedTexture2D();
 	~CompressedTexture2D();
 };
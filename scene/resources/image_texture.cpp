@@ -72,6 +72,11 @@ void ImageTexture::_get_property_list(List<PropertyInfo> *p_list) const {
 	p_list->push_back(PropertyInfo(Variant::OBJECT, PNAME("image"), PROPERTY_HINT_RESOURCE_TYPE, "Image", PROPERTY_USAGE_STORAGE | PROPERTY_USAGE_RESOURCE_NOT_PERSISTENT));
 }
 
+uint64_t ImageTexture::_get_memory_usage_estimate(HashSet<const Resource *> &r_visited) const {
+	// The image lives in the RenderingServer, reading it back just to measure it would be wasteful.
+	return sizeof(ImageTexture) + Image::get_image_data_size(w, h, format, mipmaps);
+}
+
 Ref<ImageTexture> ImageTexture::create_from_image(const Ref<Image> &p_image) {
 	ERR_FAIL_COND_V_MSG(p_image.is_null(), Ref<ImageTexture>(), "Invalid image: null");
 	ERR_FAIL_COND_V_MSG(p_image->is_empty(), Ref<ImageTexture>(), "Invalid image: image is empty");
@@ -286,6 +291,10 @@ TypedArray<Image> ImageTextureLayered::_get_images() const {
 	return images;
 }
 
+uint64_t ImageTextureLayered::_get_memory_usage_estimate(HashSet<const Resource *> &r_visited) const {
+	return sizeof(ImageTextureLayered) + uint64_t(layers) * Image::get_image_data_size(width, height, format, mipmaps);
+}
+
 void ImageTextureLayered::_set_images(const TypedArray<Image> &p_images) {
 	ERR_FAIL_COND(_create_from_images(p_images) != OK);
 }
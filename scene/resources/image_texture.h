@@ -55,6 +55,8 @@ protected:
 	bool _get(const StringName &p_name, Variant &r_ret) const;
 	void _get_property_list(List<PropertyInfo> *p_list) const;
 
+	virtual uint64_t _get_memory_usage_estimate(HashSet<const Resource *> &r_visited) const override;
+
 	static void _bind_methods();
 
 public:
@@ -105,6 +107,8 @@ class ImageTextureLayered : public TextureLayered {
 	void _set_images(const TypedArray<Image> &p_images);
 
 protected:
+	virtual uint64_t _get_memory_usage_estimate(HashSet<const Resource *> &r_visited) const override;
+
 	static void _bind_methods();
 
 public:
@@ -1749,6 +1749,28 @@ void ArrayMesh::_get_property_list(List<PropertyInfo> *p_list) const {
 	}
 }
 
+uint64_t ArrayMesh::_get_memory_usage_estimate(HashSet<const Resource *> &r_visited) const {
+	if (r_visited.has(this)) {
+		return 0;
+	}
+	r_visited.insert(this);
+
+	// Surface data lives in the RenderingServer, so size it from the format instead of reading it back.
+	uint64_t size = sizeof(ArrayMesh);
+	const RenderingServer *rs = RenderingServer::get_singleton();
+	for (const Surface &surface : surfaces) {
+		uint64_t vertex_size = rs->mesh_surface_get_format_vertex_stride(surface.format, surface.array_length) + rs->mesh_surface_get_format_normal_tangent_stride(surface.format, surface.array_length);
+		uint64_t stride = vertex_size + rs->mesh_surface_get_format_attribute_stride(surface.format, surface.array_length) + rs->mesh_surface_get_format_skin_stride(surface.format, surface.array_length);
+		size += stride * surface.array_length;
+		size += vertex_size * surface.array_length * blend_shapes.size();
+		size += uint64_t(surface.index_array_length) * (surface.array_length <= (1 << 16) ? 2 : 4);
+		size += _estimate_variant_size(surface.material, r_visited);
+	}
+	size += _estimate_variant_size(shadow_mesh, r_visited);
+
+	return size;
+}
+
 void ArrayMesh::_recompute_aabb() {
 	// regenerate AABB
 	aabb = AABB();
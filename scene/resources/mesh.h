@@ -334,6 +334,8 @@ protected:
 	void _get_property_list(List<PropertyInfo> *p_list) const;
 	bool surface_index_0 = false;
 
+	virtual uint64_t _get_memory_usage_estimate(HashSet<const Resource *> &r_visited) const override;
+
 	virtual void reset_state() override;
 
 	static void _bind_methods();
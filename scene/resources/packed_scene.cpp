@@ -75,6 +75,24 @@ static Array _sanitize_node_pinned_properties(Node *p_node) {
 	return pinned;
 }
 
+static void _set_script_keeping_state(Node *p_node, const Variant &p_script) {
+	//work around to avoid old script variables from disappearing, should be the proper fix to:
+	//https://github.com/godotengine/godot/issues/2958
+
+	//store old state
+	List<Pair<StringName, Variant>> old_state;
+	if (p_node->get_script_instance()) {
+		p_node->get_script_instance()->get_property_state(old_state);
+	}
+
+	p_node->set(CoreStringName(script), p_script);
+
+	//restore old state for new script, if exists
+	for (const Pair<StringName, Variant> &E : old_state) {
+		p_node->set(E.first, E.second);
+	}
+}
+
 Ref<Resource> SceneState::get_remap_resource(const Ref<Resource> &p_resource, HashMap<Ref<Resource>, Ref<Resource>> &remap_cache, const Ref<Resource> &p_fallback, Node *p_for_scene) {
 	ERR_FAIL_COND_V(p_resource.is_null(), Ref<Resource>());
 
@@ -124,7 +142,38 @@ Ref<Resource> SceneState::get_remap_resource(const Ref<Resource> &p_resource, Ha
 	return remap_resource;
 }
 
+void SceneState::_resolve_deferred_node_paths(const LocalVector<DeferredNodePathProperties> &p_deferred_node_paths) {
+	for (const DeferredNodePathProperties &dnp : p_deferred_node_paths) {
+		// Replace properties stored as NodePaths with actual Nodes.
+		if (dnp.value.get_type() == Variant::ARRAY) {
+			Array paths = dnp.value;
+
+			bool valid;
+			Array array = dnp.base->get(dnp.property, &valid);
+			ERR_CONTINUE(!valid);
+			array = array.duplicate();
+
+			array.resize(paths.size());
+			for (int i = 0; i < array.size(); i++) {
+				array.set(i, dnp.base->get_node_or_null(paths[i]));
+			}
+			dnp.base->set(dnp.property, array);
+		} else {
+			dnp.base->set(dnp.property, dnp.base->get_node_or_null(dnp.value));
+		}
+	}
+}
+
 Node *SceneState::instantiate(GenEditState p_edit_state) const {
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED && instantiation_plans_enabled && !Engine::get_singleton()->is_editor_hint()) {
+		InstantiationPlan *plan = _ref_instantiation_plan();
+		if (plan) {
+			Node *node = _instantiate_from_plan(*plan);
+			_unref_instantiation_plan(plan);
+			return node;
+		}
+	}
+
 	// Nodes where instantiation failed (because something is missing.)
 	List<Node *> stray_instances;
 
@@ -338,21 +387,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 					ERR_FAIL_INDEX_V(nprops[j].name, sname_count, nullptr);
 
 					if (snames[nprops[j].name] == CoreStringName(script)) {
-						//work around to avoid old script variables from disappearing, should be the proper fix to:
-						//https://github.com/godotengine/godot/issues/2958
-
-						//store old state
-						List<Pair<StringName, Variant>> old_state;
-						if (node->get_script_instance()) {
-							node->get_script_instance()->get_property_state(old_state);
-						}
-
-						node->set(snames[nprops[j].name], props[nprops[j].value], &valid);
-
-						//restore old state for new script, if exists
-						for (const Pair<StringName, Variant> &E : old_state) {
-							node->set(E.first, E.second);
-						}
+						_set_script_keeping_state(node, props[nprops[j].value]);
 					} else {
 						Variant value = props[nprops[j].value];
 
@@ -524,25 +559,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 		}
 	}
 
-	for (const DeferredNodePathProperties &dnp : deferred_node_paths) {
-		// Replace properties stored as NodePaths with actual Nodes.
-		if (dnp.value.get_type() == Variant::ARRAY) {
-			Array paths = dnp.value;
-
-			bool valid;
-			Array array = dnp.base->get(dnp.property, &valid);
-			ERR_CONTINUE(!valid);
-			array = array.duplicate();
-
-			array.resize(paths.size());
-			for (int i = 0; i < array.size(); i++) {
-				array.set(i, dnp.base->get_node_or_null(paths[i]));
-			}
-			dnp.base->set(dnp.property, array);
-		} else {
-			dnp.base->set(dnp.property, dnp.base->get_node_or_null(dnp.value));
-		}
-	}
+	_resolve_deferred_node_paths(deferred_node_paths);
 
 	for (KeyValue<Ref<Resource>, Ref<Resource>> &E : resources_local_to_scene) {
 		if (E.value->get_local_scene() == ret_nodes[0]) {
@@ -607,6 +624,423 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 	return ret_nodes[0];
 }
 
+static bool _is_plan_value_supported(const Variant &p_value) {
+	// Resources local to scene need duplicating per instance, and missing ones need recording
+	// as metadata. Both are left to the generic path.
+	switch (p_value.get_type()) {
+		case Variant::OBJECT: {
+			Ref<Resource> res = p_value;
+			return res.is_null() || (!res->is_local_to_scene() && !Object::cast_to<MissingResource>(res.ptr()));
+		}
+		case Variant::ARRAY: {
+			Array array = p_value;
+			for (int i = 0; i < array.size(); i++) {
+				Ref<Resource> res = array[i];
+				if (res.is_valid() && res->is_local_to_scene()) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case Variant::DICTIONARY: {
+			Dictionary dictionary = p_value;
+			for (const Variant &key : dictionary.keys()) {
+				Ref<Resource> key_res = key;
+				Ref<Resource> value_res = dictionary[key];
+				if ((key_res.is_valid() && key_res->is_local_to_scene()) || (value_res.is_valid() && value_res->is_local_to_scene())) {
+					return false;
+				}
+			}
+			return true;
+		}
+		default: {
+			return true;
+		}
+	}
+}
+
+bool SceneState::_compile_instantiation_plan(InstantiationPlan &r_plan) const {
+	int nc = nodes.size();
+	if (nc == 0 || base_scene_idx >= 0) {
+		return false;
+	}
+
+	const int sname_count = names.size();
+	const int prop_count = variants.size();
+	const StringName pinned_properties_name = "metadata/_edit_pinned_properties_";
+
+	r_plan.nodes.resize(nc);
+
+	for (int i = 0; i < nc; i++) {
+		const NodeData &n = nodes[i];
+		InstantiationPlan::NodeEntry &entry = r_plan.nodes[i];
+
+		if (n.name < 0 || n.name >= sname_count) {
+			return false;
+		}
+		entry.name = n.name;
+		entry.index = n.index;
+
+		// Parents and owners given as paths point inside sub-scenes, which may have changed.
+		if (i > 0) {
+			if (n.parent < 0 || (n.parent & FLAG_ID_IS_PATH) || n.parent >= i) {
+				return false;
+			}
+			entry.parent = n.parent;
+			r_plan.nodes[n.parent].child_count++;
+		} else if (n.parent != -1) {
+			return false;
+		}
+
+		if (n.owner >= 0) {
+			if ((n.owner & FLAG_ID_IS_PATH) || n.owner >= i) {
+				return false;
+			}
+			entry.owner = n.owner;
+		}
+
+		bool native = false;
+		if (n.instance >= 0) {
+			if (n.instance & FLAG_INSTANCE_IS_PLACEHOLDER) {
+				return false;
+			}
+			if ((n.instance & FLAG_MASK) >= prop_count) {
+				return false;
+			}
+			entry.instance = variants[n.instance & FLAG_MASK];
+			if (entry.instance.is_null()) {
+				return false;
+			}
+		} else if (n.type != TYPE_INSTANTIATED) {
+			if (n.type < 0 || n.type >= sname_count) {
+				return false;
+			}
+			const StringName &type = names[n.type];
+			if (!ClassDB::class_exists(type) || !ClassDB::can_instantiate(type) || !ClassDB::is_parent_class(type, SNAME("Node"))) {
+				return false;
+			}
+			entry.type = n.type;
+			entry.creation_func = ClassDB::get_native_creation_func(type);
+			native = entry.creation_func != nullptr;
+		}
+		entry.add_to_parent = n.instance >= 0 || n.type != TYPE_INSTANTIATED || i == 0;
+
+		// Once a script is set, it may handle any of the properties that follow.
+		for (const NodeData::Property &prop : n.properties) {
+			if (!(prop.name & FLAG_PATH_PROPERTY_IS_NODE) && prop.name < sname_count && names[prop.name] == CoreStringName(script)) {
+				native = false;
+				break;
+			}
+		}
+
+		entry.property_from = r_plan.properties.size();
+		for (const NodeData::Property &prop : n.properties) {
+			if (prop.value < 0 || prop.value >= prop_count) {
+				return false;
+			}
+
+			InstantiationPlan::Property plan_prop;
+			plan_prop.value = prop.value;
+
+			if (prop.name & FLAG_PATH_PROPERTY_IS_NODE) {
+				plan_prop.name = prop.name & FLAG_PROP_NAME_MASK;
+				if (plan_prop.name >= sname_count) {
+					return false;
+				}
+				plan_prop.kind = InstantiationPlan::PROPERTY_NODE_PATH;
+				r_plan.properties.push_back(plan_prop);
+				continue;
+			}
+
+			if (prop.name < 0 || prop.name >= sname_count) {
+				return false;
+			}
+			plan_prop.name = prop.name;
+
+			const StringName &pname = names[prop.name];
+			const Variant &value = variants[prop.value];
+			if (!_is_plan_value_supported(value)) {
+				return false;
+			}
+
+			if (pname == CoreStringName(script)) {
+				plan_prop.kind = InstantiationPlan::PROPERTY_SCRIPT;
+			} else if (value.get_type() == Variant::ARRAY) {
+				plan_prop.kind = InstantiationPlan::PROPERTY_ARRAY;
+			} else if (native) {
+				bool is_property = false;
+				plan_prop.index = ClassDB::get_property_index(names[n.type], pname, &is_property);
+				if (is_property) {
+					StringName setter = ClassDB::get_property_setter(names[n.type], pname);
+					if (setter == StringName()) {
+						plan_prop.kind = InstantiationPlan::PROPERTY_READ_ONLY;
+					} else {
+						plan_prop.setter = ClassDB::get_method(names[n.type], setter);
+						plan_prop.kind = plan_prop.setter ? InstantiationPlan::PROPERTY_SETTER : InstantiationPlan::PROPERTY_SET;
+					}
+				}
+			}
+
+			if (pname == pinned_properties_name) {
+				entry.remove_pinned_properties = true;
+			}
+			r_plan.properties.push_back(plan_prop);
+		}
+		entry.property_count = r_plan.properties.size() - entry.property_from;
+
+		entry.group_from = r_plan.groups.size();
+		for (int group : n.groups) {
+			if (group < 0 || group >= sname_count) {
+				return false;
+			}
+			r_plan.groups.push_back(group);
+		}
+		entry.group_count = n.groups.size();
+	}
+
+	for (const ConnectionData &c : connections) {
+		if (c.signal < 0 || c.signal >= sname_count || c.method < 0 || c.method >= sname_count) {
+			return false;
+		}
+		if ((!(c.from & FLAG_ID_IS_PATH) && c.from >= nc) || (!(c.to & FLAG_ID_IS_PATH) && c.to >= nc)) {
+			return false;
+		}
+
+		InstantiationPlan::Connection plan_conn;
+		plan_conn.from = c.from;
+		plan_conn.to = c.to;
+		plan_conn.signal = c.signal;
+		plan_conn.method = c.method;
+		plan_conn.flags = c.flags;
+		plan_conn.unbinds = c.unbinds;
+		if (c.unbinds <= 0) {
+			for (int bind : c.binds) {
+				if (bind < 0 || bind >= prop_count) {
+					return false;
+				}
+				plan_conn.binds.push_back(variants[bind]);
+			}
+		}
+		r_plan.connections.push_back(plan_conn);
+	}
+
+	return true;
+}
+
+SceneState::InstantiationPlan *SceneState::_ref_instantiation_plan() const {
+	MutexLock lock(instantiation_plan_mutex);
+	if (!instantiation_plan_compiled) {
+		instantiation_plan_compiled = true;
+		instantiation_plan = memnew(InstantiationPlan);
+		instantiation_plan->refcount.init(); // Owned by this state until cleared.
+		if (!_compile_instantiation_plan(*instantiation_plan)) {
+			memdelete(instantiation_plan);
+			instantiation_plan = nullptr;
+		}
+	}
+	if (instantiation_plan) {
+		instantiation_plan->refcount.ref();
+	}
+	return instantiation_plan;
+}
+
+void SceneState::_unref_instantiation_plan(InstantiationPlan *p_plan) {
+	if (p_plan->refcount.unref()) {
+		memdelete(p_plan);
+	}
+}
+
+void SceneState::_clear_instantiation_plan() {
+	MutexLock lock(instantiation_plan_mutex);
+	if (instantiation_plan) {
+		_unref_instantiation_plan(instantiation_plan);
+		instantiation_plan = nullptr;
+	}
+	instantiation_plan_compiled = false;
+}
+
+bool SceneState::has_instantiation_plan() const {
+	InstantiationPlan *plan = _ref_instantiation_plan();
+	if (!plan) {
+		return false;
+	}
+	_unref_instantiation_plan(plan);
+	return true;
+}
+
+Node *SceneState::_instantiate_from_plan(const InstantiationPlan &p_plan) const {
+	// Nodes where instantiation failed (because something is missing.)
+	List<Node *> stray_instances;
+
+	const int nc = p_plan.nodes.size();
+	const StringName *snames = names.ptr();
+	const Variant *props = variants.ptr();
+	const InstantiationPlan::Property *plan_props = p_plan.properties.ptr();
+
+	Node **ret_nodes = (Node **)alloca(sizeof(Node *) * nc);
+
+	LocalVector<DeferredNodePathProperties> deferred_node_paths;
+
+	for (int i = 0; i < nc; i++) {
+		const InstantiationPlan::NodeEntry &entry = p_plan.nodes[i];
+		Node *parent = i > 0 ? ret_nodes[entry.parent] : nullptr;
+
+		Node *node = nullptr;
+		if (entry.instance.is_valid()) {
+			node = entry.instance->instantiate(PackedScene::GEN_EDIT_STATE_DISABLED);
+			ERR_FAIL_NULL_V_MSG(node, nullptr, vformat("Failed to load scene dependency: \"%s\". Make sure the required scene is valid.", entry.instance->get_path()));
+		} else if (entry.type < 0) {
+			// Get the node from somewhere, it likely already exists from another instance.
+			if (parent) {
+				node = parent->_get_child_by_name(snames[entry.name]);
+#ifdef DEBUG_ENABLED
+				if (!node) {
+					WARN_PRINT(String("Node '" + String(ret_nodes[0]->get_path_to(parent)) + "/" + String(snames[entry.name]) + "' was modified from inside an instance, but it has vanished.").ascii().get_data());
+				}
+#endif
+			}
+		} else {
+			Object *obj = entry.creation_func ? entry.creation_func() : ClassDB::instantiate(snames[entry.type]);
+			node = Object::cast_to<Node>(obj);
+			if (!node) {
+				if (obj) {
+					memdelete(obj);
+				}
+				ERR_FAIL_V_MSG(nullptr, vformat("Node %s of type %s cannot be created.", snames[entry.name], snames[entry.type]));
+			}
+		}
+
+		if (node) {
+			if (entry.child_count > 0) {
+				node->data.children.reserve(node->data.children.size() + entry.child_count);
+			}
+
+			for (uint32_t j = entry.property_from; j < entry.property_from + entry.property_count; j++) {
+				const InstantiationPlan::Property &prop = plan_props[j];
+				const Variant &value = props[prop.value];
+
+				switch (prop.kind) {
+					case InstantiationPlan::PROPERTY_SETTER: {
+						Callable::CallError ce;
+						if (prop.index >= 0) {
+							Variant index = prop.index;
+							const Variant *args[2] = { &index, &value };
+							prop.setter->call(node, args, 2, ce);
+						} else {
+							const Variant *args[1] = { &value };
+							prop.setter->call(node, args, 1, ce);
+						}
+					} break;
+					case InstantiationPlan::PROPERTY_READ_ONLY: {
+					} break;
+					case InstantiationPlan::PROPERTY_SET: {
+						node->set(snames[prop.name], value);
+					} break;
+					case InstantiationPlan::PROPERTY_ARRAY: {
+						Array set_array = value;
+						bool is_get_valid = false;
+						Variant get_value = node->get(snames[prop.name], &is_get_valid);
+						if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+							Array get_array = get_value;
+							if (!set_array.is_same_typed(get_array)) {
+								set_array = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
+							}
+						}
+						node->set(snames[prop.name], set_array);
+					} break;
+					case InstantiationPlan::PROPERTY_SCRIPT: {
+						_set_script_keeping_state(node, value);
+					} break;
+					case InstantiationPlan::PROPERTY_NODE_PATH: {
+						if (node->get_scene_instance_load_placeholder()) {
+							// We cannot know if the referenced nodes exist yet, so instead of deferring, we write the NodePaths directly.
+							node->set(snames[prop.name], value);
+							break;
+						}
+						DeferredNodePathProperties dnp;
+						dnp.value = value;
+						dnp.base = node;
+						dnp.property = snames[prop.name];
+						deferred_node_paths.push_back(dnp);
+					} break;
+				}
+			}
+
+			for (uint32_t j = entry.group_from; j < entry.group_from + entry.group_count; j++) {
+				node->add_to_group(snames[p_plan.groups[j]], true);
+			}
+
+			if (entry.add_to_parent) {
+				if (i > 0) {
+					if (parent) {
+						parent->_add_child_nocheck(node, snames[entry.name]);
+						if (entry.index >= 0 && entry.index < parent->get_child_count() - 1) {
+							parent->move_child(node, entry.index);
+						}
+					} else {
+						stray_instances.push_back(node);
+					}
+				} else {
+					node->_set_name_nocheck(snames[entry.name]);
+				}
+			}
+
+			if (entry.owner >= 0) {
+				Node *owner = ret_nodes[entry.owner];
+				if (owner) {
+					node->_set_owner_nocheck(owner);
+					if (node->data.unique_name_in_owner) {
+						node->_acquire_unique_name_in_owner();
+					}
+				}
+			}
+
+			if (entry.remove_pinned_properties) {
+				node->remove_meta("_edit_pinned_properties_");
+			}
+		}
+
+		ret_nodes[i] = node;
+	}
+
+	_resolve_deferred_node_paths(deferred_node_paths);
+
+	for (const InstantiationPlan::Connection &c : p_plan.connections) {
+		Node *cfrom = (c.from & FLAG_ID_IS_PATH) ? ret_nodes[0]->get_node_or_null(node_paths[c.from & FLAG_MASK]) : ret_nodes[c.from];
+		Node *cto = (c.to & FLAG_ID_IS_PATH) ? ret_nodes[0]->get_node_or_null(node_paths[c.to & FLAG_MASK]) : ret_nodes[c.to];
+		if (!cfrom || !cto) {
+			continue;
+		}
+
+		Callable callable(cto, snames[c.method]);
+		if (c.unbinds > 0) {
+			callable = callable.unbind(c.unbinds);
+		} else if (!c.binds.is_empty()) {
+			const Variant **argptrs = (const Variant **)alloca(sizeof(Variant *) * c.binds.size());
+			for (int j = 0; j < c.binds.size(); j++) {
+				argptrs[j] = &c.binds[j];
+			}
+			callable = callable.bindp(argptrs, c.binds.size());
+		}
+
+		cfrom->connect(snames[c.signal], callable, CONNECT_PERSIST | c.flags | CONNECT_INHERITED);
+	}
+
+	while (stray_instances.size()) {
+		memdelete(stray_instances.front()->get());
+		stray_instances.pop_front();
+	}
+
+	for (int i = 0; i < editable_instances.size(); i++) {
+		Node *ei = ret_nodes[0]->get_node_or_null(editable_instances[i]);
+		if (ei) {
+			ret_nodes[0]->set_editable_instance(ei, true);
+		}
+	}
+
+	return ret_nodes[0];
+}
+
 Variant SceneState::make_local_resource(Variant &p_value, const SceneState::NodeData &p_node_data, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_sub_scene, Node *p_node, const StringName p_sname, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_scene, int p_i, Node **p_ret_nodes, SceneState::GenEditState p_edit_state) const {
 	Ref<Resource> res = p_value;
 	if (res.is_null() || !res->is_local_to_scene()) {
@@ -1215,6 +1649,7 @@ String SceneState::get_path() const {
 }
 
 void SceneState::clear() {
+	_clear_instantiation_plan();
 	names.clear();
 	variants.clear();
 	nodes.clear();
@@ -1270,6 +1705,8 @@ Ref<SceneState> SceneState::get_base_scene_state() const {
 void SceneState::update_instance_resource(String p_path, Ref<PackedScene> p_packed_scene) {
 	ERR_FAIL_COND(p_packed_scene.is_null());
 
+	_clear_instantiation_plan();
+
 	for (const NodeData &nd : nodes) {
 		if (nd.instance >= 0) {
 			if (!(nd.instance & FLAG_INSTANCE_IS_PLACEHOLDER)) {
@@ -1378,11 +1815,20 @@ bool SceneState::is_node_in_group(int p_node, const StringName &p_group) const {
 }
 
 bool SceneState::disable_placeholders = false;
+bool SceneState::instantiation_plans_enabled = true;
 
 void SceneState::set_disable_placeholders(bool p_disable) {
 	disable_placeholders = p_disable;
 }
 
+void SceneState::set_instantiation_plans_enabled(bool p_enabled) {
+	instantiation_plans_enabled = p_enabled;
+}
+
+bool SceneState::are_instantiation_plans_enabled() {
+	return instantiation_plans_enabled;
+}
+
 bool SceneState::is_connection(int p_node, const StringName &p_signal, int p_to_node, const StringName &p_to_method) const {
 	ERR_FAIL_COND_V(p_node < 0, false);
 	ERR_FAIL_COND_V(p_to_node < 0, false);
@@ -1425,6 +1871,8 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 	ERR_FAIL_COND(!p_dictionary.has("conns"));
 	//ERR_FAIL_COND( !p_dictionary.has("path"));
 
+	_clear_instantiation_plan();
+
 	int version = 1;
 	if (p_dictionary.has("version")) {
 		version = p_dictionary["version"];
@@ -1883,21 +2331,25 @@ Vector<NodePath> SceneState::get_editable_instances() const {
 //add
 
 int SceneState::add_name(const StringName &p_name) {
+	_clear_instantiation_plan();
 	names.push_back(p_name);
 	return names.size() - 1;
 }
 
 int SceneState::add_value(const Variant &p_value) {
+	_clear_instantiation_plan();
 	variants.push_back(p_value);
 	return variants.size() - 1;
 }
 
 int SceneState::add_node_path(const NodePath &p_path) {
+	_clear_instantiation_plan();
 	node_paths.push_back(p_path);
 	return (node_paths.size() - 1) | FLAG_ID_IS_PATH;
 }
 
 int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int p_instance, int p_index) {
+	_clear_instantiation_plan();
 	NodeData nd;
 	nd.parent = p_parent;
 	nd.owner = p_owner;
@@ -1916,6 +2368,8 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 	ERR_FAIL_INDEX(p_name, names.size());
 	ERR_FAIL_INDEX(p_value, variants.size());
 
+	_clear_instantiation_plan();
+
 	NodeData::Property prop;
 	prop.name = p_name;
 	if (p_deferred_node_path) {
@@ -1928,11 +2382,13 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 void SceneState::add_node_group(int p_node, int p_group) {
 	ERR_FAIL_INDEX(p_node, nodes.size());
 	ERR_FAIL_INDEX(p_group, names.size());
+	_clear_instantiation_plan();
 	nodes.write[p_node].groups.push_back(p_group);
 }
 
 void SceneState::set_base_scene(int p_idx) {
 	ERR_FAIL_INDEX(p_idx, variants.size());
+	_clear_instantiation_plan();
 	base_scene_idx = p_idx;
 }
 
@@ -1943,6 +2399,7 @@ void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method
 	for (int i = 0; i < p_binds.size(); i++) {
 		ERR_FAIL_INDEX(p_binds[i], variants.size());
 	}
+	_clear_instantiation_plan();
 	ConnectionData c;
 	c.from = p_from;
 	c.to = p_to;
@@ -1955,10 +2412,12 @@ void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method
 }
 
 void SceneState::add_editable_instance(const NodePath &p_path) {
+	_clear_instantiation_plan();
 	editable_instances.push_back(p_path);
 }
 
 bool SceneState::remove_group_references(const StringName &p_name) {
+	_clear_instantiation_plan();
 	bool edited = false;
 	for (NodeData &node : nodes) {
 		for (const int &group : node.groups) {
@@ -1973,6 +2432,7 @@ bool SceneState::remove_group_references(const StringName &p_name) {
 }
 
 bool SceneState::rename_group_references(const StringName &p_old_name, const StringName &p_new_name) {
+	_clear_instantiation_plan();
 	bool edited = false;
 	for (const NodeData &node : nodes) {
 		for (const int &group : node.groups) {
@@ -2041,6 +2501,10 @@ void SceneState::_bind_methods() {
 SceneState::SceneState() {
 }
 
+SceneState::~SceneState() {
+	_clear_instantiation_plan();
+}
+
 ////////////////
 
 void PackedScene::_set_bundled_scene(const Dictionary &p_scene) {
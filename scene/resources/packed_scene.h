@@ -98,6 +98,77 @@ class SceneState : public RefCounted {
 
 	static bool disable_placeholders;
 
+	// Runtime instantiation resolves the node, property and connection tables once into a
+	// plan (constructors, setter binds, child counts), so scenes instantiated over and over
+	// skip the per-node name lookups. Scenes the plan can't express use the generic path.
+	// Instantiation holds a reference, so editing the state while another thread instantiates
+	// only drops the plan, which is freed once that instantiation is done.
+	struct InstantiationPlan {
+		SafeRefCount refcount;
+
+		enum PropertyKind {
+			PROPERTY_SETTER, // Native property, call its setter directly.
+			PROPERTY_READ_ONLY, // Native property without setter, nothing to do.
+			PROPERTY_SET, // Anything else, go through Object::set().
+			PROPERTY_ARRAY, // Needs to match the typed array of the target property.
+			PROPERTY_SCRIPT,
+			PROPERTY_NODE_PATH,
+		};
+
+		struct Property {
+			PropertyKind kind = PROPERTY_SET;
+			int name = 0;
+			int value = 0;
+			int index = -1;
+			MethodBind *setter = nullptr;
+		};
+
+		struct NodeEntry {
+			int parent = -1;
+			int owner = -1;
+			int type = -1; // -1 for nodes coming from an instance.
+			int name = 0;
+			int index = -1;
+			int child_count = 0;
+			ClassDB::CreationFunc creation_func = nullptr;
+			Ref<PackedScene> instance;
+			bool add_to_parent = true;
+			bool remove_pinned_properties = false;
+			uint32_t property_from = 0;
+			uint32_t property_count = 0;
+			uint32_t group_from = 0;
+			uint32_t group_count = 0;
+		};
+
+		struct Connection {
+			int from = 0;
+			int to = 0;
+			int signal = 0;
+			int method = 0;
+			int flags = 0;
+			int unbinds = 0;
+			Vector<Variant> binds;
+		};
+
+		LocalVector<NodeEntry> nodes;
+		LocalVector<Property> properties;
+		LocalVector<int> groups;
+		LocalVector<Connection> connections;
+	};
+
+	mutable InstantiationPlan *instantiation_plan = nullptr;
+	mutable bool instantiation_plan_compiled = false;
+	mutable Mutex instantiation_plan_mutex;
+	static bool instantiation_plans_enabled;
+
+	bool _compile_instantiation_plan(InstantiationPlan &r_plan) const;
+	InstantiationPlan *_ref_instantiation_plan() const;
+	static void _unref_instantiation_plan(InstantiationPlan *p_plan);
+	void _clear_instantiation_plan();
+	Node *_instantiate_from_plan(const InstantiationPlan &p_plan) const;
+
+	static void _resolve_deferred_node_paths(const LocalVector<DeferredNodePathProperties> &p_deferred_node_paths);
+
 	Vector<String> _get_node_groups(int p_idx) const;
 
 	int _find_base_scene_node_remap_key(int p_idx) const;
@@ -136,6 +207,8 @@ public:
 	};
 
 	static void set_disable_placeholders(bool p_disable);
+	static void set_instantiation_plans_enabled(bool p_enabled);
+	static bool are_instantiation_plans_enabled();
 	static Ref<Resource> get_remap_resource(const Ref<Resource> &p_resource, HashMap<Ref<Resource>, Ref<Resource>> &remap_cache, const Ref<Resource> &p_fallback, Node *p_for_scene);
 
 	int find_node_by_path(const NodePath &p_node) const;
@@ -156,6 +229,7 @@ public:
 
 	bool can_instantiate() const;
 	Node *instantiate(GenEditState p_edit_state) const;
+	bool has_instantiation_plan() const;
 
 	Array setup_resources_in_array(Array &array_to_scan, const SceneState::NodeData &n, HashMap<Ref<Resource>, Ref<Resource>> &resources_local_to_sub_scene, Node *node, const StringName sname, HashMap<Ref<Resource>, Ref<Resource>> &resources_local_to_scene, int i, Node **ret_nodes, SceneState::GenEditState p_edit_state) const;
 	Variant make_local_resource(Variant &value, const SceneState::NodeData &p_node_data, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_sub_scene, Node *p_node, const StringName p_sname, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_scene, int p_i, Node **p_ret_nodes, SceneState::GenEditState p_edit_state) const;
@@ -223,6 +297,7 @@ public:
 #endif
 
 	SceneState();
+	~SceneState();
 };
 
 VARIANT_ENUM_CAST(SceneState::GenEditState)
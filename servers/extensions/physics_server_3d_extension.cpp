@@ -46,6 +46,8 @@ void PhysicsDirectSpaceState3DExtension::_bind_methods() {
 	GDVIRTUAL_BIND(_collide_shape, "shape_rid", "transform", "motion", "margin", "collision_mask", "collide_with_bodies", "collide_with_areas", "results", "max_results", "result_count");
 	GDVIRTUAL_BIND(_rest_info, "shape_rid", "transform", "motion", "margin", "collision_mask", "collide_with_bodies", "collide_with_areas", "rest_info");
 	GDVIRTUAL_BIND(_get_closest_point_to_object_volume, "object", "point");
+	GDVIRTUAL_BIND(_intersect_rays, "from", "to", "count", "collision_mask", "collide_with_bodies", "collide_with_areas", "hit_from_inside", "hit_back_faces", "pick_ray", "results", "hits");
+	GDVIRTUAL_BIND(_intersect_shapes, "shape_rid", "transforms", "count", "motion", "margin", "collision_mask", "collide_with_bodies", "collide_with_areas", "results", "max_results", "result_counts");
 }
 
 PhysicsDirectSpaceState3DExtension::PhysicsDirectSpaceState3DExtension() {
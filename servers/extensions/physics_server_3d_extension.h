@@ -136,6 +136,8 @@ protected:
 	GDVIRTUAL10R(bool, _collide_shape, RID, const Transform3D &, const Vector3 &, real_t, uint32_t, bool, bool, GDExtensionPtr<Vector3>, int, GDExtensionPtr<int>)
 	GDVIRTUAL8R(bool, _rest_info, RID, const Transform3D &, const Vector3 &, real_t, uint32_t, bool, bool, GDExtensionPtr<PhysicsServer3DExtensionShapeRestInfo>)
 	GDVIRTUAL2RC(Vector3, _get_closest_point_to_object_volume, RID, const Vector3 &)
+	GDVIRTUAL11(_intersect_rays, GDExtensionConstPtr<Vector3>, GDExtensionConstPtr<Vector3>, int, uint32_t, bool, bool, bool, bool, bool, GDExtensionPtr<PhysicsServer3DExtensionRayResult>, GDExtensionPtr<bool>)
+	GDVIRTUAL11(_intersect_shapes, RID, GDExtensionConstPtr<Transform3D>, int, const Vector3 &, real_t, uint32_t, bool, bool, GDExtensionPtr<PhysicsServer3DExtensionShapeResult>, int, GDExtensionPtr<int>)
 
 public:
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override {
@@ -187,6 +189,24 @@ public:
 		return ret;
 	}
 
+	// The batched queries are optional, falling back to one single query per element.
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) override {
+		exclude = &p_parameters.exclude;
+		bool called = GDVIRTUAL_CALL(_intersect_rays, p_from, p_to, p_count, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.hit_from_inside, p_parameters.hit_back_faces, p_parameters.pick_ray, r_results, r_hits);
+		exclude = nullptr;
+		if (!called) {
+			PhysicsDirectSpaceState3D::intersect_rays(p_parameters, p_from, p_to, p_count, r_results, r_hits);
+		}
+	}
+	virtual void intersect_shapes(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) override {
+		exclude = &p_parameters.exclude;
+		bool called = GDVIRTUAL_CALL(_intersect_shapes, p_parameters.shape_rid, p_transforms, p_count, p_parameters.motion, p_parameters.margin, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, r_results, p_result_max, r_result_counts);
+		exclude = nullptr;
+		if (!called) {
+			PhysicsDirectSpaceState3D::intersect_shapes(p_parameters, p_transforms, p_count, r_results, p_result_max, r_result_counts);
+		}
+	}
+
 	PhysicsDirectSpaceState3DExtension();
 };
 
@@ -31,6 +31,7 @@
 #include "godot_body_pair_3d.h"
 
 #include "godot_collision_solver_3d.h"
+#include "godot_solver_body_state_3d.h"
 #include "godot_space_3d.h"
 
 #include "core/os/os.h"
@@ -595,6 +596,166 @@ void GodotBodyPair3D::solve(real_t p_step) {
 	}
 }
 
+bool GodotBodyPair3D::bind_solver_body_state(GodotSolverBodyState3D &p_state) {
+	solver_index_A = p_state.add_body(A);
+	solver_index_B = p_state.add_body(B);
+	friction = combine_friction(A, B);
+	return true;
+}
+
+// Same as solve(), reading and writing the velocities from the packed island state.
+void GodotBodyPair3D::solve_body_state(GodotSolverBodyState3D &p_state, real_t p_step) {
+	if (!collided) {
+		return;
+	}
+
+	const real_t max_bias_av = MAX_BIAS_ROTATION / p_step;
+
+	const uint32_t a = solver_index_A;
+	const uint32_t b = solver_index_B;
+
+	Vector3 *linear_velocity = p_state.linear_velocity.ptr();
+	Vector3 *angular_velocity = p_state.angular_velocity.ptr();
+	Vector3 *biased_linear_velocity = p_state.biased_linear_velocity.ptr();
+	Vector3 *biased_angular_velocity = p_state.biased_angular_velocity.ptr();
+	const Vector3 &center_of_mass_A = p_state.center_of_mass[a];
+	const Vector3 &center_of_mass_B = p_state.center_of_mass[b];
+
+	Basis zero_basis;
+	zero_basis.set_zero();
+
+	const Basis &inv_inertia_tensor_A = collide_A ? p_state.inv_inertia_tensor[a] : zero_basis;
+	const Basis &inv_inertia_tensor_B = collide_B ? p_state.inv_inertia_tensor[b] : zero_basis;
+
+	real_t inv_mass_A = collide_A ? p_state.inv_mass[a] : 0.0;
+	real_t inv_mass_B = collide_B ? p_state.inv_mass[b] : 0.0;
+
+	for (int i = 0; i < contact_count; i++) {
+		Contact &c = contacts[i];
+		if (!c.active) {
+			continue;
+		}
+
+		c.active = false; //try to deactivate, will activate itself if still needed
+
+		//bias impulse
+
+		Vector3 crbA = biased_angular_velocity[a].cross(c.rA);
+		Vector3 crbB = biased_angular_velocity[b].cross(c.rB);
+		Vector3 dbv = biased_linear_velocity[b] + crbB - biased_linear_velocity[a] - crbA;
+
+		real_t vbn = dbv.dot(c.normal);
+
+		if (Math::abs(-vbn + c.bias) > MIN_VELOCITY) {
+			real_t jbn = (-vbn + c.bias) * c.mass_normal;
+			real_t jbnOld = c.acc_bias_impulse;
+			c.acc_bias_impulse = MAX(jbnOld + jbn, 0.0f);
+
+			Vector3 jb = c.normal * (c.acc_bias_impulse - jbnOld);
+
+			if (collide_A) {
+				p_state.apply_bias_impulse(a, -jb, c.rA + center_of_mass_A, max_bias_av);
+			}
+			if (collide_B) {
+				p_state.apply_bias_impulse(b, jb, c.rB + center_of_mass_B, max_bias_av);
+			}
+
+			crbA = biased_angular_velocity[a].cross(c.rA);
+			crbB = biased_angular_velocity[b].cross(c.rB);
+			dbv = biased_linear_velocity[b] + crbB - biased_linear_velocity[a] - crbA;
+
+			vbn = dbv.dot(c.normal);
+
+			if (Math::abs(-vbn + c.bias) > MIN_VELOCITY) {
+				real_t jbn_com = (-vbn + c.bias) / (inv_mass_A + inv_mass_B);
+				real_t jbnOld_com = c.acc_bias_impulse_center_of_mass;
+				c.acc_bias_impulse_center_of_mass = MAX(jbnOld_com + jbn_com, 0.0f);
+
+				Vector3 jb_com = c.normal * (c.acc_bias_impulse_center_of_mass - jbnOld_com);
+
+				if (collide_A) {
+					p_state.apply_bias_impulse(a, -jb_com, center_of_mass_A, 0.0f);
+				}
+				if (collide_B) {
+					p_state.apply_bias_impulse(b, jb_com, center_of_mass_B, 0.0f);
+				}
+			}
+
+			c.active = true;
+		}
+
+		Vector3 crA = angular_velocity[a].cross(c.rA);
+		Vector3 crB = angular_velocity[b].cross(c.rB);
+		Vector3 dv = linear_velocity[b] + crB - linear_velocity[a] - crA;
+
+		//normal impulse
+		real_t vn = dv.dot(c.normal);
+
+		if (Math::abs(vn) > MIN_VELOCITY) {
+			real_t jn = -(c.bounce + vn) * c.mass_normal;
+			real_t jnOld = c.acc_normal_impulse;
+			c.acc_normal_impulse = MAX(jnOld + jn, 0.0f);
+
+			Vector3 j = c.normal * (c.acc_normal_impulse - jnOld);
+
+			if (collide_A) {
+				p_state.apply_impulse(a, -j, c.rA + center_of_mass_A);
+			}
+			if (collide_B) {
+				p_state.apply_impulse(b, j, c.rB + center_of_mass_B);
+			}
+			c.acc_impulse -= j;
+
+			c.active = true;
+		}
+
+		//friction impulse
+
+		Vector3 lvA = linear_velocity[a] + angular_velocity[a].cross(c.rA);
+		Vector3 lvB = linear_velocity[b] + angular_velocity[b].cross(c.rB);
+
+		Vector3 dtv = lvB - lvA;
+		real_t tn = c.normal.dot(dtv);
+
+		// tangential velocity
+		Vector3 tv = dtv - c.normal * tn;
+		real_t tvl = tv.length();
+
+		if (tvl > MIN_VELOCITY) {
+			tv /= tvl;
+
+			Vector3 temp1 = inv_inertia_tensor_A.xform(c.rA.cross(tv));
+			Vector3 temp2 = inv_inertia_tensor_B.xform(c.rB.cross(tv));
+
+			real_t t = -tvl / (inv_mass_A + inv_mass_B + tv.dot(temp1.cross(c.rA) + temp2.cross(c.rB)));
+
+			Vector3 jt = t * tv;
+
+			Vector3 jtOld = c.acc_tangent_impulse;
+			c.acc_tangent_impulse += jt;
+
+			real_t fi_len = c.acc_tangent_impulse.length();
+			real_t jtMax = c.acc_normal_impulse * friction;
+
+			if (fi_len > CMP_EPSILON && fi_len > jtMax) {
+				c.acc_tangent_impulse *= jtMax / fi_len;
+			}
+
+			jt = c.acc_tangent_impulse - jtOld;
+
+			if (collide_A) {
+				p_state.apply_impulse(a, -jt, c.rA + center_of_mass_A);
+			}
+			if (collide_B) {
+				p_state.apply_impulse(b, jt, c.rB + center_of_mass_B);
+			}
+			c.acc_impulse -= jt;
+
+			c.active = true;
+		}
+	}
+}
+
 GodotBodyPair3D::GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B) :
 		GodotBodyContact3D(_arr, 2) {
 	A = p_A;
@@ -32,6 +32,8 @@
 
 #include "godot_collision_object_3d.h"
 
+bool GodotBroadPhase3DBVH::parallel_pairing_enabled = true;
+
 GodotBroadPhase3DBVH::ID GodotBroadPhase3DBVH::create(GodotCollisionObject3D *p_object, int p_subindex, const AABB &p_aabb, bool p_static) {
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
 	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
@@ -86,6 +88,22 @@ int GodotBroadPhase3DBVH::cull_aabb(const AABB &p_aabb, GodotCollisionObject3D *
 	return bvh.cull_aabb(p_aabb, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices);
 }
 
+void GodotBroadPhase3DBVH::begin_concurrent_queries() {
+	bvh.lock_for_concurrent_culls();
+}
+
+void GodotBroadPhase3DBVH::end_concurrent_queries() {
+	bvh.unlock_for_concurrent_culls();
+}
+
+int GodotBroadPhase3DBVH::cull_segment_concurrent(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices, CullScratch &r_scratch) {
+	return bvh.cull_segment_unlocked(p_from, p_to, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices, r_scratch);
+}
+
+int GodotBroadPhase3DBVH::cull_aabb_concurrent(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices, CullScratch &r_scratch) {
+	return bvh.cull_aabb_unlocked(p_aabb, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices, r_scratch);
+}
+
 void *GodotBroadPhase3DBVH::_pair_callback(void *self, uint32_t p_A, GodotCollisionObject3D *p_object_A, int subindex_A, uint32_t p_B, GodotCollisionObject3D *p_object_B, int subindex_B) {
 	GodotBroadPhase3DBVH *bpo = static_cast<GodotBroadPhase3DBVH *>(self);
 	if (!bpo->pair_callback) {
@@ -125,4 +143,5 @@ GodotBroadPhase3D *GodotBroadPhase3DBVH::_create() {
 GodotBroadPhase3DBVH::GodotBroadPhase3DBVH() {
 	bvh.set_pair_callback(_pair_callback, this);
 	bvh.set_unpair_callback(_unpair_callback, this);
+	bvh.params_set_parallel_pairing_threshold(parallel_pairing_enabled ? PARALLEL_PAIRING_THRESHOLD : 0);
 }
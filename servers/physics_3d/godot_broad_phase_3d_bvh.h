@@ -63,6 +63,10 @@ class GodotBroadPhase3DBVH : public GodotBroadPhase3D {
 		TREE_FLAG_DYNAMIC = 1 << TREE_DYNAMIC,
 	};
 
+	// Below this many moved objects per step, pairing culls are cheaper to do serially.
+	static const uint32_t PARALLEL_PAIRING_THRESHOLD = 128;
+	static bool parallel_pairing_enabled;
+
 	BVH_Manager<GodotCollisionObject3D, 2, true, 128, UserPairTestFunction<GodotCollisionObject3D>, UserCullTestFunction<GodotCollisionObject3D>> bvh;
 
 	static void *_pair_callback(void *, uint32_t, GodotCollisionObject3D *, int, uint32_t, GodotCollisionObject3D *, int);
@@ -74,6 +78,10 @@ class GodotBroadPhase3DBVH : public GodotBroadPhase3D {
 	void *unpair_userdata = nullptr;
 
 public:
+	// Allows pairing every change serially, to compare against it. Only affects broadphases created afterwards.
+	static void set_parallel_pairing_enabled(bool p_enabled) { parallel_pairing_enabled = p_enabled; }
+	static bool is_parallel_pairing_enabled() { return parallel_pairing_enabled; }
+
 	// 0 is an invalid ID
 	virtual ID create(GodotCollisionObject3D *p_object, int p_subindex = 0, const AABB &p_aabb = AABB(), bool p_static = false) override;
 	virtual void move(ID p_id, const AABB &p_aabb) override;
@@ -88,6 +96,11 @@ public:
 	virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) override;
 	virtual int cull_aabb(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) override;
 
+	virtual void begin_concurrent_queries() override;
+	virtual void end_concurrent_queries() override;
+	virtual int cull_segment_concurrent(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices, CullScratch &r_scratch) override;
+	virtual int cull_aabb_concurrent(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices, CullScratch &r_scratch) override;
+
 	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) override;
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) override;
 
@@ -33,6 +33,7 @@
 
 class GodotBody3D;
 class GodotSoftBody3D;
+struct GodotSolverBodyState3D;
 
 class GodotConstraint3D {
 	GodotBody3D **_body_ptr;
@@ -75,6 +76,11 @@ public:
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
 
+	// Constraints that only change body velocities can instead be solved on the
+	// packed state of their island. Returns false if this constraint can't.
+	virtual bool bind_solver_body_state(GodotSolverBodyState3D &p_state) { return false; }
+	virtual void solve_body_state(GodotSolverBodyState3D &p_state, real_t p_step) {}
+
 	virtual ~GodotConstraint3D() {}
 };
 
@@ -0,0 +1,222 @@
+/**************************************************************************/
+/*  godot_quantized_bvh_3d.cpp                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "godot_quantized_bvh_3d.h"
+
+#include "core/templates/sort_array.h"
+
+static_assert(sizeof(GodotQuantizedBVH3D::Node) == 16, "Quantized BVH nodes are loaded as a single 16-byte vector.");
+
+bool GodotQuantizedBVH3D::node_overlaps_scalar(const Node &p_node, const uint16_t *p_query) {
+	for (int i = 0; i < 3; i++) {
+		if (p_node.min[i] > p_query[i + 3] || p_node.max[i] < p_query[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+real_t GodotQuantizedBVH3D::node_segment_entry_scalar(const Node &p_node, const Vector3 &p_from, const Vector3 &p_inv_dir, real_t p_max_t) {
+	real_t entry = 0.0;
+	real_t exit = p_max_t;
+	for (int i = 0; i < 3; i++) {
+		real_t t_min = (real_t(p_node.min[i]) - p_from[i]) * p_inv_dir[i];
+		real_t t_max = (real_t(p_node.max[i]) - p_from[i]) * p_inv_dir[i];
+		entry = MAX(entry, MIN(t_min, t_max));
+		exit = MIN(exit, MAX(t_min, t_max));
+	}
+	return entry <= exit ? entry : real_t(-1.0);
+}
+
+void GodotQuantizedBVH3D::_set_node_bounds(Node &r_node, const AABB &p_aabb) const {
+	for (int i = 0; i < 3; i++) {
+		real_t min = Math::floor(_quantize(p_aabb.position[i], i)) - 1;
+		real_t max = Math::ceil(_quantize(p_aabb.position[i] + p_aabb.size[i], i)) + 1;
+		r_node.min[i] = uint16_t(CLAMP(min, real_t(0.0), real_t(65535.0)));
+		r_node.max[i] = uint16_t(CLAMP(max, real_t(0.0), real_t(65535.0)));
+	}
+}
+
+static _FORCE_INLINE_ real_t _get_half_surface_area(const AABB &p_aabb) {
+	const Vector3 &size = p_aabb.size;
+	return size.x * size.y + size.y * size.z + size.z * size.x;
+}
+
+uint32_t GodotQuantizedBVH3D::_build_node(LocalVector<Node> &r_nodes, BuildItem *p_items, uint32_t p_begin, uint32_t p_end, int p_depth) {
+	const uint32_t index = r_nodes.size();
+	r_nodes.push_back(Node());
+
+	AABB bounds = p_items[p_begin].aabb;
+	AABB center_bounds(p_items[p_begin].center, Vector3());
+	for (uint32_t i = p_begin + 1; i < p_end; i++) {
+		bounds.merge_with(p_items[i].aabb);
+		center_bounds.expand_to(p_items[i].center);
+	}
+	_set_node_bounds(r_nodes[index], bounds);
+
+	const uint32_t count = p_end - p_begin;
+	if (count <= MAX_LEAF_ITEMS) {
+		r_nodes[index].data = LEAF_FLAG | (p_begin << 3) | (count - 1);
+		return index;
+	}
+
+	const int axis = center_bounds.get_longest_axis_index();
+	const real_t extent = center_bounds.size[axis];
+	uint32_t split = p_begin + count / 2;
+
+	if (extent <= 0) {
+		// All the centers match, any split is as good as another.
+	} else if (p_depth >= MAX_SAH_DEPTH) {
+		// Badly distributed items, split at the median to keep the depth bounded.
+		SortArray<BuildItem, BuildItemCompare> sort;
+		sort.compare.axis = axis;
+		sort.nth_element(p_begin, p_end, split, p_items);
+	} else {
+		// Binned surface area heuristic, along the axis the centers are the most spread on.
+		struct Bin {
+			AABB aabb;
+			uint32_t count = 0;
+		};
+		Bin bins[SAH_BIN_COUNT];
+
+		const real_t origin = center_bounds.position[axis];
+		const real_t bin_scale = real_t(SAH_BIN_COUNT) / extent;
+		auto get_bin = [&](const BuildItem &p_item) {
+			return MIN(int((p_item.center[axis] - origin) * bin_scale), SAH_BIN_COUNT - 1);
+		};
+
+		for (uint32_t i = p_begin; i < p_end; i++) {
+			Bin &bin = bins[get_bin(p_items[i])];
+			if (bin.count == 0) {
+				bin.aabb = p_items[i].aabb;
+			} else {
+				bin.aabb.merge_with(p_items[i].aabb);
+			}
+			bin.count++;
+		}
+
+		// Cost of the right side of every split, then sweep the left side to find the cheapest split.
+		real_t right_cost[SAH_BIN_COUNT] = {};
+		AABB side;
+		uint32_t side_count = 0;
+		for (int i = SAH_BIN_COUNT - 1; i > 0; i--) {
+			if (bins[i].count > 0) {
+				if (side_count == 0) {
+					side = bins[i].aabb;
+				} else {
+					side.merge_with(bins[i].aabb);
+				}
+				side_count += bins[i].count;
+			}
+			right_cost[i] = side_count > 0 ? _get_half_surface_area(side) * side_count : real_t(0.0);
+		}
+
+		int best_bin = -1;
+		real_t best_cost = 0.0;
+		side_count = 0;
+		for (int i = 1; i < SAH_BIN_COUNT; i++) {
+			const Bin &bin = bins[i - 1];
+			if (bin.count > 0) {
+				if (side_count == 0) {
+					side = bin.aabb;
+				} else {
+					side.merge_with(bin.aabb);
+				}
+				side_count += bin.count;
+			}
+			if (side_count == 0 || side_count == count) {
+				continue;
+			}
+			real_t cost = _get_half_surface_area(side) * side_count + right_cost[i];
+			if (best_bin < 0 || cost < best_cost) {
+				best_bin = i;
+				best_cost = cost;
+			}
+		}
+
+		if (best_bin > 0) {
+			uint32_t left = p_begin;
+			uint32_t right = p_end;
+			while (left < right) {
+				if (get_bin(p_items[left]) < best_bin) {
+					left++;
+				} else {
+					SWAP(p_items[left], p_items[--right]);
+				}
+			}
+			split = left;
+		}
+	}
+
+	_build_node(r_nodes, p_items, p_begin, split, p_depth + 1);
+	r_nodes[index].data = _build_node(r_nodes, p_items, split, p_end, p_depth + 1);
+	return index;
+}
+
+void GodotQuantizedBVH3D::build(const AABB *p_item_aabbs, uint32_t p_count, LocalVector<uint32_t> &r_order) {
+	clear();
+	r_order.clear();
+	if (p_count == 0) {
+		return;
+	}
+	ERR_FAIL_COND_MSG(p_count > MAX_ITEMS, "Too many items for a quantized BVH.");
+
+	LocalVector<BuildItem> items;
+	items.resize(p_count);
+	aabb = p_item_aabbs[0];
+	for (uint32_t i = 0; i < p_count; i++) {
+		items[i].aabb = p_item_aabbs[i];
+		items[i].center = p_item_aabbs[i].get_center();
+		items[i].index = i;
+		aabb.merge_with(p_item_aabbs[i]);
+	}
+
+	for (int i = 0; i < 3; i++) {
+		scale[i] = aabb.size[i] > 0 ? real_t(65532.0) / aabb.size[i] : real_t(0.0);
+	}
+
+	LocalVector<Node> build_nodes;
+	build_nodes.reserve(p_count / 2 + 1);
+	_build_node(build_nodes, items.ptr(), 0, p_count, 0);
+
+	nodes.resize(build_nodes.size());
+	memcpy(nodes.ptr(), build_nodes.ptr(), build_nodes.size() * sizeof(Node));
+
+	r_order.resize(p_count);
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_order[i] = items[i].index;
+	}
+}
+
+void GodotQuantizedBVH3D::clear() {
+	nodes.reset();
+	aabb = AABB();
+	scale = Vector3();
+}
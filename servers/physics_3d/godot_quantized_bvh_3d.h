@@ -0,0 +1,325 @@
+/**************************************************************************/
+/*  godot_quantized_bvh_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GODOT_QUANTIZED_BVH_3D_H
+#define GODOT_QUANTIZED_BVH_3D_H
+
+#include "core/math/aabb.h"
+#include "core/templates/local_vector.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GODOT_QUANTIZED_BVH_3D_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define GODOT_QUANTIZED_BVH_3D_NEON
+#endif
+
+// Compact bounding volume hierarchy over static items (the faces of a trimesh).
+// Node bounds are stored as 16-bit integers relative to the root bounds, so a
+// node takes 16 bytes. Quantized bounds are rounded outwards with one unit of
+// padding, so they always contain the items they were built from: queries can
+// report some extra leaves near the boundaries, but never miss one.
+//
+// Nodes are laid out depth-first: the left child of a node directly follows it.
+// Leaves reference a contiguous range of at most MAX_LEAF_ITEMS items, in the
+// order returned by build().
+class GodotQuantizedBVH3D {
+public:
+	enum {
+		MAX_LEAF_ITEMS = 4,
+		MAX_ITEMS = 1 << 28,
+	};
+
+	struct Node {
+		uint16_t min[3];
+		uint16_t max[3];
+		// Leaves: LEAF_FLAG | (first item << 3) | (item count - 1).
+		// Internal nodes: index of the right child.
+		uint32_t data;
+
+		_FORCE_INLINE_ bool is_leaf() const { return data & LEAF_FLAG; }
+		_FORCE_INLINE_ uint32_t get_first_item() const { return (data & ~LEAF_FLAG) >> 3; }
+		_FORCE_INLINE_ uint32_t get_item_count() const { return (data & 7) + 1; }
+	};
+
+private:
+	static const uint32_t LEAF_FLAG = 1u << 31;
+	static const int STACK_SIZE = 64;
+	static const int MAX_SAH_DEPTH = 32;
+	static const int SAH_BIN_COUNT = 16;
+
+	// Tight, the tree can be very large and doesn't change once built.
+	LocalVector<Node, uint32_t, false, true> nodes;
+
+	AABB aabb;
+	Vector3 scale;
+
+	struct BuildItem {
+		AABB aabb;
+		Vector3 center;
+		uint32_t index = 0;
+	};
+
+	struct BuildItemCompare {
+		int axis = 0;
+		_FORCE_INLINE_ bool operator()(const BuildItem &p_a, const BuildItem &p_b) const { return p_a.center[axis] < p_b.center[axis]; }
+	};
+
+	_FORCE_INLINE_ real_t _quantize(real_t p_value, int p_axis) const {
+		// Maps the root bounds to [1, 65533], leaving room for the padding.
+		return (p_value - aabb.position[p_axis]) * scale[p_axis] + real_t(1.0);
+	}
+
+	void _set_node_bounds(Node &r_node, const AABB &p_aabb) const;
+	uint32_t _build_node(LocalVector<Node> &r_nodes, BuildItem *p_items, uint32_t p_begin, uint32_t p_end, int p_depth);
+
+public:
+	// Quantized box overlap, both boxes given as three mins followed by three maxes.
+	static _FORCE_INLINE_ bool node_overlaps(const Node &p_node, const uint16_t *p_query) {
+#if defined(GODOT_QUANTIZED_BVH_3D_SSE2)
+		// a <= b exactly when the saturated a - b is zero.
+		const __m128i node = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&p_node));
+		const __m128i query_max = _mm_setr_epi16(p_query[3], p_query[4], p_query[5], -1, -1, -1, -1, -1);
+		const __m128i query_min = _mm_setr_epi16(0, 0, 0, p_query[0], p_query[1], p_query[2], 0, 0);
+		const __m128i excess = _mm_or_si128(_mm_subs_epu16(node, query_max), _mm_subs_epu16(query_min, node));
+		return _mm_movemask_epi8(_mm_cmpeq_epi16(excess, _mm_setzero_si128())) == 0xFFFF;
+#elif defined(GODOT_QUANTIZED_BVH_3D_NEON)
+		const uint16x8_t node = vld1q_u16(reinterpret_cast<const uint16_t *>(&p_node));
+		const uint16_t query_max_lanes[8] = { p_query[3], p_query[4], p_query[5], 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF };
+		const uint16_t query_min_lanes[8] = { 0, 0, 0, p_query[0], p_query[1], p_query[2], 0, 0 };
+		const uint16x8_t excess = vorrq_u16(vqsubq_u16(node, vld1q_u16(query_max_lanes)), vqsubq_u16(vld1q_u16(query_min_lanes), node));
+		const uint64x2_t excess_64 = vreinterpretq_u64_u16(excess);
+		return (vgetq_lane_u64(excess_64, 0) | vgetq_lane_u64(excess_64, 1)) == 0;
+#else
+		return node_overlaps_scalar(p_node, p_query);
+#endif
+	}
+
+	// Entry parameter of the segment p_from + t * p_dir, t in [0, p_max_t], into the quantized box, or -1 if it misses it.
+	// p_inv_dir must not contain infinities (see cull_segment()).
+	static _FORCE_INLINE_ real_t node_segment_entry(const Node &p_node, const Vector3 &p_from, const Vector3 &p_inv_dir, real_t p_max_t) {
+#if defined(GODOT_QUANTIZED_BVH_3D_SSE2) && !defined(REAL_T_IS_DOUBLE)
+		const __m128i node = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&p_node));
+		const __m128i zero = _mm_setzero_si128();
+		const __m128 low = _mm_cvtepi32_ps(_mm_unpacklo_epi16(node, zero)); // min.x, min.y, min.z, max.x
+		const __m128 high = _mm_cvtepi32_ps(_mm_unpackhi_epi16(node, zero)); // max.y, max.z, (data)
+		const __m128 max_xxyz = _mm_shuffle_ps(low, high, _MM_SHUFFLE(1, 0, 3, 3));
+		const __m128 box_max = _mm_shuffle_ps(max_xxyz, max_xxyz, _MM_SHUFFLE(3, 3, 2, 1));
+
+		const __m128 from = _mm_setr_ps(p_from.x, p_from.y, p_from.z, 0.0f);
+		const __m128 inv_dir = _mm_setr_ps(p_inv_dir.x, p_inv_dir.y, p_inv_dir.z, 0.0f);
+		const __m128 t_min = _mm_mul_ps(_mm_sub_ps(low, from), inv_dir);
+		const __m128 t_max = _mm_mul_ps(_mm_sub_ps(box_max, from), inv_dir);
+
+		// The unused fourth lane becomes the [0, p_max_t] range of the segment itself.
+		const __m128 xyz_mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+		const __m128 near = _mm_and_ps(_mm_min_ps(t_min, t_max), xyz_mask);
+		const __m128 far = _mm_or_ps(_mm_and_ps(_mm_max_ps(t_min, t_max), xyz_mask), _mm_andnot_ps(xyz_mask, _mm_set1_ps(p_max_t)));
+
+		__m128 entry = _mm_max_ps(near, _mm_shuffle_ps(near, near, _MM_SHUFFLE(2, 3, 0, 1)));
+		entry = _mm_max_ps(entry, _mm_shuffle_ps(entry, entry, _MM_SHUFFLE(1, 0, 3, 2)));
+		__m128 exit = _mm_min_ps(far, _mm_shuffle_ps(far, far, _MM_SHUFFLE(2, 3, 0, 1)));
+		exit = _mm_min_ps(exit, _mm_shuffle_ps(exit, exit, _MM_SHUFFLE(1, 0, 3, 2)));
+
+		const float t_entry = _mm_cvtss_f32(entry);
+		return t_entry <= _mm_cvtss_f32(exit) ? t_entry : -1.0f;
+#else
+		return node_segment_entry_scalar(p_node, p_from, p_inv_dir, p_max_t);
+#endif
+	}
+
+	static bool node_overlaps_scalar(const Node &p_node, const uint16_t *p_query);
+	static real_t node_segment_entry_scalar(const Node &p_node, const Vector3 &p_from, const Vector3 &p_inv_dir, real_t p_max_t);
+
+	// Builds the tree over the given item bounds. r_order receives the item indices in leaf order.
+	void build(const AABB *p_item_aabbs, uint32_t p_count, LocalVector<uint32_t> &r_order);
+	void clear();
+
+	_FORCE_INLINE_ bool is_empty() const { return nodes.is_empty(); }
+	_FORCE_INLINE_ const AABB &get_aabb() const { return aabb; }
+	_FORCE_INLINE_ uint32_t get_node_count() const { return nodes.size(); }
+	_FORCE_INLINE_ uint64_t get_memory_usage() const { return uint64_t(nodes.size()) * sizeof(Node); }
+
+	// Calls p_leaf(first, count) for every leaf overlapping p_aabb, stops when it returns true.
+	template <typename F>
+	bool cull_aabb(const AABB &p_aabb, F &p_leaf) const;
+
+	// Calls p_leaf(first, count) for every leaf the segment goes through, nearest first. p_leaf returns the
+	// fraction of the segment beyond which hits don't matter anymore, further leaves are skipped.
+	template <typename F>
+	void cull_segment(const Vector3 &p_from, const Vector3 &p_to, F &p_leaf) const;
+};
+
+template <typename F>
+bool GodotQuantizedBVH3D::cull_aabb(const AABB &p_aabb, F &p_leaf) const {
+	if (nodes.is_empty() || !aabb.intersects_inclusive(p_aabb)) {
+		return false;
+	}
+
+	uint16_t query[6];
+	for (int i = 0; i < 3; i++) {
+		query[i] = uint16_t(Math::floor(CLAMP(_quantize(p_aabb.position[i], i), real_t(0.0), real_t(65535.0))));
+		query[i + 3] = uint16_t(Math::ceil(CLAMP(_quantize(p_aabb.position[i] + p_aabb.size[i], i), real_t(0.0), real_t(65535.0))));
+	}
+
+	uint32_t stack[STACK_SIZE];
+	int stack_size = 0;
+	uint32_t index = 0;
+	while (true) {
+		const Node &node = nodes[index];
+		if (node_overlaps(node, query)) {
+			if (node.is_leaf()) {
+				if (p_leaf(node.get_first_item(), node.get_item_count())) {
+					return true;
+				}
+			} else {
+				stack[stack_size++] = node.data;
+				index++;
+				continue;
+			}
+		}
+		if (stack_size == 0) {
+			return false;
+		}
+		index = stack[--stack_size];
+	}
+}
+
+template <typename F>
+void GodotQuantizedBVH3D::cull_segment(const Vector3 &p_from, const Vector3 &p_to, F &p_leaf) const {
+	if (nodes.is_empty()) {
+		return;
+	}
+
+	// Clip the segment to the (slightly grown) root bounds first, so the quantized segment is computed from
+	// points close to the tree. Far away endpoints would lose too much precision once quantized.
+	const Vector3 margin = aabb.size * real_t(2.0 / 65532.0) + Vector3(CMP_EPSILON, CMP_EPSILON, CMP_EPSILON);
+	const AABB bounds(aabb.position - margin, aabb.size + margin * 2.0);
+	const Vector3 dir = p_to - p_from;
+	real_t clip_begin = 0.0;
+	real_t clip_end = 1.0;
+	for (int i = 0; i < 3; i++) {
+		if (dir[i] == 0) {
+			if (p_from[i] < bounds.position[i] || p_from[i] > bounds.position[i] + bounds.size[i]) {
+				return;
+			}
+			continue;
+		}
+		real_t t0 = (bounds.position[i] - p_from[i]) / dir[i];
+		real_t t1 = (bounds.position[i] + bounds.size[i] - p_from[i]) / dir[i];
+		if (t0 > t1) {
+			SWAP(t0, t1);
+		}
+		clip_begin = MAX(clip_begin, t0);
+		clip_end = MIN(clip_end, t1);
+		if (clip_begin > clip_end) {
+			return;
+		}
+	}
+
+	const Vector3 begin = p_from + dir * clip_begin;
+	const Vector3 end = p_from + dir * clip_end;
+	const real_t clip_length = clip_end - clip_begin;
+
+	Vector3 from;
+	Vector3 inv_dir;
+	for (int i = 0; i < 3; i++) {
+		from[i] = _quantize(begin[i], i);
+		real_t quantized_dir = _quantize(end[i], i) - from[i];
+		// Keep the inverse finite, infinities times zero would make NaNs in the slab test.
+		if (Math::abs(quantized_dir) < real_t(1e-12)) {
+			quantized_dir = quantized_dir < 0 ? real_t(-1e-12) : real_t(1e-12);
+		}
+		inv_dir[i] = real_t(1.0) / quantized_dir;
+	}
+
+	// Traversal works along the clipped segment, in [0, 1].
+	real_t max_t = 1.0;
+
+	struct Entry {
+		uint32_t index;
+		real_t t;
+	};
+	Entry stack[STACK_SIZE];
+	int stack_size = 0;
+
+	uint32_t index = 0;
+	if (node_segment_entry(nodes[0], from, inv_dir, max_t) < 0) {
+		return;
+	}
+
+	while (true) {
+		const Node &node = nodes[index];
+		if (node.is_leaf()) {
+			real_t limit = p_leaf(node.get_first_item(), node.get_item_count());
+			// Back to the clipped segment, with some slack for the rounding of the conversion.
+			real_t clipped_limit = clip_length > 0 ? (limit - clip_begin) / clip_length : real_t(1.0);
+			max_t = MIN(max_t, MAX(clipped_limit, real_t(0.0)) * real_t(1.0 + 1e-4) + real_t(1e-6));
+		} else {
+			const uint32_t left = index + 1;
+			const uint32_t right = node.data;
+			const real_t t_left = node_segment_entry(nodes[left], from, inv_dir, max_t);
+			const real_t t_right = node_segment_entry(nodes[right], from, inv_dir, max_t);
+			if (t_left >= 0 && t_right >= 0) {
+				// Visit the nearest child first, the other one may be skipped once something was hit.
+				if (t_left <= t_right) {
+					stack[stack_size++] = { right, t_right };
+					index = left;
+				} else {
+					stack[stack_size++] = { left, t_left };
+					index = right;
+				}
+				continue;
+			} else if (t_left >= 0) {
+				index = left;
+				continue;
+			} else if (t_right >= 0) {
+				index = right;
+				continue;
+			}
+		}
+
+		bool found = false;
+		while (stack_size > 0) {
+			const Entry &entry = stack[--stack_size];
+			if (entry.t <= max_t) {
+				index = entry.index;
+				found = true;
+				break;
+			}
+		}
+		if (!found) {
+			return;
+		}
+	}
+}
+
+#endif // GODOT_QUANTIZED_BVH_3D_H
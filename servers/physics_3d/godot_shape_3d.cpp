@@ -30,6 +30,8 @@
 
 #include "godot_shape_3d.h"
 
+#include "godot_simd_kernels_3d.h"
+
 #include "core/io/image.h"
 #include "core/math/convex_hull.h"
 #include "core/math/geometry_3d.h"
@@ -837,16 +839,7 @@ void GodotConvexPolygonShape3D::project_range(const Vector3 &p_normal, const Tra
 		r_min = p_normal.dot(p_transform.xform(get_support(-n)));
 		r_max = p_normal.dot(p_transform.xform(get_support(n)));
 	} else {
-		for (uint32_t i = 0; i < vertex_count; i++) {
-			real_t d = p_normal.dot(p_transform.xform(vrts[i]));
-
-			if (i == 0 || d > r_max) {
-				r_max = d;
-			}
-			if (i == 0 || d < r_min) {
-				r_min = d;
-			}
-		}
+		GodotSIMDKernels3D::points_project_range(vrts, vertex_count, p_normal, p_transform, r_min, r_max);
 	}
 }
 
@@ -1287,12 +1280,14 @@ GodotFaceShape3D::GodotFaceShape3D() {
 Vector<Vector3> GodotConcavePolygonShape3D::get_faces() const {
 	Vector<Vector3> rfaces;
 	rfaces.resize(faces.size() * 3);
+	Vector3 *rfacesw = rfaces.ptrw();
 
-	for (int i = 0; i < faces.size(); i++) {
-		Face f = faces.get(i);
+	for (uint32_t i = 0; i < faces.size(); i++) {
+		const Face &f = faces[i];
+		const uint32_t face_id = face_ids[i];
 
 		for (int j = 0; j < 3; j++) {
-			rfaces.set(i * 3 + j, vertices.get(f.indices[j]));
+			rfacesw[face_id * 3 + j] = vertices[f.indices[j]];
 		}
 	}
 
@@ -1345,75 +1340,70 @@ Vector3 GodotConcavePolygonShape3D::get_support(const Vector3 &p_normal) const {
 	return vptr[vert_support_idx];
 }
 
-void GodotConcavePolygonShape3D::_cull_segment(int p_idx, _SegmentCullParams *p_params) const {
-	const BVH *params_bvh = &p_params->bvh[p_idx];
-
-	if (!params_bvh->aabb.intersects_segment(p_params->from, p_params->to)) {
-		return;
-	}
-
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
-		GodotFaceShape3D *face = p_params->face;
-		face->normal = f->normal;
-		face->vertex[0] = p_params->vertices[f->indices[0]];
-		face->vertex[1] = p_params->vertices[f->indices[1]];
-		face->vertex[2] = p_params->vertices[f->indices[2]];
-
-		Vector3 res;
-		Vector3 normal;
-		int face_index = params_bvh->face_index;
-		if (face->intersect_segment(p_params->from, p_params->to, res, normal, face_index, true)) {
-			real_t d = p_params->dir.dot(res) - p_params->dir.dot(p_params->from);
-			if ((d > 0) && (d < p_params->min_d)) {
-				p_params->min_d = d;
-				p_params->result = res;
-				p_params->normal = normal;
-				p_params->face_index = face_index;
-				p_params->collisions++;
-			}
-		}
-	} else {
-		if (params_bvh->left >= 0) {
-			_cull_segment(params_bvh->left, p_params);
-		}
-		if (params_bvh->right >= 0) {
-			_cull_segment(params_bvh->right, p_params);
-		}
-	}
-}
-
 bool GodotConcavePolygonShape3D::intersect_segment(const Vector3 &p_begin, const Vector3 &p_end, Vector3 &r_result, Vector3 &r_normal, int &r_face_index, bool p_hit_back_faces) const {
-	if (faces.size() == 0) {
+	if (faces.is_empty()) {
 		return false;
 	}
 
-	// unlock data
-	const Face *fr = faces.ptr();
-	const Vector3 *vr = vertices.ptr();
-	const BVH *br = bvh.ptr();
-
 	GodotFaceShape3D face;
 	face.backface_collision = backface_collision && p_hit_back_faces;
 
-	_SegmentCullParams params;
-	params.from = p_begin;
-	params.to = p_end;
-	params.dir = (p_end - p_begin).normalized();
+	struct SegmentCull {
+		const GodotConcavePolygonShape3D *shape = nullptr;
+		GodotFaceShape3D *face = nullptr;
 
-	params.faces = fr;
-	params.vertices = vr;
-	params.bvh = br;
+		Vector3 from;
+		Vector3 to;
+		Vector3 dir;
+		real_t length = 0.0;
 
-	params.face = &face;
+		Vector3 result;
+		Vector3 normal;
+		int face_index = -1;
+		real_t min_d = 1e20;
+		int collisions = 0;
+
+		real_t operator()(uint32_t p_first, uint32_t p_count) {
+			for (uint32_t i = p_first; i < p_first + p_count; i++) {
+				const Face &f = shape->faces[i];
+				face->vertex[0] = shape->vertices[f.indices[0]];
+				face->vertex[1] = shape->vertices[f.indices[1]];
+				face->vertex[2] = shape->vertices[f.indices[2]];
+
+				Vector3 res;
+				Vector3 res_normal;
+				int res_face_index = shape->face_ids[i];
+				if (face->intersect_segment(from, to, res, res_normal, res_face_index, true)) {
+					real_t d = dir.dot(res) - dir.dot(from);
+					if ((d > 0) && (d < min_d)) {
+						min_d = d;
+						result = res;
+						normal = res_normal;
+						face_index = res_face_index;
+						collisions++;
+					}
+				}
+			}
+
+			// Leaves further than the closest hit can be skipped.
+			return collisions > 0 && length > 0 ? min_d / length : real_t(1.0);
+		}
+	};
 
-	// cull
-	_cull_segment(0, &params);
+	SegmentCull segment_cull;
+	segment_cull.shape = this;
+	segment_cull.face = &face;
+	segment_cull.from = p_begin;
+	segment_cull.to = p_end;
+	segment_cull.dir = (p_end - p_begin).normalized();
+	segment_cull.length = p_begin.distance_to(p_end);
 
-	if (params.collisions > 0) {
-		r_result = params.result;
-		r_normal = params.normal;
-		r_face_index = params.face_index;
+	bvh.cull_segment(p_begin, p_end, segment_cull);
+
+	if (segment_cull.collisions > 0) {
+		r_result = segment_cull.result;
+		r_normal = segment_cull.normal;
+		r_face_index = segment_cull.face_index;
 		return true;
 	} else {
 		return false;
@@ -1428,68 +1418,58 @@ Vector3 GodotConcavePolygonShape3D::get_closest_point_to(const Vector3 &p_point)
 	return Vector3();
 }
 
-bool GodotConcavePolygonShape3D::_cull(int p_idx, _CullParams *p_params) const {
-	const BVH *params_bvh = &p_params->bvh[p_idx];
-
-	if (!p_params->aabb.intersects(params_bvh->aabb)) {
-		return false;
-	}
-
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
-		GodotFaceShape3D *face = p_params->face;
-		face->normal = f->normal;
-		face->vertex[0] = p_params->vertices[f->indices[0]];
-		face->vertex[1] = p_params->vertices[f->indices[1]];
-		face->vertex[2] = p_params->vertices[f->indices[2]];
-		if (p_params->callback(p_params->userdata, face)) {
-			return true;
-		}
-	} else {
-		if (params_bvh->left >= 0) {
-			if (_cull(params_bvh->left, p_params)) {
-				return true;
-			}
-		}
-
-		if (params_bvh->right >= 0) {
-			if (_cull(params_bvh->right, p_params)) {
-				return true;
-			}
-		}
-	}
-
-	return false;
-}
-
 void GodotConcavePolygonShape3D::cull(const AABB &p_local_aabb, QueryCallback p_callback, void *p_userdata, bool p_invert_backface_collision) const {
 	// make matrix local to concave
-	if (faces.size() == 0) {
+	if (faces.is_empty()) {
 		return;
 	}
 
-	AABB local_aabb = p_local_aabb;
-
-	// unlock data
-	const Face *fr = faces.ptr();
-	const Vector3 *vr = vertices.ptr();
-	const BVH *br = bvh.ptr();
-
 	GodotFaceShape3D face; // use this to send in the callback
 	face.backface_collision = backface_collision;
 	face.invert_backface_collision = p_invert_backface_collision;
 
-	_CullParams params;
-	params.aabb = local_aabb;
-	params.face = &face;
-	params.faces = fr;
-	params.vertices = vr;
-	params.bvh = br;
-	params.callback = p_callback;
-	params.userdata = p_userdata;
+	struct AABBCull {
+		const GodotConcavePolygonShape3D *shape = nullptr;
+		GodotFaceShape3D *face = nullptr;
+		AABB aabb;
+		QueryCallback callback = nullptr;
+		void *userdata = nullptr;
+
+		bool operator()(uint32_t p_first, uint32_t p_count) {
+			for (uint32_t i = p_first; i < p_first + p_count; i++) {
+				const Face &f = shape->faces[i];
+				const Vector3 &v0 = shape->vertices[f.indices[0]];
+				const Vector3 &v1 = shape->vertices[f.indices[1]];
+				const Vector3 &v2 = shape->vertices[f.indices[2]];
+
+				// The BVH nodes are conservative, check the face itself.
+				AABB face_aabb(v0, Vector3());
+				face_aabb.expand_to(v1);
+				face_aabb.expand_to(v2);
+				if (!aabb.intersects(face_aabb)) {
+					continue;
+				}
 
-	// cull
-	_cull(0, &params);
+				face->normal = Plane(v0, v1, v2).normal;
+				face->vertex[0] = v0;
+				face->vertex[1] = v1;
+				face->vertex[2] = v2;
+				if (callback(userdata, face)) {
+					return true;
+				}
+			}
+			return false;
+		}
+	};
+
+	AABBCull aabb_cull;
+	aabb_cull.shape = this;
+	aabb_cull.face = &face;
+	aabb_cull.aabb = p_local_aabb;
+	aabb_cull.callback = p_callback;
+	aabb_cull.userdata = p_userdata;
+
+	bvh.cull_aabb(p_local_aabb, aabb_cull);
 }
 
 Vector3 GodotConcavePolygonShape3D::get_moment_of_inertia(real_t p_mass) const {
@@ -1502,114 +1482,24 @@ Vector3 GodotConcavePolygonShape3D::get_moment_of_inertia(real_t p_mass) const {
 			(p_mass / 3.0) * (extents.x * extents.x + extents.y * extents.y));
 }
 
-struct _Volume_BVH_Element {
-	AABB aabb;
-	Vector3 center;
-	int face_index = 0;
-};
-
-struct _Volume_BVH_CompareX {
-	_FORCE_INLINE_ bool operator()(const _Volume_BVH_Element &a, const _Volume_BVH_Element &b) const {
-		return a.center.x < b.center.x;
-	}
+struct _VertexRef {
+	Vector3 vertex;
+	uint32_t index = 0; // Into the source faces array.
 };
 
-struct _Volume_BVH_CompareY {
-	_FORCE_INLINE_ bool operator()(const _Volume_BVH_Element &a, const _Volume_BVH_Element &b) const {
-		return a.center.y < b.center.y;
+// Orders the bits, so sharing vertices doesn't alter any of them (such as -0.0).
+struct _VertexRefCompare {
+	_FORCE_INLINE_ bool operator()(const _VertexRef &p_a, const _VertexRef &p_b) const {
+		return memcmp(&p_a.vertex, &p_b.vertex, sizeof(Vector3)) < 0;
 	}
 };
 
-struct _Volume_BVH_CompareZ {
-	_FORCE_INLINE_ bool operator()(const _Volume_BVH_Element &a, const _Volume_BVH_Element &b) const {
-		return a.center.z < b.center.z;
-	}
-};
-
-struct _Volume_BVH {
-	AABB aabb;
-	_Volume_BVH *left = nullptr;
-	_Volume_BVH *right = nullptr;
-
-	int face_index = 0;
-};
-
-_Volume_BVH *_volume_build_bvh(_Volume_BVH_Element *p_elements, int p_size, int &count) {
-	_Volume_BVH *bvh = memnew(_Volume_BVH);
-
-	if (p_size == 1) {
-		//leaf
-		bvh->aabb = p_elements[0].aabb;
-		bvh->left = nullptr;
-		bvh->right = nullptr;
-		bvh->face_index = p_elements->face_index;
-		count++;
-		return bvh;
-	} else {
-		bvh->face_index = -1;
-	}
-
-	AABB aabb;
-	for (int i = 0; i < p_size; i++) {
-		if (i == 0) {
-			aabb = p_elements[i].aabb;
-		} else {
-			aabb.merge_with(p_elements[i].aabb);
-		}
-	}
-	bvh->aabb = aabb;
-	switch (aabb.get_longest_axis_index()) {
-		case 0: {
-			SortArray<_Volume_BVH_Element, _Volume_BVH_CompareX> sort_x;
-			sort_x.sort(p_elements, p_size);
-
-		} break;
-		case 1: {
-			SortArray<_Volume_BVH_Element, _Volume_BVH_CompareY> sort_y;
-			sort_y.sort(p_elements, p_size);
-		} break;
-		case 2: {
-			SortArray<_Volume_BVH_Element, _Volume_BVH_CompareZ> sort_z;
-			sort_z.sort(p_elements, p_size);
-		} break;
-	}
-
-	int split = p_size / 2;
-	bvh->left = _volume_build_bvh(p_elements, split, count);
-	bvh->right = _volume_build_bvh(&p_elements[split], p_size - split, count);
-
-	//printf("branch at %p - %i: %i\n",bvh,count,bvh->face_index);
-	count++;
-	return bvh;
-}
-
-void GodotConcavePolygonShape3D::_fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx) {
-	int idx = p_idx;
-
-	p_bvh_array[idx].aabb = p_bvh_tree->aabb;
-	p_bvh_array[idx].face_index = p_bvh_tree->face_index;
-	//printf("%p - %i: %i(%p)  -- %p:%p\n",%p_bvh_array[idx],p_idx,p_bvh_array[i]->face_index,&p_bvh_tree->face_index,p_bvh_tree->left,p_bvh_tree->right);
-
-	if (p_bvh_tree->left) {
-		p_bvh_array[idx].left = ++p_idx;
-		_fill_bvh(p_bvh_tree->left, p_bvh_array, p_idx);
-
-	} else {
-		p_bvh_array[p_idx].left = -1;
-	}
-
-	if (p_bvh_tree->right) {
-		p_bvh_array[idx].right = ++p_idx;
-		_fill_bvh(p_bvh_tree->right, p_bvh_array, p_idx);
-
-	} else {
-		p_bvh_array[p_idx].right = -1;
-	}
-
-	memdelete(p_bvh_tree);
-}
-
 void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_backface_collision) {
+	faces.reset();
+	face_ids.reset();
+	vertices.reset();
+	bvh.clear();
+
 	int src_face_count = p_faces.size();
 	if (src_face_count == 0) {
 		configure(AABB());
@@ -1620,49 +1510,59 @@ void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_b
 
 	const Vector3 *facesr = p_faces.ptr();
 
-	Vector<_Volume_BVH_Element> bvh_array;
-	bvh_array.resize(src_face_count);
+	LocalVector<AABB> face_aabbs;
+	face_aabbs.resize(src_face_count);
 
-	_Volume_BVH_Element *bvh_arrayw = bvh_array.ptrw();
-
-	faces.resize(src_face_count);
-	Face *facesw = faces.ptrw();
-
-	vertices.resize(src_face_count * 3);
-
-	Vector3 *verticesw = vertices.ptrw();
+	LocalVector<Face> src_faces;
+	src_faces.resize(src_face_count);
 
 	AABB _aabb;
 
 	for (int i = 0; i < src_face_count; i++) {
 		Face3 face(facesr[i * 3 + 0], facesr[i * 3 + 1], facesr[i * 3 + 2]);
 
-		bvh_arrayw[i].aabb = face.get_aabb();
-		bvh_arrayw[i].center = bvh_arrayw[i].aabb.get_center();
-		bvh_arrayw[i].face_index = i;
-		facesw[i].indices[0] = i * 3 + 0;
-		facesw[i].indices[1] = i * 3 + 1;
-		facesw[i].indices[2] = i * 3 + 2;
-		facesw[i].normal = face.get_plane().normal;
-		verticesw[i * 3 + 0] = face.vertex[0];
-		verticesw[i * 3 + 1] = face.vertex[1];
-		verticesw[i * 3 + 2] = face.vertex[2];
+		face_aabbs[i] = face.get_aabb();
 		if (i == 0) {
-			_aabb = bvh_arrayw[i].aabb;
+			_aabb = face_aabbs[i];
 		} else {
-			_aabb.merge_with(bvh_arrayw[i].aabb);
+			_aabb.merge_with(face_aabbs[i]);
 		}
 	}
 
-	int count = 0;
-	_Volume_BVH *bvh_tree = _volume_build_bvh(bvh_arrayw, src_face_count, count);
+	// Share identical vertices between faces, sorting them is much lighter than hashing for large meshes.
+	LocalVector<_VertexRef> vertex_refs;
+	vertex_refs.resize(src_face_count * 3);
+	for (uint32_t i = 0; i < vertex_refs.size(); i++) {
+		vertex_refs[i].vertex = facesr[i];
+		vertex_refs[i].index = i;
+	}
 
-	bvh.resize(count + 1);
+	SortArray<_VertexRef, _VertexRefCompare> sort_vertices;
+	sort_vertices.sort(vertex_refs.ptr(), vertex_refs.size());
 
-	BVH *bvh_arrayw2 = bvh.ptrw();
+	LocalVector<Vector3> src_vertices;
+	for (uint32_t i = 0; i < vertex_refs.size(); i++) {
+		const _VertexRef &ref = vertex_refs[i];
+		if (i == 0 || memcmp(&ref.vertex, &vertex_refs[i - 1].vertex, sizeof(Vector3)) != 0) {
+			src_vertices.push_back(ref.vertex);
+		}
+		src_faces[ref.index / 3].indices[ref.index % 3] = src_vertices.size() - 1;
+	}
+	vertex_refs.reset();
 
-	int idx = 0;
-	_fill_bvh(bvh_tree, bvh_arrayw2, idx);
+	LocalVector<uint32_t> order;
+	bvh.build(face_aabbs.ptr(), src_face_count, order);
+	ERR_FAIL_COND(order.size() != uint32_t(src_face_count));
+
+	faces.resize(src_face_count);
+	face_ids.resize(src_face_count);
+	for (int i = 0; i < src_face_count; i++) {
+		faces[i] = src_faces[order[i]];
+		face_ids[i] = order[i];
+	}
+
+	vertices.resize(src_vertices.size());
+	memcpy(vertices.ptr(), src_vertices.ptr(), src_vertices.size() * sizeof(Vector3));
 
 	backface_collision = p_backface_collision;
 
@@ -1684,6 +1584,10 @@ Variant GodotConcavePolygonShape3D::get_data() const {
 	return d;
 }
 
+uint64_t GodotConcavePolygonShape3D::get_memory_usage() const {
+	return uint64_t(faces.size()) * sizeof(Face) + uint64_t(face_ids.size()) * sizeof(uint32_t) + uint64_t(vertices.size()) * sizeof(Vector3) + bvh.get_memory_usage();
+}
+
 GodotConcavePolygonShape3D::GodotConcavePolygonShape3D() {
 }
 
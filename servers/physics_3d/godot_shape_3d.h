@@ -31,6 +31,8 @@
 #ifndef GODOT_SHAPE_3D_H
 #define GODOT_SHAPE_3D_H
 
+#include "godot_quantized_bvh_3d.h"
+
 #include "core/math/geometry_3d.h"
 #include "core/templates/local_vector.h"
 #include "servers/physics_server_3d.h"
@@ -302,63 +304,25 @@ public:
 	GodotConvexPolygonShape3D();
 };
 
-struct _Volume_BVH;
 struct GodotFaceShape3D;
 
 struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 	// always a trimesh
 
 	struct Face {
-		Vector3 normal;
-		int indices[3] = {};
-	};
-
-	Vector<Face> faces;
-	Vector<Vector3> vertices;
-
-	struct BVH {
-		AABB aabb;
-		int left = 0;
-		int right = 0;
-
-		int face_index = 0;
+		uint32_t indices[3] = {};
 	};
 
-	Vector<BVH> bvh;
+	// Faces are stored in the leaf order of the BVH, face_ids gives their original index.
+	// The arrays are tight, as trimeshes can have millions of faces and don't change once set up.
+	LocalVector<Face, uint32_t, false, true> faces;
+	LocalVector<uint32_t, uint32_t, false, true> face_ids;
+	LocalVector<Vector3, uint32_t, false, true> vertices; // Shared between faces.
 
-	struct _CullParams {
-		AABB aabb;
-		QueryCallback callback = nullptr;
-		void *userdata = nullptr;
-		const Face *faces = nullptr;
-		const Vector3 *vertices = nullptr;
-		const BVH *bvh = nullptr;
-		GodotFaceShape3D *face = nullptr;
-	};
-
-	struct _SegmentCullParams {
-		Vector3 from;
-		Vector3 to;
-		Vector3 dir;
-		const Face *faces = nullptr;
-		const Vector3 *vertices = nullptr;
-		const BVH *bvh = nullptr;
-		GodotFaceShape3D *face = nullptr;
-
-		Vector3 result;
-		Vector3 normal;
-		int face_index = -1;
-		real_t min_d = 1e20;
-		int collisions = 0;
-	};
+	GodotQuantizedBVH3D bvh;
 
 	bool backface_collision = false;
 
-	void _cull_segment(int p_idx, _SegmentCullParams *p_params) const;
-	bool _cull(int p_idx, _CullParams *p_params) const;
-
-	void _fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx);
-
 	void _setup(const Vector<Vector3> &p_faces, bool p_backface_collision);
 
 public:
@@ -380,6 +344,9 @@ public:
 	virtual void set_data(const Variant &p_data) override;
 	virtual Variant get_data() const override;
 
+	// Bytes used by the faces, vertices and BVH.
+	uint64_t get_memory_usage() const;
+
 	GodotConcavePolygonShape3D();
 };
 
@@ -0,0 +1,169 @@
+/**************************************************************************/
+/*  godot_simd_kernels_3d.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "godot_simd_kernels_3d.h"
+
+// Scalar math must also be done in SSE registers (not x87), and must not be contracted into FMAs.
+#if !defined(REAL_T_IS_DOUBLE) && !defined(__FMA__) && (defined(__SSE2_MATH__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define GODOT_SIMD_KERNELS_3D_SSE2
+#endif
+
+bool GodotSIMDKernels3D::enabled = true;
+
+bool GodotSIMDKernels3D::is_available() {
+#ifdef GODOT_SIMD_KERNELS_3D_SSE2
+	return true;
+#else
+	return false;
+#endif
+}
+
+void GodotSIMDKernels3D::box_project_range_x4_scalar(const Vector3 &p_half_extents, const Transform3D &p_transform, const Vector3 *p_axes, real_t *r_min, real_t *r_max) {
+	for (int i = 0; i < 4; i++) {
+		// no matter the angle, the box is mirrored anyway
+		Vector3 local_normal = p_transform.basis.xform_inv(p_axes[i]);
+
+		real_t length = local_normal.abs().dot(p_half_extents);
+		real_t distance = p_axes[i].dot(p_transform.origin);
+
+		r_min[i] = distance - length;
+		r_max[i] = distance + length;
+	}
+}
+
+void GodotSIMDKernels3D::points_project_range_scalar(const Vector3 *p_points, uint32_t p_count, const Vector3 &p_normal, const Transform3D &p_transform, real_t &r_min, real_t &r_max) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		real_t d = p_normal.dot(p_transform.xform(p_points[i]));
+
+		if (i == 0 || d > r_max) {
+			r_max = d;
+		}
+		if (i == 0 || d < r_min) {
+			r_min = d;
+		}
+	}
+}
+
+#ifdef GODOT_SIMD_KERNELS_3D_SSE2
+
+// a.x * b.x + a.y * b.y + a.z * b.z, evaluated left to right like Vector3::dot().
+static _FORCE_INLINE_ __m128 _dot_x4(__m128 p_ax, __m128 p_ay, __m128 p_az, __m128 p_bx, __m128 p_by, __m128 p_bz) {
+	return _mm_add_ps(_mm_add_ps(_mm_mul_ps(p_ax, p_bx), _mm_mul_ps(p_ay, p_by)), _mm_mul_ps(p_az, p_bz));
+}
+
+static void _box_project_range_x4_sse2(const Vector3 &p_half_extents, const Transform3D &p_transform, const Vector3 *p_axes, real_t *r_min, real_t *r_max) {
+	const __m128 nx = _mm_setr_ps(p_axes[0].x, p_axes[1].x, p_axes[2].x, p_axes[3].x);
+	const __m128 ny = _mm_setr_ps(p_axes[0].y, p_axes[1].y, p_axes[2].y, p_axes[3].y);
+	const __m128 nz = _mm_setr_ps(p_axes[0].z, p_axes[1].z, p_axes[2].z, p_axes[3].z);
+
+	// Basis::xform_inv(), one component of the four local normals at a time.
+	const Vector3 *rows = p_transform.basis.rows;
+	const __m128 lx = _dot_x4(_mm_set1_ps(rows[0].x), _mm_set1_ps(rows[1].x), _mm_set1_ps(rows[2].x), nx, ny, nz);
+	const __m128 ly = _dot_x4(_mm_set1_ps(rows[0].y), _mm_set1_ps(rows[1].y), _mm_set1_ps(rows[2].y), nx, ny, nz);
+	const __m128 lz = _dot_x4(_mm_set1_ps(rows[0].z), _mm_set1_ps(rows[1].z), _mm_set1_ps(rows[2].z), nx, ny, nz);
+
+	const __m128 sign_mask = _mm_set1_ps(-0.0f);
+	const __m128 length = _dot_x4(_mm_andnot_ps(sign_mask, lx), _mm_andnot_ps(sign_mask, ly), _mm_andnot_ps(sign_mask, lz), _mm_set1_ps(p_half_extents.x), _mm_set1_ps(p_half_extents.y), _mm_set1_ps(p_half_extents.z));
+	const __m128 distance = _dot_x4(nx, ny, nz, _mm_set1_ps(p_transform.origin.x), _mm_set1_ps(p_transform.origin.y), _mm_set1_ps(p_transform.origin.z));
+
+	_mm_storeu_ps(r_min, _mm_sub_ps(distance, length));
+	_mm_storeu_ps(r_max, _mm_add_ps(distance, length));
+}
+
+static void _points_project_range_sse2(const Vector3 *p_points, uint32_t p_count, const Vector3 &p_normal, const Transform3D &p_transform, real_t &r_min, real_t &r_max) {
+	const Vector3 *rows = p_transform.basis.rows;
+	const __m128 r0x = _mm_set1_ps(rows[0].x), r0y = _mm_set1_ps(rows[0].y), r0z = _mm_set1_ps(rows[0].z);
+	const __m128 r1x = _mm_set1_ps(rows[1].x), r1y = _mm_set1_ps(rows[1].y), r1z = _mm_set1_ps(rows[1].z);
+	const __m128 r2x = _mm_set1_ps(rows[2].x), r2y = _mm_set1_ps(rows[2].y), r2z = _mm_set1_ps(rows[2].z);
+	const __m128 ox = _mm_set1_ps(p_transform.origin.x), oy = _mm_set1_ps(p_transform.origin.y), oz = _mm_set1_ps(p_transform.origin.z);
+	const __m128 nx = _mm_set1_ps(p_normal.x), ny = _mm_set1_ps(p_normal.y), nz = _mm_set1_ps(p_normal.z);
+
+	// The distances are computed four at a time, the running min/max stay sequential
+	// so that ties (e.g. +0.0 and -0.0) resolve the same way as in the scalar scan.
+	alignas(16) float distances[4];
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		const Vector3 *p = &p_points[i];
+		const __m128 px = _mm_setr_ps(p[0].x, p[1].x, p[2].x, p[3].x);
+		const __m128 py = _mm_setr_ps(p[0].y, p[1].y, p[2].y, p[3].y);
+		const __m128 pz = _mm_setr_ps(p[0].z, p[1].z, p[2].z, p[3].z);
+
+		// Transform3D::xform().
+		const __m128 wx = _mm_add_ps(_dot_x4(r0x, r0y, r0z, px, py, pz), ox);
+		const __m128 wy = _mm_add_ps(_dot_x4(r1x, r1y, r1z, px, py, pz), oy);
+		const __m128 wz = _mm_add_ps(_dot_x4(r2x, r2y, r2z, px, py, pz), oz);
+
+		_mm_store_ps(distances, _dot_x4(nx, ny, nz, wx, wy, wz));
+
+		for (uint32_t j = 0; j < 4; j++) {
+			const real_t d = distances[j];
+			if (i + j == 0 || d > r_max) {
+				r_max = d;
+			}
+			if (i + j == 0 || d < r_min) {
+				r_min = d;
+			}
+		}
+	}
+
+	for (; i < p_count; i++) {
+		real_t d = p_normal.dot(p_transform.xform(p_points[i]));
+
+		if (i == 0 || d > r_max) {
+			r_max = d;
+		}
+		if (i == 0 || d < r_min) {
+			r_min = d;
+		}
+	}
+}
+
+#endif // GODOT_SIMD_KERNELS_3D_SSE2
+
+void GodotSIMDKernels3D::box_project_range_x4(const Vector3 &p_half_extents, const Transform3D &p_transform, const Vector3 *p_axes, real_t *r_min, real_t *r_max) {
+#ifdef GODOT_SIMD_KERNELS_3D_SSE2
+	if (enabled) {
+		_box_project_range_x4_sse2(p_half_extents, p_transform, p_axes, r_min, r_max);
+		return;
+	}
+#endif
+	box_project_range_x4_scalar(p_half_extents, p_transform, p_axes, r_min, r_max);
+}
+
+void GodotSIMDKernels3D::points_project_range(const Vector3 *p_points, uint32_t p_count, const Vector3 &p_normal, const Transform3D &p_transform, real_t &r_min, real_t &r_max) {
+#ifdef GODOT_SIMD_KERNELS_3D_SSE2
+	if (enabled) {
+		_points_project_range_sse2(p_points, p_count, p_normal, p_transform, r_min, r_max);
+		return;
+	}
+#endif
+	points_project_range_scalar(p_points, p_count, p_normal, p_transform, r_min, r_max);
+}
@@ -0,0 +1,59 @@
+/**************************************************************************/
+/*  godot_simd_kernels_3d.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GODOT_SIMD_KERNELS_3D_H
+#define GODOT_SIMD_KERNELS_3D_H
+
+#include "core/math/transform_3d.h"
+
+// Vectorized versions of the projections used by the separating axis tests.
+// The SIMD kernels perform the same operations in the same order as the scalar
+// ones, so both give bitwise identical results. They are only compiled when that
+// can be guaranteed: single precision SSE2 math, without fused multiply-add.
+class GodotSIMDKernels3D {
+	static bool enabled;
+
+public:
+	static bool is_available();
+
+	// Allows forcing the scalar kernels, to compare against them.
+	static void set_enabled(bool p_enabled) { enabled = p_enabled; }
+	static bool is_enabled() { return enabled; }
+
+	// Projects a box on four axes at once, same as GodotBoxShape3D::project_range().
+	static void box_project_range_x4(const Vector3 &p_half_extents, const Transform3D &p_transform, const Vector3 *p_axes, real_t *r_min, real_t *r_max);
+	static void box_project_range_x4_scalar(const Vector3 &p_half_extents, const Transform3D &p_transform, const Vector3 *p_axes, real_t *r_min, real_t *r_max);
+
+	// Range of the transformed points along p_normal, as found by scanning them in order.
+	static void points_project_range(const Vector3 *p_points, uint32_t p_count, const Vector3 &p_normal, const Transform3D &p_transform, real_t &r_min, real_t &r_max);
+	static void points_project_range_scalar(const Vector3 *p_points, uint32_t p_count, const Vector3 &p_normal, const Transform3D &p_transform, real_t &r_min, real_t &r_max);
+};
+
+#endif // GODOT_SIMD_KERNELS_3D_H
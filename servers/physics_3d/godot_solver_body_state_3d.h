@@ -0,0 +1,79 @@
+/**************************************************************************/
+/*  godot_solver_body_state_3d.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GODOT_SOLVER_BODY_STATE_3D_H
+#define GODOT_SOLVER_BODY_STATE_3D_H
+
+#include "godot_body_3d.h"
+
+#include "core/templates/local_vector.h"
+
+// Velocities and mass properties of the bodies of one island, packed in arrays
+// so the solver iterations don't have to go through the GodotBody3D objects.
+// Rigid bodies get a single slot each, and their velocities are written back
+// once the island is solved. Static and kinematic bodies are never modified by
+// the solver, they get a read-only slot per use since they can be shared
+// between islands solved on other threads.
+struct GodotSolverBodyState3D {
+	LocalVector<Vector3> linear_velocity;
+	LocalVector<Vector3> angular_velocity;
+	LocalVector<Vector3> biased_linear_velocity;
+	LocalVector<Vector3> biased_angular_velocity;
+	LocalVector<real_t> inv_mass;
+	LocalVector<Basis> inv_inertia_tensor;
+	LocalVector<Vector3> center_of_mass;
+
+	LocalVector<GodotBody3D *> bodies;
+	uint64_t step = 0;
+
+	void begin(uint64_t p_step);
+	uint32_t add_body(GodotBody3D *p_body);
+	void write_back() const;
+
+	// Same as GodotBody3D::apply_impulse().
+	_FORCE_INLINE_ void apply_impulse(uint32_t p_index, const Vector3 &p_impulse, const Vector3 &p_position) {
+		linear_velocity[p_index] += p_impulse * inv_mass[p_index];
+		angular_velocity[p_index] += inv_inertia_tensor[p_index].xform((p_position - center_of_mass[p_index]).cross(p_impulse));
+	}
+
+	// Same as GodotBody3D::apply_bias_impulse().
+	_FORCE_INLINE_ void apply_bias_impulse(uint32_t p_index, const Vector3 &p_impulse, const Vector3 &p_position, real_t p_max_delta_av) {
+		biased_linear_velocity[p_index] += p_impulse * inv_mass[p_index];
+		if (p_max_delta_av != 0.0) {
+			Vector3 delta_av = inv_inertia_tensor[p_index].xform((p_position - center_of_mass[p_index]).cross(p_impulse));
+			if (p_max_delta_av > 0 && delta_av.length() > p_max_delta_av) {
+				delta_av = delta_av.normalized() * p_max_delta_av;
+			}
+			biased_angular_velocity[p_index] += delta_av;
+		}
+	}
+};
+
+#endif // GODOT_SOLVER_BODY_STATE_3D_H
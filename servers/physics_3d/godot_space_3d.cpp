@@ -34,6 +34,7 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
@@ -108,14 +109,18 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
 	ERR_FAIL_COND_V(space->locked, false);
 
+	int amount = space->broadphase->cull_segment(p_parameters.from, p_parameters.to, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	return _intersect_ray_candidates(p_parameters, p_parameters.from, p_parameters.to, space->intersection_query_results, space->intersection_query_subindex_results, amount, r_result);
+}
+
+bool GodotPhysicsDirectSpaceState3D::_intersect_ray_candidates(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D *const *p_candidates, const int *p_candidate_shapes, int p_amount, RayResult &r_result) const {
 	Vector3 begin, end;
 	Vector3 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
+	begin = p_from;
+	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
 	bool collided = false;
@@ -125,22 +130,22 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	const GodotCollisionObject3D *res_obj = nullptr;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+	for (int i = 0; i < p_amount; i++) {
+		if (!_can_collide_with(p_candidates[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_parameters.pick_ray && !(p_candidates[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_candidates[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject3D *col_obj = p_candidates[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = p_candidate_shapes[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -217,29 +222,33 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_par
 
 	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
 
+	return _intersect_shape_candidates(shape, p_parameters, p_parameters.transform, space->intersection_query_results, space->intersection_query_subindex_results, amount, r_results, p_result_max);
+}
+
+int GodotPhysicsDirectSpaceState3D::_intersect_shape_candidates(const GodotShape3D *p_shape, const ShapeParameters &p_parameters, const Transform3D &p_transform, GodotCollisionObject3D *const *p_candidates, const int *p_candidate_shapes, int p_amount, ShapeResult *r_results, int p_result_max) const {
 	int cc = 0;
 
 	//Transform3D ai = p_xform.affine_inverse();
 
-	for (int i = 0; i < amount; i++) {
+	for (int i = 0; i < p_amount; i++) {
 		if (cc >= p_result_max) {
 			break;
 		}
 
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(p_candidates[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
 		//area can't be picked by ray (default)
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_candidates[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject3D *col_obj = p_candidates[i];
+		int shape_idx = p_candidate_shapes[i];
 
-		if (!GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
+		if (!GodotCollisionSolver3D::solve_static(p_shape, p_transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
 			continue;
 		}
 
@@ -260,6 +269,179 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_par
 	return cc;
 }
 
+// Interleaves the lower 10 bits of p_value with two zero bits each.
+static _FORCE_INLINE_ uint32_t _morton_spread_bits(uint32_t p_value) {
+	uint32_t v = p_value & 0x3ff;
+	v = (v | (v << 16)) & 0x030000ff;
+	v = (v | (v << 8)) & 0x0300f00f;
+	v = (v | (v << 4)) & 0x030c30c3;
+	v = (v | (v << 2)) & 0x09249249;
+	return v;
+}
+
+void GodotPhysicsDirectSpaceState3D::_sort_batch_queries(const Vector3 *p_centers, uint32_t p_count, LocalVector<uint32_t> &r_order) {
+	// Sort the queries along a Morton curve, so that neighboring queries (which end up in
+	// the same chunk) traverse the same BVH nodes and touch the same shapes.
+	struct QueryKey {
+		uint32_t code = 0;
+		uint32_t index = 0;
+
+		bool operator<(const QueryKey &p_other) const {
+			return code == p_other.code ? index < p_other.index : code < p_other.code;
+		}
+	};
+
+	AABB bounds(p_centers[0], Vector3());
+	for (uint32_t i = 1; i < p_count; i++) {
+		bounds.expand_to(p_centers[i]);
+	}
+
+	Vector3 scale;
+	for (int axis = 0; axis < 3; axis++) {
+		scale[axis] = bounds.size[axis] > CMP_EPSILON ? 1023.0 / bounds.size[axis] : 0.0;
+	}
+
+	LocalVector<QueryKey> keys;
+	keys.resize(p_count);
+	for (uint32_t i = 0; i < p_count; i++) {
+		Vector3 cell = (p_centers[i] - bounds.position) * scale;
+		keys[i].code = _morton_spread_bits(uint32_t(cell.x)) | (_morton_spread_bits(uint32_t(cell.y)) << 1) | (_morton_spread_bits(uint32_t(cell.z)) << 2);
+		keys[i].index = i;
+	}
+	keys.sort();
+
+	r_order.resize(p_count);
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_order[i] = keys[i].index;
+	}
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_ray_chunk(uint32_t p_chunk, RayBatch *p_batch) {
+	GodotBroadPhase3D::CullScratch scratch;
+	LocalVector<GodotCollisionObject3D *> candidates;
+	candidates.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	LocalVector<int> candidate_shapes;
+	candidate_shapes.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+
+	uint32_t begin = p_chunk * QUERY_BATCH_CHUNK_SIZE;
+	uint32_t end = MIN(begin + QUERY_BATCH_CHUNK_SIZE, p_batch->count);
+
+	for (uint32_t i = begin; i < end; i++) {
+		uint32_t query = p_batch->order.is_empty() ? i : p_batch->order[i];
+		const Vector3 &from = p_batch->from[query];
+		const Vector3 &to = p_batch->to[query];
+
+		int amount = space->broadphase->cull_segment_concurrent(from, to, candidates.ptr(), GodotSpace3D::INTERSECTION_QUERY_MAX, candidate_shapes.ptr(), scratch);
+		p_batch->hits[query] = _intersect_ray_candidates(*p_batch->parameters, from, to, candidates.ptr(), candidate_shapes.ptr(), amount, p_batch->results[query]);
+	}
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_shape_chunk(uint32_t p_chunk, ShapeBatch *p_batch) {
+	GodotBroadPhase3D::CullScratch scratch;
+	LocalVector<GodotCollisionObject3D *> candidates;
+	candidates.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	LocalVector<int> candidate_shapes;
+	candidate_shapes.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+
+	const AABB shape_aabb = p_batch->shape->get_aabb();
+
+	uint32_t begin = p_chunk * QUERY_BATCH_CHUNK_SIZE;
+	uint32_t end = MIN(begin + QUERY_BATCH_CHUNK_SIZE, p_batch->count);
+
+	for (uint32_t i = begin; i < end; i++) {
+		uint32_t query = p_batch->order.is_empty() ? i : p_batch->order[i];
+		const Transform3D &transform = p_batch->transforms[query];
+
+		int amount = space->broadphase->cull_aabb_concurrent(transform.xform(shape_aabb), candidates.ptr(), GodotSpace3D::INTERSECTION_QUERY_MAX, candidate_shapes.ptr(), scratch);
+		p_batch->result_counts[query] = _intersect_shape_candidates(p_batch->shape, *p_batch->parameters, transform, candidates.ptr(), candidate_shapes.ptr(), amount, &p_batch->results[query * p_batch->result_max], p_batch->result_max);
+	}
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	// Callers read every entry, so they are cleared before anything can fail.
+	for (int i = 0; i < p_count; i++) {
+		r_hits[i] = false;
+	}
+	ERR_FAIL_COND(space->locked);
+	if (p_count <= 0) {
+		return;
+	}
+
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.results = r_results;
+	batch.hits = r_hits;
+	batch.count = p_count;
+
+	uint32_t chunk_count = (batch.count + QUERY_BATCH_CHUNK_SIZE - 1) / QUERY_BATCH_CHUNK_SIZE;
+	if (chunk_count > 1) {
+		LocalVector<Vector3> centers;
+		centers.resize(batch.count);
+		for (uint32_t i = 0; i < batch.count; i++) {
+			centers[i] = (p_from[i] + p_to[i]) * 0.5;
+		}
+		_sort_batch_queries(centers.ptr(), batch.count, batch.order);
+	}
+
+	// Keeps the broadphase from being modified while the chunks are culling from other threads.
+	space->broadphase->begin_concurrent_queries();
+
+	if (chunk_count == 1) {
+		_intersect_ray_chunk(0, &batch);
+	} else {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_ray_chunk, &batch, chunk_count, -1, true, SNAME("GodotPhysicsIntersectRays"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	space->broadphase->end_concurrent_queries();
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_shapes(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) {
+	// Callers read every entry, so they are cleared before anything can fail.
+	for (int i = 0; i < p_count; i++) {
+		r_result_counts[i] = 0;
+	}
+	ERR_FAIL_COND(space->locked);
+	if (p_count <= 0 || p_result_max <= 0) {
+		return;
+	}
+
+	const GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL(shape);
+
+	ShapeBatch batch;
+	batch.parameters = &p_parameters;
+	batch.shape = shape;
+	batch.transforms = p_transforms;
+	batch.results = r_results;
+	batch.result_max = p_result_max;
+	batch.result_counts = r_result_counts;
+	batch.count = p_count;
+
+	uint32_t chunk_count = (batch.count + QUERY_BATCH_CHUNK_SIZE - 1) / QUERY_BATCH_CHUNK_SIZE;
+	if (chunk_count > 1) {
+		LocalVector<Vector3> centers;
+		centers.resize(batch.count);
+		for (uint32_t i = 0; i < batch.count; i++) {
+			centers[i] = p_transforms[i].origin;
+		}
+		_sort_batch_queries(centers.ptr(), batch.count, batch.order);
+	}
+
+	space->broadphase->begin_concurrent_queries();
+
+	if (chunk_count == 1) {
+		_intersect_shape_chunk(0, &batch);
+	} else {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_shape_chunk, &batch, chunk_count, -1, true, SNAME("GodotPhysicsIntersectShapes"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	space->broadphase->end_concurrent_queries();
+}
+
 bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
 	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
 	ERR_FAIL_NULL_V(shape, false);
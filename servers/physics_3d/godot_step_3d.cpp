@@ -41,6 +41,8 @@
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
 
+bool GodotStep3D::solver_body_state_enabled = true;
+
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
 
@@ -112,9 +114,10 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 	}
 }
 
-void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
-	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
-	constraint->setup(delta);
+void GodotStep3D::_setup_constraints(uint32_t p_from, uint32_t p_to, void *p_userdata) {
+	for (uint32_t constraint_index = p_from; constraint_index < p_to; ++constraint_index) {
+		all_constraints[constraint_index]->setup(delta);
+	}
 }
 
 void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const {
@@ -130,17 +133,44 @@ void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constrai
 	p_constraint_island.resize(valid_constraint_count);
 }
 
-void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
+bool GodotStep3D::_bind_island_body_state(uint32_t p_island_index) {
+	const LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
+	GodotSolverBodyState3D &body_state = island_body_states[p_island_index];
+
+	body_state.begin(_step);
+	for (GodotConstraint3D *constraint : constraint_island) {
+		if (!constraint->bind_solver_body_state(body_state)) {
+			// Joints and soft bodies still work on the bodies directly,
+			// so the whole island has to.
+			return false;
+		}
+	}
+	return true;
+}
+
+void GodotStep3D::_solve_island(uint32_t p_island_index) {
 	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
 
 	int current_priority = 1;
 
 	uint32_t constraint_count = constraint_island.size();
+
+	GodotSolverBodyState3D *body_state = nullptr;
+	if (solver_body_state_enabled && constraint_count > 0 && _bind_island_body_state(p_island_index)) {
+		body_state = &island_body_states[p_island_index];
+	}
+
 	while (constraint_count > 0) {
 		for (int i = 0; i < iterations; i++) {
 			// Go through all iterations.
-			for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
-				constraint_island[constraint_index]->solve(delta);
+			if (body_state) {
+				for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+					constraint_island[constraint_index]->solve_body_state(*body_state, delta);
+				}
+			} else {
+				for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+					constraint_island[constraint_index]->solve(delta);
+				}
 			}
 		}
 
@@ -156,6 +186,16 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 		}
 		constraint_count = priority_constraint_count;
 	}
+
+	if (body_state) {
+		body_state->write_back();
+	}
+}
+
+void GodotStep3D::_solve_islands(uint32_t p_from, uint32_t p_to, void *p_userdata) {
+	for (uint32_t island_index = p_from; island_index < p_to; ++island_index) {
+		_solve_island(island_index);
+	}
 }
 
 void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
@@ -344,8 +384,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	WorkerThreadPool::get_singleton()->parallel_for(this, &GodotStep3D::_setup_constraints, (void *)nullptr, 0, total_constraint_count, 0, SNAME("Physics3DConstraintSetup"));
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -362,10 +401,13 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
+	if (island_body_states.size() < island_count) {
+		island_body_states.resize(island_count);
+	}
+
 	// Warning: _solve_island modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	WorkerThreadPool::get_singleton()->parallel_for(this, &GodotStep3D::_solve_islands, (void *)nullptr, 0, island_count, 0, SNAME("Physics3DConstraintSolveIslands"));
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
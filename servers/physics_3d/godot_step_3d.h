@@ -31,11 +31,14 @@
 #ifndef GODOT_STEP_3D_H
 #define GODOT_STEP_3D_H
 
+#include "godot_solver_body_state_3d.h"
 #include "godot_space_3d.h"
 
 #include "core/templates/local_vector.h"
 
 class GodotStep3D {
+	static bool solver_body_state_enabled;
+
 	uint64_t _step = 1;
 
 	int iterations = 0;
@@ -44,15 +47,22 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotBody3D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
+	LocalVector<GodotSolverBodyState3D> island_body_states;
 
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
-	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
+	void _setup_constraints(uint32_t p_from, uint32_t p_to, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
-	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
+	bool _bind_island_body_state(uint32_t p_island_index);
+	void _solve_island(uint32_t p_island_index);
+	void _solve_islands(uint32_t p_from, uint32_t p_to, void *p_userdata = nullptr);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
 public:
+	// Allows solving every island on the bodies directly, to compare against it.
+	static void set_solver_body_state_enabled(bool p_enabled) { solver_body_state_enabled = p_enabled; }
+	static bool is_solver_body_state_enabled() { return solver_body_state_enabled; }
+
 	void step(GodotSpace3D *p_space, real_t p_delta);
 	GodotStep3D();
 	~GodotStep3D();
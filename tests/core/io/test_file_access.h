@@ -31,7 +31,10 @@
 #ifndef TEST_FILE_ACCESS_H
 #define TEST_FILE_ACCESS_H
 
+#include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_compressed.h"
+#include "core/io/file_access_memory.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
 
@@ -107,6 +110,176 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+
+TEST_CASE("[FileAccess] Buffer views") {
+	const uint8_t bytes[] = { 'G', 'o', 'd', 'o', 't', 0 };
+	Ref<FileAccessMemory> fm;
+	fm.instantiate();
+	REQUIRE(fm->open_custom(bytes, sizeof(bytes)) == OK);
+
+	const uint8_t *view = fm->get_buffer_view(3);
+	REQUIRE(view != nullptr);
+	CHECK(view == bytes);
+	CHECK(fm->get_position() == 3);
+	CHECK_MESSAGE(fm->get_buffer_view(4) == nullptr, "Views past the end should not be handed out.");
+	CHECK(fm->get_position() == 3);
+	CHECK(fm->get_8() == 'o');
+
+	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("line_endings_lf.test.txt"), FileAccess::READ);
+	REQUIRE(!f.is_null());
+	CHECK_MESSAGE(f->get_buffer_view(5) == nullptr, "Regular files don't hand out views.");
+	const uint8_t *mapped = f->map_read_only();
+	if (mapped) {
+		CHECK(memcmp(mapped, "Hello darkness", 14) == 0);
+		CHECK(f->map_read_only() == mapped);
+	}
+}
+
+struct CompressedReadFromTask {
+	Ref<FileAccess> file;
+	Vector<uint8_t> read;
+};
+
+static void _read_compressed_from_task(void *p_userdata) {
+	CompressedReadFromTask *task_data = (CompressedReadFromTask *)p_userdata;
+	task_data->file->seek(0);
+	task_data->read = task_data->file->get_buffer(task_data->file->get_length());
+	task_data->file.unref();
+}
+
+TEST_CASE("[FileAccess] Storing compact variants") {
+	const String path = TestUtils::get_temp_path("compact_vars.bin");
+	Array entries;
+	for (int i = 0; i < 100; i++) {
+		Dictionary entry;
+		entry["name"] = "enemy";
+		entry["health"] = i;
+		entries.push_back(entry);
+	}
+
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	CHECK_FALSE(f->is_compact_vars());
+	f->store_var(entries);
+	const uint64_t regular_size = f->get_position();
+	f->set_compact_vars(true);
+	f->store_var(entries);
+	const uint64_t compact_size = f->get_position() - regular_size;
+	CHECK(compact_size < regular_size);
+	f.unref();
+
+	// Reading doesn't depend on the setting, both encodings are recognized.
+	f = FileAccess::open(path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_var() == Variant(entries));
+	CHECK(f->get_var() == Variant(entries));
+	CHECK(f->get_position() == regular_size + compact_size);
+	f.unref();
+
+	DirAccess::remove_absolute(path);
+}
+
+TEST_CASE("[FileAccess] Compressed file with read-ahead") {
+	const String path = TestUtils::get_temp_path("compressed_read_ahead.bin");
+	// Several streaming blocks plus a partial one, so reads cross block boundaries.
+	const uint32_t size = FileAccessCompressed::STREAMING_BLOCK_SIZE * 5 + 1234;
+
+	Vector<uint8_t> data;
+	data.resize(size);
+	for (uint32_t i = 0; i < size; i++) {
+		data.write[i] = (i * 7 + (i >> 9)) & 0xFF;
+	}
+
+	{
+		Ref<FileAccess> f = FileAccess::open_compressed(path, FileAccess::WRITE, FileAccess::COMPRESSION_ZSTD);
+		REQUIRE(f.is_valid());
+		f->store_buffer(data);
+	}
+
+	Ref<FileAccess> f = FileAccess::open_compressed(path, FileAccess::READ, FileAccess::COMPRESSION_ZSTD);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() == size);
+
+	Vector<uint8_t> read = f->get_buffer(size);
+	CHECK(read == data);
+	CHECK_FALSE(f->eof_reached());
+	CHECK(f->get_8() == 0);
+	CHECK(f->eof_reached());
+
+	// Seek back and forth, both into blocks read ahead and blocks already evicted.
+	const uint64_t positions[] = { 3, FileAccessCompressed::STREAMING_BLOCK_SIZE * 4 + 17, FileAccessCompressed::STREAMING_BLOCK_SIZE - 2, FileAccessCompressed::STREAMING_BLOCK_SIZE * 2 + 5, size - 10 };
+	for (uint64_t position : positions) {
+		f->seek(position);
+		CHECK(f->get_position() == position);
+		CHECK(f->get_8() == data[position]);
+		uint8_t chunk[8];
+		CHECK(f->get_buffer(chunk, 8) == 8);
+		CHECK(memcmp(chunk, data.ptr() + position + 1, 8) == 0);
+	}
+
+	// Blocks prefetched from this thread are older than a pool task reading the file, which can't wait on them.
+	f->seek(0);
+	CompressedReadFromTask task_data;
+	task_data.file = f;
+	f.unref();
+	WorkerThreadPool::TaskID task_id = WorkerThreadPool::get_singleton()->add_native_task(&_read_compressed_from_task, &task_data);
+	CHECK(WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id) == OK);
+	CHECK(task_data.read == data);
+
+	DirAccess::remove_absolute(path);
+}
+
+static void _count_async_read(void *p_userdata, uint64_t p_read) {
+	((SafeNumeric<uint64_t> *)p_userdata)->add(p_read);
+}
+
+TEST_CASE("[FileAccess] Asynchronous reads") {
+	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("line_endings_lf.test.txt"), FileAccess::READ);
+	REQUIRE(!f.is_null());
+	f->seek(6);
+
+	uint8_t first[5] = {};
+	uint8_t second[6] = {};
+	SafeNumeric<uint64_t> total;
+
+	FileAccess::AsyncRead reads[2];
+	reads[0].position = 0;
+	reads[0].dst = first;
+	reads[0].length = 5;
+	reads[0].callback = &_count_async_read;
+	reads[0].userdata = &total;
+	reads[1].position = 15;
+	reads[1].dst = second;
+	reads[1].length = 6;
+	reads[1].callback = &_count_async_read;
+	reads[1].userdata = &total;
+
+	FileAccess::AsyncReadID ids[2];
+	for (int i = 0; i < 2; i++) {
+		ids[i] = f->read_async(reads[i]);
+	}
+	// Polling doesn't release the reads, they still have to be waited on.
+	while (!FileAccess::is_async_read_completed(ids[0]) || !FileAccess::is_async_read_completed(ids[1])) {
+		OS::get_singleton()->delay_usec(1);
+	}
+	CHECK(total.get() == 11);
+	for (int i = 0; i < 2; i++) {
+		CHECK(FileAccess::wait_async_read(ids[i]) == OK);
+	}
+	CHECK(memcmp(first, "Hello", 5) == 0);
+	CHECK(memcmp(second, "My old", 6) == 0);
+	CHECK_MESSAGE(f->get_position() == 6, "Asynchronous reads should not move the cursor.");
+
+	uint8_t past_end[4] = {};
+	FileAccess::AsyncRead read;
+	read.position = f->get_length() - 2;
+	read.dst = past_end;
+	read.length = 4;
+	read.callback = &_count_async_read;
+	read.userdata = &total;
+	CHECK(FileAccess::wait_async_read(f->read_async(read)) == OK);
+	CHECK(total.get() == 13);
+}
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
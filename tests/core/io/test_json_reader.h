@@ -0,0 +1,295 @@
+/**************************************************************************/
+/*  test_json_reader.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_JSON_READER_H
+#define TEST_JSON_READER_H
+
+#include "core/io/dir_access.h"
+#include "core/io/json.h"
+#include "core/io/json_reader.h"
+#include "core/io/json_writer.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestJSONReader {
+
+static Array make_array(std::initializer_list<Variant> p_values) {
+	Array array;
+	for (const Variant &value : p_values) {
+		array.push_back(value);
+	}
+	return array;
+}
+
+static Ref<JSONReader> open_text(const String &p_text) {
+	Ref<JSONReader> reader;
+	reader.instantiate();
+	reader->open_buffer(p_text.to_utf8_buffer());
+	return reader;
+}
+
+TEST_CASE("[JSONReader] Events") {
+	Ref<JSONReader> reader = open_text(R"({"a": [1, -2.5e3, "x\u00e9"], "b": {"c": true, "d": null}, "e": {}})");
+
+	const JSONReader::EventType expected[] = {
+		JSONReader::EVENT_OBJECT_BEGIN,
+		JSONReader::EVENT_KEY,
+		JSONReader::EVENT_ARRAY_BEGIN,
+		JSONReader::EVENT_NUMBER,
+		JSONReader::EVENT_NUMBER,
+		JSONReader::EVENT_STRING,
+		JSONReader::EVENT_ARRAY_END,
+		JSONReader::EVENT_KEY,
+		JSONReader::EVENT_OBJECT_BEGIN,
+		JSONReader::EVENT_KEY,
+		JSONReader::EVENT_BOOL,
+		JSONReader::EVENT_KEY,
+		JSONReader::EVENT_NULL,
+		JSONReader::EVENT_OBJECT_END,
+		JSONReader::EVENT_KEY,
+		JSONReader::EVENT_OBJECT_BEGIN,
+		JSONReader::EVENT_OBJECT_END,
+		JSONReader::EVENT_OBJECT_END,
+	};
+
+	for (int i = 0; i < int(std::size(expected)); i++) {
+		REQUIRE(reader->read() == OK);
+		CHECK(reader->get_event_type() == expected[i]);
+		if (i == 3) {
+			CHECK(reader->is_integer());
+			CHECK(reader->get_int() == 1);
+			CHECK(reader->get_depth() == 2);
+		} else if (i == 4) {
+			CHECK_FALSE(reader->is_integer());
+			CHECK(reader->get_float() == doctest::Approx(-2500.0));
+		} else if (i == 5) {
+			CHECK(reader->get_string() == String::utf8("x\xc3\xa9"));
+		} else if (i == 10) {
+			CHECK(reader->get_bool());
+		}
+	}
+	CHECK(reader->get_depth() == 0);
+	CHECK(reader->read() == ERR_FILE_EOF);
+	CHECK(reader->get_event_type() == JSONReader::EVENT_NONE);
+}
+
+TEST_CASE("[JSONReader] Integers") {
+	Ref<JSONReader> reader = open_text("[9223372036854775807, -9223372036854775808, 9223372036854775808]");
+	REQUIRE(reader->read() == OK);
+
+	REQUIRE(reader->read() == OK);
+	CHECK(reader->is_integer());
+	CHECK(reader->get_int() == INT64_MAX);
+
+	REQUIRE(reader->read() == OK);
+	CHECK(reader->is_integer());
+	CHECK(reader->get_int() == INT64_MIN);
+
+	// Out of range, only available as a float.
+	REQUIRE(reader->read() == OK);
+	CHECK_FALSE(reader->is_integer());
+	CHECK(reader->get_float() == doctest::Approx(9223372036854775808.0));
+
+	// A single zero is still allowed before a fraction or an exponent.
+	reader = open_text("[0, -0, 0.5, 0e2]");
+	REQUIRE(reader->read() == OK);
+	for (int i = 0; i < 4; i++) {
+		REQUIRE(reader->read() == OK);
+		CHECK(reader->get_float() == doctest::Approx(i == 2 ? 0.5 : 0.0));
+	}
+}
+
+TEST_CASE("[JSONReader] Skipping and reading values") {
+	Ref<JSONReader> reader = open_text(R"({"skip": {"deep": [[1, "]"], {"}": 2}]}, "keep": {"x": [1, 2], "y": "z"}, "last": 3})");
+
+	REQUIRE(reader->read() == OK);
+	REQUIRE(reader->read() == OK);
+	CHECK(reader->get_string() == "skip");
+	CHECK(reader->skip() == OK);
+	CHECK(reader->get_event_type() == JSONReader::EVENT_OBJECT_END);
+	CHECK(reader->get_depth() == 1);
+
+	REQUIRE(reader->read() == OK);
+	CHECK(reader->get_string() == "keep");
+	Variant value;
+	CHECK(reader->read_value(value) == OK);
+	CHECK(value == JSON::parse_string(R"({"x": [1, 2], "y": "z"})"));
+
+	REQUIRE(reader->read() == OK);
+	CHECK(reader->get_string() == "last");
+	REQUIRE(reader->read() == OK);
+	CHECK(reader->get_int() == 3);
+	REQUIRE(reader->read() == OK);
+	CHECK(reader->get_event_type() == JSONReader::EVENT_OBJECT_END);
+}
+
+TEST_CASE("[JSONReader] Consecutive documents") {
+	Ref<JSONReader> reader = open_text("{\"a\": 1}\n{\"a\": 2}\n[]\n");
+	Array documents;
+	while (reader->read() == OK) {
+		Variant value;
+		REQUIRE(reader->read_value(value) == OK);
+		documents.push_back(value);
+	}
+	CHECK(reader->get_error_message().is_empty());
+	REQUIRE(documents.size() == 3);
+	CHECK(documents[1] == JSON::parse_string("{\"a\": 2}"));
+	CHECK(documents[2] == Array());
+}
+
+TEST_CASE("[JSONReader] Invalid data") {
+	const char *invalid[] = {
+		"[1, 2",
+		"[1,]",
+		"{\"a\" 1}",
+		"{1: 2}",
+		"[01x]",
+		"[007]",
+		"[-01.5]",
+		"[1.]",
+		"[nul]",
+		"\"unterminated",
+		"[1 2]",
+		"{\"a\": 1]",
+	};
+
+	for (const char *text : invalid) {
+		Ref<JSONReader> reader = open_text(text);
+		Error err = OK;
+		while (err == OK) {
+			err = reader->read();
+		}
+		CHECK_MESSAGE(err == ERR_PARSE_ERROR, text);
+		CHECK_FALSE(reader->get_error_message().is_empty());
+		CHECK(reader->get_error_line() == 1);
+		// Errors are sticky.
+		CHECK(reader->read() == ERR_PARSE_ERROR);
+	}
+}
+
+TEST_CASE("[JSONReader] Reading a file across chunks") {
+	Array data;
+	for (int i = 0; i < 5000; i++) {
+		Dictionary entry;
+		entry["id"] = i;
+		entry["name"] = vformat(String::utf8("entry \"%d\" \xc3\xa9\xe4\xb8\xad"), i);
+		entry["position"] = make_array({ i * 0.5, -i, 1e-3 });
+		data.push_back(entry);
+	}
+
+	const String path = TestUtils::get_temp_path("json_reader_chunks.json");
+	Ref<JSONWriter> writer;
+	writer.instantiate();
+	REQUIRE(writer->open(path) == OK);
+	writer->set_indent("\t");
+	CHECK(writer->write_value(data) == OK);
+	CHECK(writer->close() == OK);
+
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() > JSONReader::READ_CHUNK_SIZE * 2);
+	const Variant expected = JSON::parse_string(f->get_as_utf8_string());
+	f.unref();
+	CHECK(expected == JSON::parse_string(JSON::stringify(data)));
+
+	Ref<JSONReader> reader;
+	reader.instantiate();
+	REQUIRE(reader->open(path) == OK);
+	REQUIRE(reader->read() == OK);
+	Variant value;
+	CHECK(reader->read_value(value) == OK);
+	CHECK(value == expected);
+	CHECK(reader->read() == ERR_FILE_EOF);
+
+	DirAccess::remove_absolute(path);
+}
+
+TEST_CASE_BENCHMARK("[JSONReader][Benchmark] Streaming against whole document parsing") {
+	Array data;
+	for (int i = 0; i < 200000; i++) {
+		Dictionary entry;
+		entry["id"] = i;
+		entry["name"] = vformat("entry %d", i);
+		entry["position"] = make_array({ i * 0.5, -i, 1e-3 });
+		data.push_back(entry);
+	}
+	const String path = TestUtils::get_temp_path("json_reader_benchmark.json");
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(JSON::stringify(data, "\t"));
+	}
+	const uint64_t stringify_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	{
+		Ref<JSONWriter> writer;
+		writer.instantiate();
+		REQUIRE(writer->open(path) == OK);
+		writer->set_indent("\t");
+		CHECK(writer->write_value(data) == OK);
+		CHECK(writer->close() == OK);
+	}
+	const uint64_t writer_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	Variant parsed;
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+		parsed = JSON::parse_string(f->get_as_utf8_string());
+	}
+	const uint64_t parse_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	Variant streamed;
+	{
+		Ref<JSONReader> reader;
+		reader.instantiate();
+		REQUIRE(reader->open(path) == OK);
+		REQUIRE(reader->read() == OK);
+		CHECK(reader->read_value(streamed) == OK);
+	}
+	const uint64_t reader_time = OS::get_singleton()->get_ticks_usec() - begin;
+	CHECK(streamed == parsed);
+
+	MESSAGE(vformat("Writing: %.1f ms with JSON.stringify(), %.1f ms with JSONWriter.", stringify_time / 1000.0, writer_time / 1000.0).utf8().get_data());
+	MESSAGE(vformat("Reading: %.1f ms with JSON.parse_string(), %.1f ms with JSONReader.", parse_time / 1000.0, reader_time / 1000.0).utf8().get_data());
+
+	DirAccess::remove_absolute(path);
+}
+
+} // namespace TestJSONReader
+
+#endif // TEST_JSON_READER_H
@@ -0,0 +1,146 @@
+/**************************************************************************/
+/*  test_json_writer.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_JSON_WRITER_H
+#define TEST_JSON_WRITER_H
+
+#include "core/io/json.h"
+#include "core/io/json_writer.h"
+#include "core/io/stream_peer.h"
+
+#include "tests/test_macros.h"
+
+namespace TestJSONWriter {
+
+static Array make_array(std::initializer_list<Variant> p_values) {
+	Array array;
+	for (const Variant &value : p_values) {
+		array.push_back(value);
+	}
+	return array;
+}
+
+static String written_text(const Ref<StreamPeerBuffer> &p_stream) {
+	Vector<uint8_t> data = p_stream->get_data_array();
+	return String::utf8((const char *)data.ptr(), data.size());
+}
+
+TEST_CASE("[JSONWriter] Writing events") {
+	Ref<StreamPeerBuffer> stream;
+	stream.instantiate();
+	Ref<JSONWriter> writer;
+	writer.instantiate();
+	REQUIRE(writer->open_stream(stream) == OK);
+
+	CHECK(writer->begin_object() == OK);
+	CHECK(writer->write_key("name") == OK);
+	CHECK(writer->write_string("a \"quoted\"\nline") == OK);
+	CHECK(writer->write_key("values") == OK);
+	CHECK(writer->begin_array() == OK);
+	CHECK(writer->write_int(-12) == OK);
+	CHECK(writer->write_float(0.5) == OK);
+	CHECK(writer->write_bool(false) == OK);
+	CHECK(writer->write_null() == OK);
+	CHECK(writer->begin_array() == OK);
+	CHECK(writer->end_array() == OK);
+	CHECK(writer->end_array() == OK);
+	CHECK(writer->end_object() == OK);
+	CHECK(writer->close() == OK);
+
+	CHECK(written_text(stream) == R"({"name":"a \"quoted\"\nline","values":[-12,0.5,false,null,[]]})");
+}
+
+TEST_CASE("[JSONWriter] Matches JSON.stringify") {
+	Dictionary inner;
+	inner["z"] = 1;
+	inner["a"] = make_array({ "x", 2.25, Variant() });
+	Dictionary data;
+	data["list"] = make_array({ inner, PackedInt32Array({ 1, 2, 3 }), true });
+	data["text"] = String::utf8("\xc3\xa9t\xc3\xa9");
+	data["number"] = 123456789.125;
+	data["empty_object"] = Dictionary();
+	data["empty_list"] = make_array({ Array(), Dictionary() });
+
+	for (const String &indent : { String(), String("\t"), String("  ") }) {
+		Ref<StreamPeerBuffer> stream;
+		stream.instantiate();
+		Ref<JSONWriter> writer;
+		writer.instantiate();
+		writer->set_indent(indent);
+		REQUIRE(writer->open_stream(stream) == OK);
+		CHECK(writer->write_value(data) == OK);
+		CHECK(writer->close() == OK);
+
+		CHECK(written_text(stream) == JSON::stringify(data, indent));
+	}
+}
+
+TEST_CASE("[JSONWriter] Invalid sequences") {
+	Ref<StreamPeerBuffer> stream;
+	stream.instantiate();
+	Ref<JSONWriter> writer;
+	writer.instantiate();
+
+	ERR_PRINT_OFF;
+	CHECK(writer->write_int(1) == ERR_UNCONFIGURED);
+
+	REQUIRE(writer->open_stream(stream) == OK);
+	CHECK(writer->write_key("a") == ERR_INVALID_PARAMETER);
+	CHECK(writer->begin_object() == OK);
+	CHECK(writer->write_int(1) == ERR_INVALID_PARAMETER);
+	CHECK(writer->end_array() == ERR_INVALID_PARAMETER);
+	CHECK(writer->write_key("a") == OK);
+	CHECK(writer->write_key("b") == ERR_INVALID_PARAMETER);
+	CHECK(writer->end_object() == ERR_INVALID_PARAMETER);
+	CHECK(writer->close() == ERR_INVALID_DATA);
+
+	Array circular;
+	circular.push_back(circular);
+	REQUIRE(writer->open_stream(stream) == OK);
+	CHECK(writer->write_value(circular) == ERR_INVALID_PARAMETER);
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[JSONWriter] Consecutive documents") {
+	Ref<StreamPeerBuffer> stream;
+	stream.instantiate();
+	Ref<JSONWriter> writer;
+	writer.instantiate();
+	REQUIRE(writer->open_stream(stream) == OK);
+	CHECK(writer->write_value(make_array({ 1 })) == OK);
+	CHECK(writer->write_value(make_array({ 2 })) == OK);
+	CHECK(writer->close() == OK);
+
+	CHECK(written_text(stream) == "[1]\n[2]");
+}
+
+} // namespace TestJSONWriter
+
+#endif // TEST_JSON_WRITER_H
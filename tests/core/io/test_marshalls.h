@@ -32,6 +32,7 @@
 #define TEST_MARSHALLS_H
 
 #include "core/io/marshalls.h"
+#include "core/os/os.h"
 
 #include "tests/test_macros.h"
 
@@ -386,6 +387,289 @@ TEST_CASE("[Marshalls] Typed array decoding") {
 	CHECK(array[0] == Variant(uint64_t(0x0f123456789abcdef)));
 }
 
+static Vector<uint8_t> encode_to_bytes(const Variant &p_variant, bool p_compact = false) {
+	int len = 0;
+	Vector<uint8_t> bytes;
+	if (encode_variant(p_variant, nullptr, len, false, 0, p_compact) != OK) {
+		return bytes;
+	}
+	bytes.resize(len);
+	int written = 0;
+	encode_variant(p_variant, bytes.ptrw(), written, false, 0, p_compact);
+	CHECK_MESSAGE(written == len, "Measuring and writing should agree on the encoded size.");
+	return bytes;
+}
+
+TEST_CASE("[Marshalls] Packed array round trip") {
+	PackedInt32Array ints = { 1, -2, 0x7fffffff, -0x7fffffff };
+	PackedInt64Array longs = { 1, -2, 0x0123456789abcdef };
+	PackedFloat32Array floats = { 0.5, -1.25, 1e10 };
+	PackedFloat64Array doubles = { 0.1, -1e300, 3.0 };
+	PackedVector3Array vectors = { Vector3(1, 2, 3), Vector3(-4, 5.5, 0) };
+	PackedColorArray colors = { Color(1, 0, 0, 0.5), Color(0.25, 0.5, 0.75, 1) };
+	PackedByteArray bytes = { 1, 2, 3, 4, 5 };
+
+	const Variant values[] = { ints, longs, floats, doubles, vectors, colors, bytes };
+	for (const Variant &value : values) {
+		Vector<uint8_t> encoded = encode_to_bytes(value);
+		Variant decoded;
+		int r_len = 0;
+		CHECK(decode_variant(decoded, encoded.ptr(), encoded.size(), &r_len) == OK);
+		CHECK(r_len == encoded.size());
+		CHECK(decoded == value);
+	}
+
+	// Elements are little-endian regardless of the host.
+	Vector<uint8_t> encoded = encode_to_bytes(PackedInt32Array({ 0x01020304 }));
+	REQUIRE(encoded.size() == 12);
+	CHECK(encoded[8] == 0x04);
+	CHECK(encoded[9] == 0x03);
+	CHECK(encoded[10] == 0x02);
+	CHECK(encoded[11] == 0x01);
+}
+
+TEST_CASE("[Marshalls] Measuring strings") {
+	Array array;
+	array.push_back("");
+	array.push_back("abc");
+	array.push_back(String::utf8("\xc3\xa9t\xc3\xa9"));
+	array.push_back(String::utf8("\xf0\x9f\x98\x80"));
+	array.push_back(StringName("name"));
+	array.push_back(PackedStringArray({ "a", String::utf8("\xe2\x82\xac") }));
+
+	int len = 0;
+	CHECK(encode_variant(array, nullptr, len) == OK);
+	Vector<uint8_t> buffer;
+	buffer.resize(len);
+	int written = 0;
+	CHECK(encode_variant(array, buffer.ptrw(), written) == OK);
+	CHECK(written == len);
+
+	Variant decoded;
+	CHECK(decode_variant(decoded, buffer.ptr(), buffer.size()) == OK);
+	CHECK(decoded == array);
+}
+
+TEST_CASE("[Marshalls] Compact encoding deduplicates strings") {
+	Array entries;
+	for (int i = 0; i < 8; i++) {
+		Dictionary entry;
+		entry["position"] = Vector2(i, i);
+		entry["name"] = "enemy";
+		entry[StringName("health")] = i * 10;
+		entries.push_back(entry);
+	}
+
+	Vector<uint8_t> regular = encode_to_bytes(entries);
+	Vector<uint8_t> compact = encode_to_bytes(entries, true);
+	CHECK(compact.size() < regular.size());
+
+	Variant decoded;
+	int r_len = 0;
+	CHECK(decode_variant(decoded, compact.ptr(), compact.size(), &r_len) == OK);
+	CHECK(r_len == compact.size());
+	CHECK(decoded == entries);
+
+	// References keep the type they were encoded with.
+	Dictionary last = Array(decoded)[7];
+	Array keys = last.keys();
+	CHECK(keys.size() == 3);
+	for (int i = 0; i < keys.size(); i++) {
+		CHECK(keys[i].get_type() == (keys[i] == Variant("health") ? Variant::STRING_NAME : Variant::STRING));
+	}
+}
+
+TEST_CASE("[Marshalls] Compact encoding of builtin typed arrays") {
+	Array vectors;
+	vectors.set_typed(Variant::VECTOR3, StringName(), Ref<Script>());
+	Array ints;
+	ints.set_typed(Variant::INT, StringName(), Ref<Script>());
+	for (int i = 0; i < 16; i++) {
+		vectors.push_back(Vector3(i, -i, 0.5));
+		ints.push_back(int64_t(i) << 40);
+	}
+
+	Vector<uint8_t> encoded = encode_to_bytes(vectors, true);
+	// Header, array type and size, then the components without per-element headers.
+	CHECK(encoded.size() == 12 + 16 * 3 * int(sizeof(real_t)));
+	Variant decoded;
+	CHECK(decode_variant(decoded, encoded.ptr(), encoded.size()) == OK);
+	CHECK(Array(decoded).get_typed_builtin() == Variant::VECTOR3);
+	CHECK(decoded == vectors);
+
+	encoded = encode_to_bytes(ints, true);
+	CHECK(encoded.size() == 12 + 16 * 8);
+	CHECK(decode_variant(decoded, encoded.ptr(), encoded.size()) == OK);
+	CHECK(Array(decoded).get_typed_builtin() == Variant::INT);
+	CHECK(decoded == ints);
+
+	// Types without a fixed size still go through the regular encoding.
+	Array strings;
+	strings.set_typed(Variant::STRING, StringName(), Ref<Script>());
+	strings.push_back("a");
+	strings.push_back("a");
+	encoded = encode_to_bytes(strings, true);
+	CHECK(decode_variant(decoded, encoded.ptr(), encoded.size()) == OK);
+	CHECK(decoded == strings);
+}
+
+TEST_CASE("[Marshalls] Invalid compact data decoding") {
+	Variant variant;
+	uint8_t dangling_reference[8] = {
+		0x04, 0x00, 0x02, 0x00, // Variant::STRING, HEADER_DATA_FLAG_STRING_REF
+		0x00, 0x00, 0x00, 0x00, // Index into an empty string table.
+	};
+	uint8_t truncated_array[16] = {
+		0x1c, 0x00, 0x05, 0x00, // Variant::ARRAY, HEADER_DATA_FIELD_TYPED_ARRAY_BUILTIN, HEADER_DATA_FLAG_ARRAY_PACKED
+		0x02, 0x00, 0x00, 0x00, // Array type (Variant::INT).
+		0x02, 0x00, 0x00, 0x00, // Array size, but only room for one element.
+		0x00, 0x00, 0x00, 0x00,
+	};
+	uint8_t huge_array[8] = {
+		0x1c, 0x00, 0x00, 0x00, // Variant::ARRAY
+		0xff, 0xff, 0xff, 0x7f, // Array size.
+	};
+
+	ERR_PRINT_OFF;
+	CHECK(decode_variant(variant, dangling_reference, 8) == ERR_INVALID_DATA);
+	CHECK(decode_variant(variant, truncated_array, 16) == ERR_INVALID_DATA);
+	CHECK(decode_variant(variant, huge_array, 8) == ERR_INVALID_DATA);
+	ERR_PRINT_ON;
+}
+
+// The element-by-element loops encode_variant() and decode_variant() used for packed arrays
+// before whole arrays were copied at once. They are kept as the baseline for the benchmark below.
+static Vector<uint8_t> encode_per_element(const PackedFloat32Array &p_array) {
+	Vector<uint8_t> bytes;
+	bytes.resize(8 + p_array.size() * 4);
+	uint8_t *buf = bytes.ptrw();
+	encode_uint32(Variant::PACKED_FLOAT32_ARRAY, buf);
+	encode_uint32(p_array.size(), buf + 4);
+	buf += 8;
+	const float *r = p_array.ptr();
+	for (int i = 0; i < p_array.size(); i++) {
+		encode_float(r[i], &buf[i * 4]);
+	}
+	return bytes;
+}
+
+static Vector<uint8_t> encode_per_element(const PackedVector3Array &p_array) {
+	Vector<uint8_t> bytes;
+	bytes.resize(8 + p_array.size() * sizeof(real_t) * 3);
+	uint8_t *buf = bytes.ptrw();
+	// Double-precision builds mark the header with HEADER_DATA_FLAG_64.
+#ifdef REAL_T_IS_DOUBLE
+	encode_uint32(Variant::PACKED_VECTOR3_ARRAY | (1 << 16), buf);
+#else
+	encode_uint32(Variant::PACKED_VECTOR3_ARRAY, buf);
+#endif
+	encode_uint32(p_array.size(), buf + 4);
+	buf += 8;
+	for (int i = 0; i < p_array.size(); i++) {
+		Vector3 v = p_array.get(i);
+		encode_real(v.x, &buf[0]);
+		encode_real(v.y, &buf[sizeof(real_t)]);
+		encode_real(v.z, &buf[sizeof(real_t) * 2]);
+		buf += sizeof(real_t) * 3;
+	}
+	return bytes;
+}
+
+static Variant decode_per_element(Variant::Type p_type, const Vector<uint8_t> &p_bytes) {
+	const uint8_t *buf = p_bytes.ptr() + 8;
+	const int count = decode_uint32(p_bytes.ptr() + 4);
+	if (p_type == Variant::PACKED_FLOAT32_ARRAY) {
+		PackedFloat32Array data;
+		data.resize(count);
+		float *w = data.ptrw();
+		for (int i = 0; i < count; i++) {
+			w[i] = decode_float(&buf[i * 4]);
+		}
+		return data;
+	}
+	PackedVector3Array data;
+	data.resize(count);
+	Vector3 *w = data.ptrw();
+	for (int i = 0; i < count; i++) {
+#ifdef REAL_T_IS_DOUBLE
+		w[i] = Vector3(decode_double(&buf[0]), decode_double(&buf[8]), decode_double(&buf[16]));
+#else
+		w[i] = Vector3(decode_float(&buf[0]), decode_float(&buf[4]), decode_float(&buf[8]));
+#endif
+		buf += sizeof(real_t) * 3;
+	}
+	return data;
+}
+
+TEST_CASE_BENCHMARK("[Marshalls][Benchmark] Variant encoding throughput") {
+	PackedFloat32Array floats;
+	PackedVector3Array points;
+	for (int i = 0; i < 1000000; i++) {
+		floats.push_back(i * 0.25);
+	}
+	for (int i = 0; i < 250000; i++) {
+		points.push_back(Vector3(i, -i, i * 0.5));
+	}
+
+	// Packed arrays: the previous element-by-element path against encode_variant() and decode_variant().
+	const Variant packed[] = { floats, points };
+	const char *packed_names[] = { "PackedFloat32Array", "PackedVector3Array" };
+	for (int i = 0; i < 2; i++) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		Vector<uint8_t> baseline = i == 0 ? encode_per_element(floats) : encode_per_element(points);
+		const uint64_t baseline_encode_time = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		Variant baseline_decoded = decode_per_element(packed[i].get_type(), baseline);
+		const uint64_t baseline_decode_time = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+		CHECK(baseline_decoded == packed[i]);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		Vector<uint8_t> bytes = encode_to_bytes(packed[i]);
+		const uint64_t encode_time = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+		CHECK_MESSAGE(bytes == baseline, "The wire format of packed arrays should not change.");
+
+		Variant decoded;
+		begin = OS::get_singleton()->get_ticks_usec();
+		CHECK(decode_variant(decoded, bytes.ptr(), bytes.size()) == OK);
+		const uint64_t decode_time = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+		CHECK(decoded == packed[i]);
+
+		MESSAGE(vformat("%s: %d bytes, encoded at %.1f MB/s (per element: %.1f MB/s), decoded at %.1f MB/s (per element: %.1f MB/s).", packed_names[i], bytes.size(), bytes.size() / double(encode_time), bytes.size() / double(baseline_encode_time), bytes.size() / double(decode_time), bytes.size() / double(baseline_decode_time)).utf8().get_data());
+	}
+
+	// Containers: the regular encoding against compact mode, which only changes strings and typed arrays.
+	Array entries;
+	Array positions;
+	positions.set_typed(Variant::VECTOR3, StringName(), Ref<Script>());
+	for (int i = 0; i < 50000; i++) {
+		Dictionary entry;
+		entry["position"] = Vector2(i, i);
+		entry["name"] = "enemy";
+		entry["health"] = i;
+		entries.push_back(entry);
+		positions.push_back(Vector3(i, -i, i * 0.5));
+	}
+
+	const Variant containers[] = { entries, positions };
+	const char *container_names[] = { "Array of Dictionary", "Array[Vector3]" };
+	for (int i = 0; i < 2; i++) {
+		for (int compact = 0; compact < 2; compact++) {
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			Vector<uint8_t> bytes = encode_to_bytes(containers[i], compact);
+			const uint64_t encode_time = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+
+			Variant decoded;
+			begin = OS::get_singleton()->get_ticks_usec();
+			CHECK(decode_variant(decoded, bytes.ptr(), bytes.size()) == OK);
+			const uint64_t decode_time = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+			CHECK(decoded == containers[i]);
+
+			MESSAGE(vformat("%s%s: %d bytes, encoded at %.1f MB/s, decoded at %.1f MB/s.", container_names[i], compact ? " (compact)" : "", bytes.size(), bytes.size() / double(encode_time), bytes.size() / double(decode_time)).utf8().get_data());
+		}
+	}
+}
+
 } // namespace TestMarshalls
 
 #endif // TEST_MARSHALLS_H
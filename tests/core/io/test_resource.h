@@ -34,6 +34,7 @@
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #include "thirdparty/doctest/doctest.h"
@@ -166,6 +167,162 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	// Break circular reference to avoid memory leak
 	resource_c->remove_meta("next");
 }
+
+TEST_CASE("[Resource] Memory usage estimate") {
+	Ref<Resource> resource = memnew(Resource);
+	const uint64_t empty_size = resource->get_memory_usage_estimate();
+
+	PackedByteArray data;
+	data.resize(4096);
+	resource->set_meta("data", data);
+	CHECK_MESSAGE(
+			resource->get_memory_usage_estimate() >= empty_size + 4096,
+			"The estimate should account for stored packed arrays.");
+
+	Ref<Resource> child_resource = memnew(Resource);
+	child_resource->set_meta("data", data);
+	resource->set_meta("child", child_resource);
+	CHECK_MESSAGE(
+			resource->get_memory_usage_estimate() >= empty_size + 8192,
+			"The estimate should include built-in sub-resources.");
+
+	// A cycle between built-in resources must not be counted twice nor recurse forever.
+	child_resource->set_meta("parent", resource);
+	const uint64_t cyclic_size = resource->get_memory_usage_estimate();
+	CHECK(cyclic_size >= empty_size + 8192);
+	CHECK(cyclic_size < empty_size + 3 * 4096);
+	child_resource->remove_meta("parent");
+}
+
+TEST_CASE("[Resource] Retained resource cache") {
+	PackedByteArray data;
+	data.resize(4096);
+
+	const String path_a = TestUtils::get_temp_path("retained_a.res");
+	const String path_b = TestUtils::get_temp_path("retained_b.res");
+	{
+		Ref<Resource> resource = memnew(Resource);
+		resource->set_meta("data", data);
+		ResourceSaver::save(resource, path_a);
+		ResourceSaver::save(resource, path_b);
+	}
+
+	ResourceCache::clear_retained();
+	ResourceCache::set_retained_budget(1024 * 1024);
+	const uint64_t hits = ResourceCache::get_retained_hits();
+	const uint64_t misses = ResourceCache::get_retained_misses();
+	const uint64_t evictions = ResourceCache::get_retained_evictions();
+
+	SUBCASE("Released resources stay loaded") {
+		ObjectID first_id;
+		{
+			Ref<Resource> loaded = ResourceLoader::load(path_a);
+			REQUIRE(loaded.is_valid());
+			first_id = loaded->get_instance_id();
+		}
+		CHECK(ResourceCache::get_retained_misses() == misses + 1);
+		CHECK(ResourceCache::get_retained_count() == 1);
+		CHECK(ResourceCache::get_retained_memory() >= 4096);
+		CHECK_MESSAGE(
+				ResourceCache::has(path_a),
+				"The resource should remain cached after its last user releases it.");
+
+		Ref<Resource> loaded_again = ResourceLoader::load(path_a);
+		CHECK_MESSAGE(
+				loaded_again->get_instance_id() == first_id,
+				"Loading again should return the retained instance.");
+		CHECK(ResourceCache::get_retained_hits() == hits + 1);
+		CHECK(ResourceCache::get_retained_misses() == misses + 1);
+		loaded_again.unref();
+
+		ResourceCache::clear_retained();
+		CHECK(ResourceCache::get_retained_count() == 0);
+		CHECK(ResourceCache::get_retained_memory() == 0);
+		CHECK_FALSE(ResourceCache::has(path_a));
+	}
+
+	SUBCASE("Least recently used resources are evicted over budget") {
+		uint64_t size = 0;
+		{
+			Ref<Resource> loaded = ResourceLoader::load(path_a);
+			REQUIRE(loaded.is_valid());
+			size = loaded->get_memory_usage_estimate();
+		}
+		// Leave room for exactly one of the two resources.
+		ResourceCache::set_retained_budget(size + size / 2);
+		CHECK(ResourceCache::get_retained_count() == 1);
+
+		ResourceLoader::load(path_b);
+		CHECK(ResourceCache::get_retained_count() == 1);
+		CHECK(ResourceCache::get_retained_evictions() == evictions + 1);
+		CHECK_FALSE(ResourceCache::has(path_a));
+		CHECK(ResourceCache::has(path_b));
+
+		ResourceCache::set_retained_budget(0);
+		CHECK(ResourceCache::get_retained_count() == 0);
+		CHECK_FALSE(ResourceCache::has(path_b));
+	}
+
+	ResourceCache::set_retained_budget(0);
+	ResourceCache::clear_retained();
+}
+
+struct DependencyLoad {
+	String path;
+	Ref<Resource> resource;
+};
+
+static void _load_from_task(void *p_userdata) {
+	DependencyLoad *load = (DependencyLoad *)p_userdata;
+	load->resource = ResourceLoader::load(load->path);
+}
+
+TEST_CASE("[Resource] Loading binary resources with many dependencies") {
+	const int dependency_count = 12;
+	Vector<String> paths;
+	const String path = TestUtils::get_temp_path("parallel_dependencies.res");
+	{
+		Array dependencies;
+		for (int i = 0; i < dependency_count; i++) {
+			Ref<Resource> dependency = memnew(Resource);
+			dependency->set_meta("index", i);
+			paths.push_back(TestUtils::get_temp_path(vformat("parallel_dependency_%d.res", i)));
+			// Saved with its path, so the resource below references it as an external dependency.
+			REQUIRE(ResourceSaver::save(dependency, paths[i], ResourceSaver::FLAG_CHANGE_PATH) == OK);
+			dependencies.push_back(dependency);
+		}
+		Ref<Resource> resource = memnew(Resource);
+		resource->set_meta("dependencies", dependencies);
+		REQUIRE(ResourceSaver::save(resource, path) == OK);
+	}
+
+	// Disabled, parallel, and too few dependencies to go parallel. Loads run on a pool thread,
+	// as the main thread always loads dependencies serially without a separate rendering thread.
+	const int previous_threshold = ResourceLoader::get_parallel_dependency_threshold();
+	const int thresholds[] = { 0, 1, dependency_count + 1 };
+	for (int threshold : thresholds) {
+		ResourceLoader::set_parallel_dependency_threshold(threshold);
+		for (const String &dependency_path : paths) {
+			REQUIRE_FALSE(ResourceCache::has(dependency_path));
+		}
+
+		DependencyLoad load;
+		load.path = path;
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::get_singleton()->add_native_task(&_load_from_task, &load);
+		CHECK(WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id) == OK);
+		REQUIRE(load.resource.is_valid());
+
+		const Array dependencies = load.resource->get_meta("dependencies");
+		REQUIRE(dependencies.size() == dependency_count);
+		for (int i = 0; i < dependency_count; i++) {
+			const Ref<Resource> dependency = dependencies[i];
+			REQUIRE(dependency.is_valid());
+			CHECK(dependency->get_path() == paths[i]);
+			CHECK(int(dependency->get_meta("index")) == i);
+		}
+	}
+	ResourceLoader::set_parallel_dependency_threshold(previous_threshold);
+}
 } // namespace TestResource
 
 #endif // TEST_RESOURCE_H
@@ -99,6 +99,8 @@ TEST_CASE("[String] UTF8") {
 
 	CharString cs = (const char *)u8str;
 	CHECK(String::utf8(cs) == s);
+	CHECK(s.utf8_length() == cs.length());
+	CHECK(String().utf8_length() == 0);
 }
 
 TEST_CASE("[String] UTF16") {
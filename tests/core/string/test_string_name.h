@@ -0,0 +1,146 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_STRING_NAME_H
+#define TEST_STRING_NAME_H
+
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/string/string_name.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName a = "test_string_name_interning";
+	const StringName b = String("test_string_name_interning");
+	const StringName c = StringName::search("test_string_name_interning");
+
+	CHECK(a == b);
+	CHECK(a == c);
+	CHECK(a.data_unique_pointer() == b.data_unique_pointer());
+	CHECK(a == "test_string_name_interning");
+
+	CHECK(StringName::search("test_string_name_never_created") == StringName());
+}
+
+TEST_CASE("[StringName] Release and recreate") {
+	{
+		const StringName a = String("test_string_name_release");
+		CHECK(StringName::search("test_string_name_release") == a);
+	}
+	CHECK_MESSAGE(StringName::search("test_string_name_release") == StringName(), "Unreferenced names should be removed from the table.");
+
+	const StringName b = String("test_string_name_release");
+	CHECK(StringName::search("test_string_name_release") == b);
+	CHECK(String(b) == "test_string_name_release");
+}
+
+static const int CONCURRENT_NAMES = 256;
+static StringName concurrent_names[CONCURRENT_NAMES];
+static SafeNumeric<int> concurrent_mismatches;
+
+static void concurrent_intern(void *p_userdata, uint32_t p_index) {
+	// Every element interns the whole shared set plus a few names of its own,
+	// so threads hit both the same and unrelated buckets at once.
+	for (int i = 0; i < CONCURRENT_NAMES; i++) {
+		const StringName shared = String("test_string_name_shared_") + itos(i);
+		if (shared != concurrent_names[i]) {
+			concurrent_mismatches.increment();
+		}
+	}
+	for (int i = 0; i < 16; i++) {
+		const String own = String("test_string_name_own_") + itos(p_index) + "_" + itos(i);
+		const StringName created = own;
+		const StringName found = StringName::search(own);
+		if (created != found || String(found) != own) {
+			concurrent_mismatches.increment();
+		}
+	}
+}
+
+TEST_CASE("[StringName] Concurrent interning") {
+	for (int i = 0; i < CONCURRENT_NAMES; i++) {
+		concurrent_names[i] = String("test_string_name_shared_") + itos(i);
+	}
+	concurrent_mismatches.set(0);
+
+	const int elements = WorkerThreadPool::get_singleton()->get_thread_count() * 64;
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(concurrent_intern, nullptr, elements, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	CHECK_MESSAGE(concurrent_mismatches.get() == 0, "Names interned concurrently should resolve to the same entry.");
+
+	// Per-element names were released when the tasks finished.
+	CHECK(StringName::search("test_string_name_own_0_0") == StringName());
+
+	for (int i = 0; i < CONCURRENT_NAMES; i++) {
+		concurrent_names[i] = StringName();
+	}
+}
+
+static const int BENCHMARK_NAMES = 4096;
+static const int BENCHMARK_LOOKUPS = 200000;
+static String benchmark_names[BENCHMARK_NAMES];
+
+static void benchmark_intern(void *p_userdata, uint32_t p_index) {
+	for (int i = 0; i < BENCHMARK_LOOKUPS; i++) {
+		const StringName name = benchmark_names[(i * 31 + p_index * 97) % BENCHMARK_NAMES];
+	}
+}
+
+TEST_CASE_BENCHMARK("[StringName][Benchmark] Concurrent interning rate") {
+	Vector<StringName> keep_alive;
+	for (int i = 0; i < BENCHMARK_NAMES; i++) {
+		benchmark_names[i] = String("test_string_name_benchmark_") + itos(i);
+		keep_alive.push_back(benchmark_names[i]);
+	}
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	benchmark_intern(nullptr, 0);
+	const uint64_t single_time = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+
+	const int threads = WorkerThreadPool::get_singleton()->get_thread_count();
+	begin = OS::get_singleton()->get_ticks_usec();
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(benchmark_intern, nullptr, threads, threads, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	const uint64_t concurrent_time = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+
+	MESSAGE(vformat("One thread: %d names per second. %d threads: %d names per second.", int64_t(BENCHMARK_LOOKUPS * 1000000.0 / single_time), threads, int64_t(double(BENCHMARK_LOOKUPS) * threads * 1000000.0 / concurrent_time)).utf8().get_data());
+
+	for (int i = 0; i < BENCHMARK_NAMES; i++) {
+		benchmark_names[i] = String();
+	}
+}
+
+} // namespace TestStringName
+
+#endif // TEST_STRING_NAME_H
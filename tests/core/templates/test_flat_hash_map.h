@@ -0,0 +1,237 @@
+/**************************************************************************/
+/*  test_flat_hash_map.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FLAT_HASH_MAP_H
+#define TEST_FLAT_HASH_MAP_H
+
+#include "core/math/random_number_generator.h"
+#include "core/os/os.h"
+#include "core/templates/flat_hash_map.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/oa_hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFlatHashMap {
+
+TEST_CASE("[FlatHashMap] Insert element") {
+	FlatHashMap<int, int> map;
+	FlatHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map[42] == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+}
+
+TEST_CASE("[FlatHashMap] Overwrite element") {
+	FlatHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(42, 1234);
+
+	CHECK(map[42] == 1234);
+	CHECK(map.size() == 1);
+}
+
+TEST_CASE("[FlatHashMap] Erase via element") {
+	FlatHashMap<int, int> map;
+	FlatHashMap<int, int>::Iterator e = map.insert(42, 84);
+	map.remove(e);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+}
+
+TEST_CASE("[FlatHashMap] Erase via key") {
+	FlatHashMap<int, int> map;
+	map.insert(42, 84);
+	CHECK(map.erase(42));
+	CHECK(!map.erase(42));
+	CHECK(!map.has(42));
+	CHECK(map.is_empty());
+}
+
+TEST_CASE("[FlatHashMap] Iteration") {
+	FlatHashMap<int, int> map;
+	for (int i = 0; i < 100; i++) {
+		map.insert(i, i * 2);
+	}
+	map.erase(10);
+
+	int count = 0;
+	int sum = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(E.value == E.key * 2);
+		count++;
+		sum += E.key;
+	}
+	CHECK(count == 99);
+	CHECK(sum == 4950 - 10);
+}
+
+TEST_CASE("[FlatHashMap] Non-trivial keys and values") {
+	FlatHashMap<String, Vector<int>> map;
+	for (int i = 0; i < 1000; i++) {
+		map[itos(i)].push_back(i);
+	}
+	CHECK(map.size() == 1000);
+	CHECK(map.get("500").size() == 1);
+	CHECK(map.get("500")[0] == 500);
+
+	FlatHashMap<String, Vector<int>> copy = map;
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK(map.getptr("1") == nullptr);
+	CHECK(copy.size() == 1000);
+	CHECK(copy["999"][0] == 999);
+}
+
+TEST_CASE("[FlatHashMap] Reserve") {
+	FlatHashMap<int, int> map;
+	map.reserve(1000);
+	uint32_t capacity = map.get_capacity();
+	CHECK(capacity >= 1000);
+	for (int i = 0; i < 1000; i++) {
+		map.insert(i, i);
+	}
+	CHECK(map.get_capacity() == capacity);
+}
+
+TEST_CASE("[FlatHashMap] Matches HashMap and OAHashMap under random operations") {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(0);
+
+	FlatHashMap<int, int> flat;
+	HashMap<int, int> map;
+	OAHashMap<int, int> oa_map;
+
+	bool consistent = true;
+	for (int i = 0; i < 100000; i++) {
+		int key = rng->randi() % 2000;
+		switch (rng->randi() % 3) {
+			case 0: {
+				flat.insert(key, i);
+				map.insert(key, i);
+				oa_map.set(key, i);
+			} break;
+			case 1: {
+				bool erased = flat.erase(key);
+				consistent = consistent && erased == map.erase(key);
+				oa_map.remove(key);
+			} break;
+			case 2: {
+				const int *flat_value = flat.getptr(key);
+				const int *value = map.getptr(key);
+				int oa_value = 0;
+				bool oa_found = oa_map.lookup(key, oa_value);
+				consistent = consistent && (flat_value == nullptr) == (value == nullptr) && (value == nullptr) != oa_found;
+				consistent = consistent && (value == nullptr || (*flat_value == *value && *value == oa_value));
+			} break;
+		}
+		consistent = consistent && flat.size() == map.size() && map.size() == oa_map.get_num_elements();
+	}
+	CHECK(consistent);
+
+	for (const KeyValue<int, int> &E : map) {
+		consistent = consistent && flat.has(E.key) && flat[E.key] == E.value;
+	}
+	CHECK(consistent);
+}
+
+// OAHashMap names these differently.
+template <typename M>
+static void _benchmark_erase(M &p_map, uint32_t p_key) {
+	p_map.erase(p_key);
+}
+static void _benchmark_erase(OAHashMap<uint32_t, uint32_t> &p_map, uint32_t p_key) {
+	p_map.remove(p_key);
+}
+template <typename M>
+static uint32_t _benchmark_size(const M &p_map) {
+	return p_map.size();
+}
+static uint32_t _benchmark_size(const OAHashMap<uint32_t, uint32_t> &p_map) {
+	return p_map.get_num_elements();
+}
+
+template <typename M>
+static void _benchmark_map(const char *p_name, const LocalVector<uint32_t> &p_keys) {
+	M map;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t i = 0; i < p_keys.size(); i++) {
+		map.insert(p_keys[i], i);
+	}
+	const uint64_t insert_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+	// Every other lookup misses.
+	uint64_t found = 0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t i = 0; i < p_keys.size(); i++) {
+		found += map.has(p_keys[i] ^ (i & 1));
+	}
+	const uint64_t lookup_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t i = 0; i < p_keys.size(); i += 2) {
+		_benchmark_erase(map, p_keys[i]);
+	}
+	const uint64_t erase_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(_benchmark_size(map) == p_keys.size() / 2);
+	MESSAGE(vformat("%s: insert %.1f ms, lookup %.1f ms (%d found), erase %.1f ms.", p_name, insert_time / 1000.0, lookup_time / 1000.0, found, erase_time / 1000.0).utf8().get_data());
+}
+
+TEST_CASE_BENCHMARK("[FlatHashMap][Benchmark] Against HashMap and OAHashMap") {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(0);
+
+	// Even keys, so flipping the lowest bit gives a key that isn't in the map.
+	HashSet<uint32_t> unique;
+	LocalVector<uint32_t> keys;
+	while (keys.size() < 1000000) {
+		uint32_t key = rng->randi() & ~1u;
+		if (!unique.has(key)) {
+			unique.insert(key);
+			keys.push_back(key);
+		}
+	}
+
+	_benchmark_map<FlatHashMap<uint32_t, uint32_t>>("FlatHashMap", keys);
+	_benchmark_map<HashMap<uint32_t, uint32_t>>("HashMap", keys);
+	_benchmark_map<OAHashMap<uint32_t, uint32_t>>("OAHashMap", keys);
+}
+
+} // namespace TestFlatHashMap
+
+#endif // TEST_FLAT_HASH_MAP_H
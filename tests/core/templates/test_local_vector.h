@@ -31,6 +31,7 @@
 #ifndef TEST_LOCAL_VECTOR_H
 #define TEST_LOCAL_VECTOR_H
 
+#include "core/os/frame_allocator.h"
 #include "core/templates/local_vector.h"
 
 #include "tests/test_macros.h"
@@ -244,6 +245,62 @@ TEST_CASE("[LocalVector] Size / Resize / Reserve.") {
 	CHECK(vector.size() == 4);
 	CHECK(vector.get_capacity() >= 4);
 }
+
+TEST_CASE("[LocalVector] Frame allocator storage.") {
+	uint32_t live_before = FrameAllocator::get_live_allocation_count();
+	{
+		FrameLocalVector<int> a;
+		FrameLocalVector<String> b;
+		for (int i = 0; i < 1000; i++) {
+			a.push_back(i);
+			b.push_back(itos(i));
+		}
+		CHECK(FrameAllocator::get_live_allocation_count() == live_before + 2);
+
+		// Vectors grow without clobbering each other, even across chunks.
+		a.resize(100000);
+		bool valid = true;
+		for (int i = 0; i < 1000; i++) {
+			valid = valid && a[i] == i && b[i] == itos(i);
+		}
+		CHECK(valid);
+
+		FrameLocalVector<int> c = a;
+		CHECK(c.size() == a.size());
+		CHECK(c[999] == 999);
+	}
+	CHECK(FrameAllocator::get_live_allocation_count() == live_before);
+}
+
+TEST_CASE("[LocalVector] Frame allocator compacts to the peak usage.") {
+	REQUIRE(FrameAllocator::get_live_allocation_count() == 0);
+
+	// Larger than any chunk kept by earlier allocations, so each one needs its own. Freeing the
+	// second one first lowers the usage before the arena is rewound, the new chunk must still fit both.
+	const size_t size = 1 << 20;
+	void *first = FrameAllocator::alloc(size);
+	void *second = FrameAllocator::alloc(size);
+	FrameAllocator::free(second);
+	FrameAllocator::free(first);
+
+	first = FrameAllocator::alloc(size);
+	second = FrameAllocator::alloc(size);
+	CHECK((uint8_t *)second == (uint8_t *)first + size);
+	FrameAllocator::free(second);
+	FrameAllocator::free(first);
+}
+
+TEST_CASE("[LocalVector] Frame allocator reuses freed memory.") {
+	void *first = FrameAllocator::alloc(64);
+	FrameAllocator::free(first);
+	void *second = FrameAllocator::alloc(64);
+	// The most recent allocation is rewound when freed.
+	CHECK(first == second);
+
+	void *grown = FrameAllocator::realloc(second, 64, 256);
+	CHECK(grown == second);
+	FrameAllocator::free(grown);
+}
 } // namespace TestLocalVector
 
 #endif // TEST_LOCAL_VECTOR_H
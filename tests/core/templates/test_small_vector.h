@@ -0,0 +1,190 @@
+/**************************************************************************/
+/*  test_small_vector.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SMALL_VECTOR_H
+#define TEST_SMALL_VECTOR_H
+
+#include "core/object/ref_counted.h"
+#include "core/os/os.h"
+#include "core/string/node_path.h"
+#include "core/templates/small_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSmallVector {
+
+TEST_CASE("[SmallVector] Stays inline up to its capacity") {
+	SmallVector<int, 4> vector;
+	CHECK(vector.is_empty());
+	CHECK(vector.get_capacity() == 4);
+
+	for (int i = 0; i < 4; i++) {
+		vector.push_back(i);
+	}
+	CHECK(vector.is_inline());
+	CHECK(vector.size() == 4);
+
+	// The elements live inside the object itself.
+	const uint8_t *begin = reinterpret_cast<const uint8_t *>(&vector);
+	const uint8_t *element = reinterpret_cast<const uint8_t *>(vector.ptr());
+	CHECK(element >= begin);
+	CHECK(element < begin + sizeof(vector));
+}
+
+TEST_CASE("[SmallVector] Moves to the heap when growing") {
+	SmallVector<String, 2> vector;
+	for (int i = 0; i < 100; i++) {
+		vector.push_back(itos(i));
+	}
+	CHECK(!vector.is_inline());
+	CHECK(vector.size() == 100);
+	CHECK(vector.get_capacity() >= 100);
+
+	bool valid = true;
+	for (int i = 0; i < 100; i++) {
+		valid = valid && vector[i] == itos(i);
+	}
+	CHECK(valid);
+
+	vector.reset();
+	CHECK(vector.is_empty());
+	CHECK(vector.is_inline());
+	CHECK(vector.get_capacity() == 2);
+}
+
+TEST_CASE("[SmallVector] Remove, find and resize") {
+	SmallVector<int, 4> vector{ 0, 1, 2, 3, 4, 5 };
+	CHECK(vector.size() == 6);
+
+	vector.remove_at(0);
+	CHECK(vector[0] == 1);
+	CHECK(vector.size() == 5);
+	CHECK(vector.find(3) == 2);
+	CHECK(vector.has(5));
+	CHECK(!vector.has(0));
+
+	vector.resize(2);
+	CHECK(vector.size() == 2);
+	vector.resize(8);
+	CHECK(vector.size() == 8);
+	CHECK(vector[1] == 2);
+}
+
+TEST_CASE("[SmallVector] Copy and conversion to Vector") {
+	SmallVector<String, 2> vector{ "a", "b", "c" };
+	SmallVector<String, 2> copy = vector;
+	copy.push_back("d");
+	CHECK(vector.size() == 3);
+	CHECK(copy.size() == 4);
+	CHECK(copy[2] == "c");
+
+	SmallVector<String, 2> small{ "x" };
+	copy = small;
+	CHECK(copy.size() == 1);
+	CHECK(copy[0] == "x");
+
+	Vector<String> converted = vector;
+	CHECK(converted.size() == 3);
+	CHECK(converted[0] == "a");
+	CHECK(converted[2] == "c");
+}
+
+#ifdef DEBUG_ENABLED
+TEST_CASE("[SmallVector] Binding a few arguments only allocates the bind") {
+	Ref<RefCounted> object;
+	object.instantiate();
+	const Callable callable(object.ptr(), "get_class");
+
+	const uint64_t allocations = Memory::get_mem_alloc_count();
+	const Callable bound = callable.bind(1, 1.5, true);
+	CHECK_MESSAGE(
+			Memory::get_mem_alloc_count() - allocations == 1,
+			"The bound arguments should be stored inside the bind itself.");
+	CHECK(bound.get_bound_arguments_count() == 3);
+}
+#endif // DEBUG_ENABLED
+
+TEST_CASE_BENCHMARK("[SmallVector][Benchmark] Allocations of bound arguments and NodePath parsing") {
+	const int count = 200000;
+
+	// Allocations are only counted in debug builds.
+	uint64_t allocations = Memory::get_mem_alloc_count();
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		Vector<Variant> vector;
+		vector.push_back(i);
+		vector.push_back(1.5);
+		vector.push_back(true);
+	}
+	const uint64_t vector_time = OS::get_singleton()->get_ticks_usec() - begin;
+	const uint64_t vector_allocations = Memory::get_mem_alloc_count() - allocations;
+
+	allocations = Memory::get_mem_alloc_count();
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		SmallVector<Variant, 3> vector;
+		vector.push_back(i);
+		vector.push_back(1.5);
+		vector.push_back(true);
+	}
+	const uint64_t small_vector_time = OS::get_singleton()->get_ticks_usec() - begin;
+	const uint64_t small_vector_allocations = Memory::get_mem_alloc_count() - allocations;
+
+	Ref<RefCounted> object;
+	object.instantiate();
+	const Callable callable(object.ptr(), "get_class");
+	allocations = Memory::get_mem_alloc_count();
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		const Callable bound = callable.bind(i, 1.5, true);
+	}
+	const uint64_t bind_time = OS::get_singleton()->get_ticks_usec() - begin;
+	const uint64_t bind_allocations = Memory::get_mem_alloc_count() - allocations;
+
+	// Intern the names first, so only the parsing itself is counted.
+	const String path = "Root/Child/Grandchild:position:x";
+	const NodePath interned = path;
+	allocations = Memory::get_mem_alloc_count();
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		const NodePath node_path = path;
+	}
+	const uint64_t node_path_time = OS::get_singleton()->get_ticks_usec() - begin;
+	const uint64_t node_path_allocations = Memory::get_mem_alloc_count() - allocations;
+
+	MESSAGE(vformat("Three Variants in Vector: %.2f allocations, %.1f ms.", vector_allocations / double(count), vector_time / 1000.0).utf8().get_data());
+	MESSAGE(vformat("Three Variants in SmallVector: %.2f allocations, %.1f ms.", small_vector_allocations / double(count), small_vector_time / 1000.0).utf8().get_data());
+	MESSAGE(vformat("Binding three arguments: %.2f allocations, %.1f ms.", bind_allocations / double(count), bind_time / 1000.0).utf8().get_data());
+	MESSAGE(vformat("Parsing \"%s\": %.2f allocations, %.1f ms.", path, node_path_allocations / double(count), node_path_time / 1000.0).utf8().get_data());
+}
+
+} // namespace TestSmallVector
+
+#endif // TEST_SMALL_VECTOR_H
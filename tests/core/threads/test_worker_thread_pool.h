@@ -107,6 +107,211 @@ TEST_CASE("[WorkerThreadPool] Process elements using group tasks") {
 	}
 }
 
+static void static_nested_leaf(void *p_arg) {
+	counter[(uint64_t)p_arg].increment();
+}
+
+static void static_nested_spawner(void *p_arg) {
+	// Tasks posted from a pool thread go to its own queue, where other threads can steal them.
+	const uint64_t base = (uint64_t)p_arg * 16;
+	WorkerThreadPool::TaskID children[16];
+	for (int i = 0; i < 16; i++) {
+		children[i] = WorkerThreadPool::get_singleton()->add_native_task(static_nested_leaf, (void *)(uintptr_t)(base + i), true);
+	}
+	for (int i = 0; i < 16; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(children[i]);
+	}
+}
+
+static void static_nested_group_spawner(void *p_arg) {
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_group_test, (void *)0, counter.size(), -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+}
+
+TEST_CASE("[WorkerThreadPool] Process tasks posted from pool threads") {
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int spawners = Math::pow(2.0f, Math::random(0.0f, 4.0f));
+
+		counter.clear();
+		counter.resize(spawners * 16);
+
+		LocalVector<WorkerThreadPool::TaskID> tasks;
+		tasks.resize(spawners);
+		for (int i = 0; i < spawners; i++) {
+			tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_nested_spawner, (void *)(uintptr_t)i, true);
+		}
+		for (int i = 0; i < spawners; i++) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(tasks[i]);
+		}
+
+		bool all_run_once = true;
+		for (uint32_t i = 0; i < counter.size(); i++) {
+			//Reduce number of check messages
+			all_run_once &= counter[i].get() == 1;
+		}
+		CHECK(all_run_once);
+	}
+
+	for (int iterations = 0; iterations < 100; iterations++) {
+		counter.clear();
+		counter.resize(Math::pow(2.0f, Math::random(1.0f, 8.0f)));
+
+		WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_native_task(static_nested_group_spawner, nullptr, true);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+
+		bool all_run_once = true;
+		for (uint32_t i = 0; i < counter.size(); i++) {
+			//Reduce number of check messages
+			all_run_once &= counter[i].get() == 1;
+		}
+		CHECK(all_run_once);
+	}
+}
+
+static void static_range_test(void *p_arg, uint32_t p_from, uint32_t p_to) {
+	for (uint32_t i = p_from; i < p_to; i++) {
+		counter[i].increment();
+	}
+}
+
+class RangeTester {
+public:
+	uint32_t begin = 0;
+	SafeNumeric<int> out_of_bounds;
+
+	void process(uint32_t p_from, uint32_t p_to, uint32_t p_end) {
+		if (p_from < begin || p_to > p_end) {
+			out_of_bounds.increment();
+			return;
+		}
+		for (uint32_t i = p_from; i < p_to; i++) {
+			counter[i - begin].increment();
+		}
+	}
+};
+
+TEST_CASE("[WorkerThreadPool] Process elements using range group tasks") {
+	for (int iterations = 0; iterations < 500; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(0.0f, 12.0f));
+		const int grain = Math::rand() % 2 ? 0 : Math::rand() % 64 + 1;
+		const bool low_priority = Math::rand() % 2;
+
+		counter.clear();
+		counter.resize(count);
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_range_group_task(static_range_test, nullptr, count, grain, -1, !low_priority);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+		bool all_run_once = true;
+		for (int i = 0; i < count; i++) {
+			//Reduce number of check messages
+			all_run_once &= counter[i].get() == 1;
+		}
+		CHECK(all_run_once);
+	}
+
+	RangeTester tester;
+	for (int iterations = 0; iterations < 500; iterations++) {
+		const uint32_t count = Math::pow(2.0f, Math::random(0.0f, 12.0f));
+		const int grain = Math::rand() % 2 ? 0 : Math::rand() % 64 + 1;
+		tester.begin = Math::rand() % 1000;
+
+		counter.clear();
+		counter.resize(count);
+		WorkerThreadPool::get_singleton()->parallel_for(&tester, &RangeTester::process, tester.begin + count, tester.begin, tester.begin + count, grain);
+
+		bool all_run_once = true;
+		for (uint32_t i = 0; i < count; i++) {
+			//Reduce number of check messages
+			all_run_once &= counter[i].get() == 1;
+		}
+		CHECK(all_run_once);
+	}
+	CHECK(tester.out_of_bounds.get() == 0);
+
+	// A grain past the element count must not make the claimed index wrap around.
+	counter.clear();
+	counter.resize(1000);
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_range_group_task(static_range_test, nullptr, counter.size(), INT32_MAX, 16, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	bool all_run_once = true;
+	for (uint32_t i = 0; i < counter.size(); i++) {
+		//Reduce number of check messages
+		all_run_once &= counter[i].get() == 1;
+	}
+	CHECK(all_run_once);
+}
+
+static SafeNumeric<int> stage_counter;
+static SafeNumeric<int> stage_errors;
+
+static void static_stage_element(void *p_arg, uint32_t p_index) {
+	counter[p_index].increment();
+}
+
+static void static_stage_check(void *p_arg) {
+	// Runs after the group it depends on, so every element must be processed by now.
+	for (uint32_t i = 0; i < counter.size(); i++) {
+		if (counter[i].get() != 1) {
+			stage_errors.increment();
+		}
+	}
+	stage_counter.increment();
+}
+
+static void static_chain_link(void *p_arg) {
+	// Continuations must run in order.
+	if (stage_counter.postincrement() != (int)(uintptr_t)p_arg) {
+		stage_errors.increment();
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Run tasks after their dependencies") {
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const bool low_priority = Math::rand() % 2;
+
+		counter.clear();
+		counter.resize(Math::pow(2.0f, Math::random(1.0f, 8.0f)));
+		stage_counter.set(0);
+		stage_errors.set(0);
+
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_stage_element, nullptr, counter.size(), -1, !low_priority);
+		WorkerThreadPool::TaskID check = WorkerThreadPool::get_singleton()->add_native_task_with_dependencies(static_stage_check, nullptr, &group, 1, low_priority);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(check);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+		CHECK(stage_counter.get() == 1);
+		CHECK(stage_errors.get() == 0);
+	}
+
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int links = Math::pow(2.0f, Math::random(0.0f, 5.0f));
+		stage_counter.set(0);
+		stage_errors.set(0);
+
+		LocalVector<WorkerThreadPool::TaskID> chain;
+		chain.push_back(WorkerThreadPool::get_singleton()->add_native_task(static_chain_link, (void *)0, true));
+		for (int i = 1; i < links; i++) {
+			chain.push_back(WorkerThreadPool::get_singleton()->add_native_task_with_dependencies(static_chain_link, (void *)(uintptr_t)i, &chain[i - 1], 1, true));
+		}
+		for (int i = links - 1; i >= 0; i--) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(chain[i]);
+		}
+
+		CHECK(stage_counter.get() == links);
+		CHECK(stage_errors.get() == 0);
+	}
+
+	// Dependencies already completed and awaited don't hold the task back.
+	stage_counter.set(0);
+	stage_errors.set(0);
+	WorkerThreadPool::TaskID first = WorkerThreadPool::get_singleton()->add_native_task(static_chain_link, (void *)0, true);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(first);
+	WorkerThreadPool::TaskID second = WorkerThreadPool::get_singleton()->add_native_task_with_dependencies(static_chain_link, (void *)1, &first, 1, true);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(second);
+	CHECK(stage_counter.get() == 2);
+	CHECK(stage_errors.get() == 0);
+}
+
 static void static_test_daemon(void *p_arg) {
 	while (!exit.is_set()) {
 		counter[0].add(1);
@@ -173,6 +378,132 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static SafeNumeric<uint32_t> tiny_counter;
+
+static void static_tiny_task(void *p_arg) {
+	tiny_counter.increment();
+}
+
+static void static_tiny_group_element(void *p_arg, uint32_t p_index) {
+	tiny_counter.add(p_index & 1);
+}
+
+static void static_tiny_spawner(void *p_arg) {
+	// Posted from a pool thread, so they go to its deque and idle threads have to steal them.
+	const uint32_t count = (uint32_t)(uintptr_t)p_arg;
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	tasks.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_tiny_task, nullptr, true);
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(tasks[i]);
+	}
+}
+
+TEST_CASE_BENCHMARK("[WorkerThreadPool][Benchmark] Task throughput against thread count") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	const int default_thread_count = pool->get_thread_count();
+	const uint32_t task_count = 20000;
+	const uint32_t element_count = 1 << 24;
+
+	LocalVector<int> thread_counts;
+	for (int count = 1; count < default_thread_count; count *= 2) {
+		thread_counts.push_back(count);
+	}
+	thread_counts.push_back(default_thread_count);
+
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	tasks.resize(task_count);
+	for (int thread_count : thread_counts) {
+		pool->finish();
+		pool->init(thread_count);
+
+		tiny_counter.set(0);
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < task_count; i++) {
+			tasks[i] = pool->add_native_task(static_tiny_task, nullptr, true);
+		}
+		for (uint32_t i = 0; i < task_count; i++) {
+			pool->wait_for_task_completion(tasks[i]);
+		}
+		const uint64_t posted_usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+		CHECK(tiny_counter.get() == task_count);
+
+		tiny_counter.set(0);
+		begin = OS::get_singleton()->get_ticks_usec();
+		WorkerThreadPool::TaskID spawner = pool->add_native_task(static_tiny_spawner, (void *)(uintptr_t)task_count, true);
+		pool->wait_for_task_completion(spawner);
+		const uint64_t stolen_usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+		CHECK(tiny_counter.get() == task_count);
+
+		tiny_counter.set(0);
+		begin = OS::get_singleton()->get_ticks_usec();
+		WorkerThreadPool::GroupID group = pool->add_native_group_task(static_tiny_group_element, nullptr, element_count, -1, true);
+		pool->wait_for_group_task_completion(group);
+		const uint64_t group_usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+		CHECK(tiny_counter.get() == element_count / 2);
+
+		MESSAGE(vformat("%d threads: %.0f tasks/s posted from the main thread, %.0f tasks/s posted from a pool thread, %.1f M group elements/s.", thread_count, task_count * 1000000.0 / posted_usec, task_count * 1000000.0 / stolen_usec, element_count / double(group_usec)).utf8().get_data());
+	}
+
+	// Back to the setup the test runner starts with.
+	pool->finish();
+	pool->init();
+}
+
+static void static_dispatch_element(void *p_arg, uint32_t p_index) {
+	float *data = (float *)p_arg;
+	data[p_index] = data[p_index] * 0.5f + 1.0f;
+}
+
+class DispatchTester {
+public:
+	float *data = nullptr;
+
+	void process(uint32_t p_from, uint32_t p_to, int p_unused) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			data[i] = data[i] * 0.5f + 1.0f;
+		}
+	}
+};
+
+TEST_CASE_BENCHMARK("[WorkerThreadPool][Benchmark] Per-index against range dispatch") {
+	const uint32_t count = 1 << 24;
+	const int passes = 8;
+	LocalVector<float> data;
+	data.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		data[i] = 0.0f;
+	}
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int pass = 0; pass < passes; pass++) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_dispatch_element, data.ptr(), count, -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+	const uint64_t per_index_usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+
+	DispatchTester tester;
+	tester.data = data.ptr();
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int pass = 0; pass < passes; pass++) {
+		WorkerThreadPool::get_singleton()->parallel_for(&tester, &DispatchTester::process, 0, 0, count);
+	}
+	const uint64_t range_usec = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+
+	// Both paths apply the same steps to every element, so they must all have converged to the same value.
+	bool all_processed = true;
+	const float expected = data[0];
+	for (uint32_t i = 0; i < count; i++) {
+		all_processed &= data[i] == expected;
+	}
+	CHECK(all_processed);
+	CHECK(expected > 1.9f);
+
+	MESSAGE(vformat("%d worker threads, %d elements: per-index group task %.1f M elements/s, parallel_for %.1f M elements/s.", WorkerThreadPool::get_singleton()->get_thread_count(), count, count * passes / double(per_index_usec), count * passes / double(range_usec)).utf8().get_data());
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H
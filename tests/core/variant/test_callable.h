@@ -135,6 +135,29 @@ TEST_CASE("[Callable] Argument count") {
 
 	memdelete(my_test);
 }
+
+TEST_CASE("[Callable] Bound arguments") {
+	TestClass *my_test = memnew(TestClass);
+	Callable callable = callable_mp(my_test, &TestClass::test_func_2);
+	CHECK(callable.get_bound_arguments().is_empty());
+
+	// Read straight from the bind.
+	Array bound = callable.bind(1, 2).get_bound_arguments();
+	CHECK(bound.size() == 2);
+	CHECK(bound[0] == Variant(1));
+	CHECK(bound[1] == Variant(2));
+
+	// Combined with the arguments of the wrapped callable.
+	bound = callable.bind(1).bind(2).get_bound_arguments();
+	CHECK(bound.size() == 2);
+	CHECK(bound.has(1));
+	CHECK(bound.has(2));
+	bound = callable.bind(1, 2).unbind(1).get_bound_arguments();
+	CHECK(bound.size() == 1);
+	CHECK(bound[0] == Variant(1));
+
+	memdelete(my_test);
+}
 } // namespace TestCallable
 
 #endif // TEST_CALLABLE_H
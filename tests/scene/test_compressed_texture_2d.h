@@ -0,0 +1,146 @@
+/**************************************************************************/
+/*  test_compressed_texture_2d.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_COMPRESSED_TEXTURE_2D_H
+#define TEST_COMPRESSED_TEXTURE_2D_H
+
+#include "core/io/dir_access.h"
+#include "core/io/image.h"
+#include "scene/resources/compressed_texture.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestCompressedTexture2D {
+
+// Writes a mipmapped, uncompressed RGBA8 texture, laid out as the texture importer would.
+static String write_ctex(const String &p_name, int p_size) {
+	const String path = TestUtils::get_temp_path(p_name);
+
+	Ref<Image> image = Image::create_empty(p_size, p_size, false, Image::FORMAT_RGBA8);
+	image->fill(Color(0.2, 0.4, 0.6, 1.0));
+	image->generate_mipmaps();
+
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	f->store_buffer((const uint8_t *)"GST2", 4);
+	f->store_32(CompressedTexture2D::FORMAT_VERSION);
+	f->store_32(p_size);
+	f->store_32(p_size);
+	f->store_32(CompressedTexture2D::FORMAT_BIT_HAS_MIPMAPS);
+	f->store_32(0); // Mipmap limit.
+	f->store_32(0);
+	f->store_32(0);
+	f->store_32(0);
+
+	f->store_32(CompressedTexture2D::DATA_FORMAT_IMAGE);
+	f->store_16(p_size);
+	f->store_16(p_size);
+	f->store_32(image->get_mipmap_count());
+	f->store_32(image->get_format());
+	f->store_buffer(image->get_data());
+	return path;
+}
+
+static int get_uploaded_width(const Ref<CompressedTexture2D> &p_texture) {
+	Ref<Image> image = RS::get_singleton()->texture_2d_get(p_texture->get_rid());
+	return image.is_valid() ? image->get_width() : 0;
+}
+
+TEST_CASE("[SceneTree][CompressedTexture2D] Mipmap streaming") {
+	const bool was_enabled = CompressedTexture2D::is_streaming_enabled();
+	const int old_initial_size = CompressedTexture2D::get_streaming_initial_size();
+	const uint64_t old_budget = CompressedTexture2D::get_streaming_budget();
+	CompressedTexture2D::set_streaming_enabled(true);
+	CompressedTexture2D::set_streaming_initial_size(64);
+	CompressedTexture2D::set_streaming_budget(0);
+
+	const String path_a = write_ctex("streaming_a.ctex", 256);
+	const String path_b = write_ctex("streaming_b.ctex", 256);
+	const String path_small = write_ctex("streaming_small.ctex", 32);
+
+	Ref<CompressedTexture2D> small;
+	small.instantiate();
+	REQUIRE(small->load(path_small) == OK);
+	CHECK_MESSAGE(!small->is_streaming(), "Textures within the initial size load fully.");
+	CHECK(small->get_streaming_size() == 32);
+
+	Ref<CompressedTexture2D> a;
+	a.instantiate();
+	REQUIRE(a->load(path_a) == OK);
+	CHECK(a->is_streaming());
+	CHECK_MESSAGE(a->get_width() == 256, "The reported size is always the full size.");
+	CHECK(a->get_streaming_size() == 64);
+	CHECK(get_uploaded_width(a) == 64);
+
+	SUBCASE("Higher mipmaps load on request") {
+		a->request_streaming_size(32);
+		CHECK(a->get_streaming_size() == 64);
+		a->request_streaming_size(100);
+		CHECK(a->get_streaming_size() == 128);
+		CHECK(get_uploaded_width(a) == 128);
+		a->request_streaming_size(1000);
+		CHECK(a->get_streaming_size() == 256);
+		CHECK(get_uploaded_width(a) == 256);
+		Ref<Image> uploaded = RS::get_singleton()->texture_2d_get(a->get_rid());
+		CHECK(uploaded->has_mipmaps());
+	}
+
+	SUBCASE("Least recently requested textures are evicted over budget") {
+		Ref<CompressedTexture2D> b;
+		b.instantiate();
+		REQUIRE(b->load(path_b) == OK);
+
+		a->request_streaming_size(256);
+		REQUIRE(a->get_streaming_size() == 256);
+
+		// Room for one full texture and one at the initial size.
+		CompressedTexture2D::set_streaming_budget(CompressedTexture2D::get_streaming_resident_bytes());
+		b->request_streaming_size(256);
+		CHECK(b->get_streaming_size() == 256);
+		CHECK(a->get_streaming_size() == 64);
+		CHECK(get_uploaded_width(a) == 64);
+		CHECK(CompressedTexture2D::get_streaming_resident_bytes() <= CompressedTexture2D::get_streaming_budget());
+	}
+
+	a.unref();
+	small.unref();
+	CHECK(CompressedTexture2D::get_streaming_resident_bytes() == 0);
+
+	CompressedTexture2D::set_streaming_enabled(was_enabled);
+	CompressedTexture2D::set_streaming_initial_size(old_initial_size);
+	CompressedTexture2D::set_streaming_budget(old_budget);
+	DirAccess::remove_absolute(path_a);
+	DirAccess::remove_absolute(path_b);
+	DirAccess::remove_absolute(path_small);
+}
+
+} // namespace TestCompressedTexture2D
+
+#endif // TEST_COMPRESSED_TEXTURE_2D_H
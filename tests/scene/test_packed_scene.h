@@ -31,6 +31,8 @@
 #ifndef TEST_PACKED_SCENE_H
 #define TEST_PACKED_SCENE_H
 
+#include "core/os/os.h"
+#include "scene/2d/node_2d.h"
 #include "scene/resources/packed_scene.h"
 
 #include "tests/test_macros.h"
@@ -215,6 +217,155 @@ TEST_CASE("[PackedScene] Recreate State") {
 	memdelete(scene);
 }
 
+static Node *_create_plan_test_scene() {
+	Node2D *scene = memnew(Node2D);
+	scene->set_name("Bullet");
+	scene->set_position(Vector2(1, 2));
+	scene->set_rotation(0.5);
+	scene->add_to_group("bullets", true);
+	scene->set_meta("damage", 10);
+
+	Node2D *sprite = memnew(Node2D);
+	sprite->set_name("Sprite");
+	sprite->set_z_index(3);
+	sprite->set_visible(false);
+	scene->add_child(sprite);
+	sprite->set_owner(scene);
+	sprite->set_unique_name_in_owner(true);
+
+	Node *timer = memnew(Node);
+	timer->set_name("Timer");
+	timer->set_process_priority(7);
+	sprite->add_child(timer);
+	timer->set_owner(scene);
+
+	timer->connect("renamed", Callable(sprite, "hide"), Object::CONNECT_PERSIST);
+	return scene;
+}
+
+static void _check_plan_test_instance(Node *p_instance) {
+	Node2D *root = Object::cast_to<Node2D>(p_instance);
+	REQUIRE(root);
+	CHECK(root->get_name() == "Bullet");
+	CHECK(root->get_position() == Vector2(1, 2));
+	CHECK(root->get_rotation() == doctest::Approx(0.5));
+	CHECK(root->is_in_group("bullets"));
+	CHECK(int(root->get_meta("damage", 0)) == 10);
+
+	Node2D *sprite = Object::cast_to<Node2D>(root->get_node_or_null(NodePath("%Sprite")));
+	REQUIRE(sprite);
+	CHECK(sprite->get_z_index() == 3);
+	CHECK_FALSE(sprite->is_visible());
+	CHECK(sprite->get_owner() == root);
+
+	Node *timer = sprite->get_node_or_null(NodePath("Timer"));
+	REQUIRE(timer);
+	CHECK(timer->get_process_priority() == 7);
+	CHECK(timer->get_owner() == root);
+	CHECK(timer->is_connected("renamed", Callable(sprite, "hide")));
+}
+
+TEST_CASE("[PackedScene] Instantiation plan") {
+	Node *scene = _create_plan_test_scene();
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	packed_scene->pack(scene);
+	memdelete(scene);
+
+	Ref<SceneState> state = packed_scene->get_state();
+	CHECK(state->has_instantiation_plan());
+
+	SUBCASE("Matches generic instantiation") {
+		SceneState::set_instantiation_plans_enabled(false);
+		Node *generic = packed_scene->instantiate();
+		SceneState::set_instantiation_plans_enabled(true);
+		_check_plan_test_instance(generic);
+
+		Node *planned = packed_scene->instantiate();
+		_check_plan_test_instance(planned);
+		CHECK(planned->get_child_count() == generic->get_child_count());
+
+		memdelete(generic);
+		memdelete(planned);
+	}
+
+	SUBCASE("Is rebuilt when the state changes") {
+		Node *changed = memnew(Node);
+		changed->set_name("Changed");
+		packed_scene->pack(changed);
+		memdelete(changed);
+
+		CHECK(state->has_instantiation_plan());
+		Node *instance = packed_scene->instantiate();
+		CHECK(instance->get_name() == "Changed");
+		CHECK(instance->get_child_count() == 0);
+		memdelete(instance);
+	}
+
+	SUBCASE("Is not used with resources local to scene") {
+		Node *local = memnew(Node);
+		Ref<Resource> resource;
+		resource.instantiate();
+		resource->set_local_to_scene(true);
+		local->set_meta("resource", resource);
+		packed_scene->pack(local);
+		memdelete(local);
+
+		CHECK_FALSE(state->has_instantiation_plan());
+		Node *first = packed_scene->instantiate();
+		Node *second = packed_scene->instantiate();
+		CHECK(Ref<Resource>(first->get_meta("resource")) != Ref<Resource>(second->get_meta("resource")));
+		memdelete(first);
+		memdelete(second);
+	}
+}
+
+TEST_CASE("[PackedScene] Native constructors used by the instantiation plan") {
+	CHECK(ClassDB::get_native_creation_func("Node2D") != nullptr);
+	CHECK(ClassDB::get_native_creation_func("NonexistentClass") == nullptr);
+
+	// Like ClassDB::can_instantiate(), editor classes are only available in the editor.
+	List<StringName> classes;
+	ClassDB::get_class_list(&classes);
+	for (const StringName &E : classes) {
+		if (ClassDB::get_api_type(E) == ClassDB::API_EDITOR) {
+			CHECK_MESSAGE(ClassDB::get_native_creation_func(E) == nullptr, String(E));
+		}
+	}
+}
+
+TEST_CASE_BENCHMARK("[PackedScene][Benchmark] Instantiation rate") {
+	Node *scene = _create_plan_test_scene();
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	packed_scene->pack(scene);
+	memdelete(scene);
+
+	const int count = 2000;
+	Vector<Node *> instances;
+	instances.resize(count);
+
+	for (int pass = 0; pass < 2; pass++) {
+		const bool use_plan = pass == 1;
+		SceneState::set_instantiation_plans_enabled(use_plan);
+
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < count; i++) {
+			instances.write[i] = packed_scene->instantiate();
+		}
+		const uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+
+		for (Node *instance : instances) {
+			CHECK(instance != nullptr);
+			memdelete(instance);
+		}
+
+		MESSAGE(vformat("%s: %d instances per second.", use_plan ? "Instantiation plan" : "Generic path", int64_t(count * 1000000.0 / elapsed)).utf8().get_data());
+	}
+
+	SceneState::set_instantiation_plans_enabled(true);
+}
+
 } // namespace TestPackedScene
 
 #endif // TEST_PACKED_SCENE_H
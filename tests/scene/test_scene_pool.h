@@ -0,0 +1,178 @@
+/**************************************************************************/
+/*  test_scene_pool.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SCENE_POOL_H
+#define TEST_SCENE_POOL_H
+
+#include "scene/2d/node_2d.h"
+#include "scene/main/scene_pool.h"
+
+#include "tests/test_macros.h"
+
+namespace TestScenePool {
+
+static Ref<PackedScene> _create_pool_test_scene() {
+	Node2D *scene = memnew(Node2D);
+	scene->set_name("Bullet");
+	scene->set_position(Vector2(4, 8));
+
+	Node2D *child = memnew(Node2D);
+	child->set_name("Trail");
+	scene->add_child(child);
+	child->set_owner(scene);
+
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	packed_scene->pack(scene);
+	memdelete(scene);
+	return packed_scene;
+}
+
+TEST_CASE("[ScenePool] Acquire and release") {
+	Ref<ScenePool> pool;
+	pool.instantiate();
+	pool->set_scene(_create_pool_test_scene());
+
+	Node2D *instance = Object::cast_to<Node2D>(pool->acquire());
+	REQUIRE(instance);
+	CHECK(pool->get_available_count() == 0);
+
+	Node *parent = memnew(Node);
+	parent->add_child(instance);
+	instance->set_position(Vector2(100, 100));
+	Node2D *trail = Object::cast_to<Node2D>(instance->get_node(NodePath("Trail")));
+	trail->set_rotation(1.0);
+	trail->set_meta("hits", 3);
+
+	pool->release(instance);
+	CHECK_MESSAGE(
+			instance->get_parent() == nullptr,
+			"Released instances should be removed from their parent.");
+	CHECK(parent->get_child_count() == 0);
+	CHECK(pool->get_available_count() >= 1);
+
+	SUBCASE("Released instances are reused with their packed properties") {
+		bool reused = false;
+		const int count = pool->get_available_count();
+		Vector<Node *> acquired;
+		for (int i = 0; i < count; i++) {
+			Node *node = pool->acquire();
+			reused = reused || node == instance;
+			acquired.push_back(node);
+		}
+		CHECK(reused);
+		CHECK(pool->get_available_count() == 0);
+
+		CHECK(instance->get_position() == Vector2(4, 8));
+		CHECK(trail->get_rotation() == 0.0);
+		CHECK_FALSE(trail->has_meta("hits"));
+
+		for (Node *node : acquired) {
+			memdelete(node);
+		}
+	}
+
+	SUBCASE("Maximum size") {
+		pool->set_max_size(1);
+		CHECK(pool->get_available_count() == 1);
+
+		Node *first = pool->acquire();
+		Node *second = pool->acquire();
+		pool->release(first);
+		pool->release(second);
+		CHECK(pool->get_available_count() == 1);
+	}
+
+	SUBCASE("Releasing twice") {
+		const int count = pool->get_available_count();
+		ERR_PRINT_OFF;
+		pool->release(instance);
+		ERR_PRINT_ON;
+		CHECK(pool->get_available_count() == count);
+
+		Vector<Node *> acquired;
+		for (int i = 0; i < count; i++) {
+			acquired.push_back(pool->acquire());
+		}
+		CHECK(pool->get_available_count() == 0);
+		CHECK_MESSAGE(acquired.count(instance) == 1, "A node should only be handed out once.");
+		for (Node *node : acquired) {
+			memdelete(node);
+		}
+	}
+
+	SUBCASE("Restructured instances are not reused") {
+		pool->clear();
+		Node *node = pool->acquire();
+		memdelete(node->get_node(NodePath("Trail")));
+		pool->release(node);
+		CHECK(pool->get_available_count() == 0);
+	}
+
+	SUBCASE("Instances with children added at runtime are not reused") {
+		pool->clear();
+		Node *node = pool->acquire();
+		node->get_node(NodePath("Trail"))->add_child(memnew(Node2D));
+		pool->release(node);
+		CHECK(pool->get_available_count() == 0);
+	}
+
+	memdelete(parent);
+}
+
+TEST_CASE("[ScenePool] Prewarm") {
+	Ref<ScenePool> pool;
+	pool.instantiate();
+	pool->set_scene(_create_pool_test_scene());
+	pool->set_max_size(8);
+
+	pool->prewarm(5);
+	pool->wait_for_prewarm();
+	CHECK(pool->get_available_count() == 5);
+	CHECK_FALSE(pool->is_prewarming());
+
+	pool->prewarm(10);
+	pool->wait_for_prewarm();
+	CHECK_MESSAGE(
+			pool->get_available_count() == 8,
+			"Prewarming should not exceed the maximum size.");
+
+	Node *node = pool->acquire();
+	CHECK(node->get_name() == "Bullet");
+	CHECK(node->has_node(NodePath("Trail")));
+	memdelete(node);
+
+	pool->clear();
+	CHECK(pool->get_available_count() == 0);
+}
+
+} // namespace TestScenePool
+
+#endif // TEST_SCENE_POOL_H
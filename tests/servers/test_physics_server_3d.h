@@ -0,0 +1,785 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_3D_H
+#define TEST_PHYSICS_SERVER_3D_H
+
+#include "core/math/random_pcg.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "servers/physics_3d/godot_body_pair_3d.h"
+#include "servers/physics_3d/godot_broad_phase_3d_bvh.h"
+#include "servers/physics_3d/godot_collision_solver_3d.h"
+#include "servers/physics_3d/godot_quantized_bvh_3d.h"
+#include "servers/physics_3d/godot_shape_3d.h"
+#include "servers/physics_3d/godot_simd_kernels_3d.h"
+#include "servers/physics_3d/godot_space_3d.h"
+#include "servers/physics_3d/godot_step_3d.h"
+#include "servers/physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+// A grid of static unit boxes, two units apart on the XZ plane.
+static const int GRID_SIZE = 16;
+
+static void _create_box_grid(RID p_space, RID p_shape, LocalVector<RID> &r_bodies) {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	for (int x = 0; x < GRID_SIZE; x++) {
+		for (int z = 0; z < GRID_SIZE; z++) {
+			RID body = ps->body_create();
+			ps->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+			ps->body_add_shape(body, p_shape);
+			ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x * 2, 0, z * 2)));
+			ps->body_set_space(body, p_space);
+			r_bodies.push_back(body);
+		}
+	}
+}
+
+static void _free_rids(const LocalVector<RID> &p_rids) {
+	for (const RID &rid : p_rids) {
+		PhysicsServer3D::get_singleton()->free(rid);
+	}
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Batched queries match single queries") {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+	RID box = ps->box_shape_create();
+	ps->shape_set_data(box, Vector3(0.5, 0.5, 0.5));
+	LocalVector<RID> bodies;
+	_create_box_grid(space, box, bodies);
+
+	PhysicsDirectSpaceState3D *state = ps->space_get_direct_state(space);
+	REQUIRE(state != nullptr);
+
+	// Enough queries to be sorted and split across several tasks; every other one misses.
+	RandomPCG rng(42);
+	const int count = 500;
+
+	SUBCASE("Rays") {
+		LocalVector<Vector3> from;
+		LocalVector<Vector3> to;
+		for (int i = 0; i < count; i++) {
+			Vector3 column(rng.random(0, GRID_SIZE - 1) * 2, 0, rng.random(0, GRID_SIZE - 1) * 2);
+			if (i % 2) {
+				column.x += 1.0;
+			}
+			from.push_back(column + Vector3(0, 5, 0));
+			to.push_back(column + Vector3(rng.random(-0.2, 0.2), -5, rng.random(-0.2, 0.2)));
+		}
+
+		PhysicsDirectSpaceState3D::RayParameters parameters;
+		LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+		results.resize(count);
+		LocalVector<bool> hits;
+		hits.resize(count);
+		state->intersect_rays(parameters, from.ptr(), to.ptr(), count, results.ptr(), hits.ptr());
+
+		int hit_count = 0;
+		for (int i = 0; i < count; i++) {
+			parameters.from = from[i];
+			parameters.to = to[i];
+			PhysicsDirectSpaceState3D::RayResult expected;
+			bool expected_hit = state->intersect_ray(parameters, expected);
+
+			CHECK(hits[i] == expected_hit);
+			CHECK(hits[i] == (i % 2 == 0));
+			if (hits[i] && expected_hit) {
+				hit_count++;
+				CHECK(results[i].rid == expected.rid);
+				CHECK(results[i].position.is_equal_approx(expected.position));
+				CHECK(results[i].normal.is_equal_approx(expected.normal));
+				CHECK(results[i].shape == expected.shape);
+			}
+		}
+		CHECK(hit_count == count / 2);
+	}
+
+	SUBCASE("Shapes") {
+		RID sphere = ps->sphere_shape_create();
+		ps->shape_set_data(sphere, 0.75);
+
+		LocalVector<Transform3D> transforms;
+		for (int i = 0; i < count; i++) {
+			// Half way between two boxes, the sphere touches both of them.
+			transforms.push_back(Transform3D(Basis(), Vector3(rng.random(0, GRID_SIZE - 2) * 2 + 1, 0, rng.random(0, GRID_SIZE - 1) * 2)));
+		}
+
+		PhysicsDirectSpaceState3D::ShapeParameters parameters;
+		parameters.shape_rid = sphere;
+		const int max_results = 4;
+		LocalVector<PhysicsDirectSpaceState3D::ShapeResult> results;
+		results.resize(count * max_results);
+		LocalVector<int> result_counts;
+		result_counts.resize(count);
+		state->intersect_shapes(parameters, transforms.ptr(), count, results.ptr(), max_results, result_counts.ptr());
+
+		for (int i = 0; i < count; i++) {
+			parameters.transform = transforms[i];
+			PhysicsDirectSpaceState3D::ShapeResult expected[max_results];
+			int expected_count = state->intersect_shape(parameters, expected, max_results);
+
+			CHECK(result_counts[i] == 2);
+			REQUIRE(result_counts[i] == expected_count);
+			for (int j = 0; j < expected_count; j++) {
+				CHECK(results[i * max_results + j].rid == expected[j].rid);
+			}
+		}
+
+		ps->free(sphere);
+	}
+
+	_free_rids(bodies);
+	ps->free(box);
+	ps->free(space);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Batched queries on a locked space clear their results") {
+	GodotSpace3D space;
+	PhysicsDirectSpaceState3D *state = space.get_direct_state();
+	const int count = 3;
+	Vector3 points[count];
+	Transform3D transforms[count];
+	PhysicsDirectSpaceState3D::RayResult ray_results[count];
+	PhysicsDirectSpaceState3D::ShapeResult shape_results[count];
+	bool hits[count] = { true, true, true };
+	int result_counts[count] = { 1, 1, 1 };
+
+	space.lock();
+	ERR_PRINT_OFF;
+	state->intersect_rays(PhysicsDirectSpaceState3D::RayParameters(), points, points, count, ray_results, hits);
+	state->intersect_shapes(PhysicsDirectSpaceState3D::ShapeParameters(), transforms, count, shape_results, 1, result_counts);
+	ERR_PRINT_ON;
+	space.unlock();
+
+	for (int i = 0; i < count; i++) {
+		CHECK_FALSE(hits[i]);
+		CHECK(result_counts[i] == 0);
+	}
+}
+
+TEST_CASE_BENCHMARK("[SceneTree][PhysicsServer3D][Benchmark] Batched ray throughput") {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+	RID box = ps->box_shape_create();
+	ps->shape_set_data(box, Vector3(0.5, 0.5, 0.5));
+	LocalVector<RID> bodies;
+	_create_box_grid(space, box, bodies);
+
+	PhysicsDirectSpaceState3D *state = ps->space_get_direct_state(space);
+	REQUIRE(state != nullptr);
+
+	RandomPCG rng(7);
+	const int count = 20000;
+	LocalVector<Vector3> from;
+	LocalVector<Vector3> to;
+	for (int i = 0; i < count; i++) {
+		from.push_back(Vector3(rng.random(0.0, GRID_SIZE * 2.0), 5, rng.random(0.0, GRID_SIZE * 2.0)));
+		to.push_back(Vector3(rng.random(0.0, GRID_SIZE * 2.0), -5, rng.random(0.0, GRID_SIZE * 2.0)));
+	}
+
+	PhysicsDirectSpaceState3D::RayParameters parameters;
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+	results.resize(count);
+	LocalVector<bool> hits;
+	hits.resize(count);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		parameters.from = from[i];
+		parameters.to = to[i];
+		hits[i] = state->intersect_ray(parameters, results[i]);
+	}
+	uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+	MESSAGE(vformat("Single queries: %d rays per second.", int64_t(count * 1000000.0 / elapsed)).utf8().get_data());
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	state->intersect_rays(parameters, from.ptr(), to.ptr(), count, results.ptr(), hits.ptr());
+	elapsed = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+	MESSAGE(vformat("Batched queries: %d rays per second.", int64_t(count * 1000000.0 / elapsed)).utf8().get_data());
+
+	_free_rids(bodies);
+	ps->free(box);
+	ps->free(space);
+}
+
+// Columns of stacked rigid boxes, resting on a static floor (the first body).
+static void _create_box_piles(RID p_space, RID p_shape, RID p_floor_shape, int p_columns, int p_height, LocalVector<RID> &r_bodies) {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+
+	ps->shape_set_data(p_floor_shape, Vector3(p_columns + 1, 0.5, p_columns + 1));
+	RID floor = ps->body_create();
+	ps->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	ps->body_add_shape(floor, p_floor_shape);
+	ps->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(p_columns, -0.5, p_columns)));
+	ps->body_set_space(floor, p_space);
+	r_bodies.push_back(floor);
+
+	for (int x = 0; x < p_columns; x++) {
+		for (int z = 0; z < p_columns; z++) {
+			for (int y = 0; y < p_height; y++) {
+				RID body = ps->body_create();
+				ps->body_add_shape(body, p_shape);
+				ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x * 2 + 0.5, y * 1.05 + 0.55, z * 2 + 0.5)));
+				ps->body_set_space(body, p_space);
+				r_bodies.push_back(body);
+			}
+		}
+	}
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Stepping piles is deterministic") {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID box = ps->box_shape_create();
+	ps->shape_set_data(box, Vector3(0.5, 0.5, 0.5));
+	RID floor = ps->box_shape_create();
+
+	// Two identical spaces, with enough moving bodies for the broadphase to pair them on several threads.
+	// The first one pairs serially, the second one in parallel, and both must end up in exactly the same state.
+	RID spaces[2];
+	LocalVector<RID> bodies[2];
+	for (int i = 0; i < 2; i++) {
+		GodotBroadPhase3DBVH::set_parallel_pairing_enabled(i == 1);
+		spaces[i] = ps->space_create();
+		ps->space_set_active(spaces[i], true);
+		_create_box_piles(spaces[i], box, floor, 10, 4, bodies[i]);
+	}
+	GodotBroadPhase3DBVH::set_parallel_pairing_enabled(true);
+
+	for (int step = 0; step < 30; step++) {
+		ps->step(1.0 / 60.0);
+	}
+
+	REQUIRE(bodies[0].size() == bodies[1].size());
+	bool identical = true;
+	bool settled = true;
+	for (uint32_t i = 1; i < bodies[0].size(); i++) {
+		Transform3D transform = ps->body_get_state(bodies[0][i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		identical = identical && transform == Transform3D(ps->body_get_state(bodies[1][i], PhysicsServer3D::BODY_STATE_TRANSFORM));
+		settled = settled && transform.origin.y > 0.0;
+	}
+	CHECK_MESSAGE(identical, "Both spaces should be in the same state.");
+	CHECK_MESSAGE(settled, "No box should fall through the floor.");
+
+	for (int i = 0; i < 2; i++) {
+		_free_rids(bodies[i]);
+		ps->free(spaces[i]);
+	}
+	ps->free(floor);
+	ps->free(box);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Solving on the packed body state matches solving on the bodies") {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID box = ps->box_shape_create();
+	ps->shape_set_data(box, Vector3(0.5, 0.5, 0.5));
+	RID floor = ps->box_shape_create();
+
+	// Spaces are stepped together, so run the same scene once per solver path.
+	LocalVector<Transform3D> transforms[2];
+	LocalVector<Vector3> velocities[2];
+	for (int pass = 0; pass < 2; pass++) {
+		GodotStep3D::set_solver_body_state_enabled(pass == 0);
+
+		RID space = ps->space_create();
+		ps->space_set_active(space, true);
+		LocalVector<RID> bodies;
+		_create_box_piles(space, box, floor, 4, 6, bodies);
+
+		// Tilt a few boxes so the piles topple and bodies keep interacting.
+		for (uint32_t i = 1; i < bodies.size(); i += 5) {
+			Transform3D transform = ps->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+			transform.basis = Basis(Vector3(1, 0, 1).normalized(), 0.3);
+			ps->body_set_state(bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM, transform);
+		}
+
+		for (int step = 0; step < 60; step++) {
+			ps->step(1.0 / 60.0);
+		}
+
+		for (uint32_t i = 1; i < bodies.size(); i++) {
+			transforms[pass].push_back(ps->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM));
+			velocities[pass].push_back(ps->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY));
+			velocities[pass].push_back(ps->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY));
+		}
+
+		_free_rids(bodies);
+		ps->free(space);
+	}
+	GodotStep3D::set_solver_body_state_enabled(true);
+
+	REQUIRE(transforms[0].size() == transforms[1].size());
+	bool identical = true;
+	for (uint32_t i = 0; i < transforms[0].size(); i++) {
+		identical = identical && transforms[0][i] == transforms[1][i];
+	}
+	for (uint32_t i = 0; i < velocities[0].size(); i++) {
+		identical = identical && velocities[0][i] == velocities[1][i];
+	}
+	CHECK_MESSAGE(identical, "Both solver paths should give exactly the same result.");
+
+	ps->free(floor);
+	ps->free(box);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Solving an island on the packed body state matches solve()") {
+	GodotSpace3D *space = memnew(GodotSpace3D);
+	GodotBoxShape3D *shape = memnew(GodotBoxShape3D);
+	shape->set_data(Vector3(0.5, 0.5, 0.5));
+
+	// A static floor, and two boxes sinking into it and into each other.
+	const Transform3D transforms[3] = {
+		Transform3D(Basis(), Vector3(0, -0.5, 0)),
+		Transform3D(Basis(Vector3(0, 1, 0), 0.2), Vector3(0.1, 0.45, 0)),
+		Transform3D(Basis(Vector3(1, 0, 1).normalized(), 0.3), Vector3(-0.2, 1.35, 0.1)),
+	};
+	GodotBody3D *bodies[3];
+	for (int i = 0; i < 3; i++) {
+		bodies[i] = memnew(GodotBody3D);
+		bodies[i]->set_mode(i == 0 ? PhysicsServer3D::BODY_MODE_STATIC : PhysicsServer3D::BODY_MODE_RIGID);
+		bodies[i]->add_shape(shape);
+		bodies[i]->set_state(PhysicsServer3D::BODY_STATE_TRANSFORM, transforms[i]);
+		bodies[i]->set_space(space);
+		bodies[i]->update_mass_properties();
+	}
+
+	const real_t step = 1.0 / 60.0;
+	Vector3 velocities[2][8];
+	for (int pass = 0; pass < 2; pass++) {
+		for (int i = 1; i < 3; i++) {
+			bodies[i]->set_linear_velocity(Vector3(0.3 * i, -2.0, 0.1));
+			bodies[i]->set_angular_velocity(Vector3(0.5, 0.0, -0.2 * i));
+			bodies[i]->set_biased_linear_velocity(Vector3());
+			bodies[i]->set_biased_angular_velocity(Vector3());
+		}
+
+		// New pairs each pass, so both start without cached contacts.
+		GodotBodyPair3D *pairs[3] = {
+			memnew(GodotBodyPair3D(bodies[1], 0, bodies[0], 0)),
+			memnew(GodotBodyPair3D(bodies[2], 0, bodies[1], 0)),
+			memnew(GodotBodyPair3D(bodies[2], 0, bodies[0], 0)),
+		};
+		for (GodotBodyPair3D *pair : pairs) {
+			pair->setup(step);
+			pair->pre_solve(step);
+		}
+
+		if (pass == 0) {
+			GodotSolverBodyState3D body_state;
+			body_state.begin(1);
+			for (GodotBodyPair3D *pair : pairs) {
+				REQUIRE(pair->bind_solver_body_state(body_state));
+			}
+			for (int iteration = 0; iteration < space->get_solver_iterations(); iteration++) {
+				for (GodotBodyPair3D *pair : pairs) {
+					pair->solve_body_state(body_state, step);
+				}
+			}
+			body_state.write_back();
+		} else {
+			for (int iteration = 0; iteration < space->get_solver_iterations(); iteration++) {
+				for (GodotBodyPair3D *pair : pairs) {
+					pair->solve(step);
+				}
+			}
+		}
+
+		for (int i = 1; i < 3; i++) {
+			velocities[pass][(i - 1) * 4 + 0] = bodies[i]->get_linear_velocity();
+			velocities[pass][(i - 1) * 4 + 1] = bodies[i]->get_angular_velocity();
+			velocities[pass][(i - 1) * 4 + 2] = bodies[i]->get_biased_linear_velocity();
+			velocities[pass][(i - 1) * 4 + 3] = bodies[i]->get_biased_angular_velocity();
+		}
+		for (GodotBodyPair3D *pair : pairs) {
+			memdelete(pair);
+		}
+	}
+
+	CHECK_MESSAGE(velocities[0][0] != Vector3(0.3, -2.0, 0.1), "The boxes should have been pushed out of the floor.");
+	CHECK_MESSAGE(memcmp(velocities[0], velocities[1], sizeof(velocities[0])) == 0, "Both solver paths should give exactly the same velocities.");
+
+	for (GodotBody3D *body : bodies) {
+		body->set_space(nullptr);
+		body->remove_shape(0);
+		memdelete(body);
+	}
+	memdelete(shape);
+	memdelete(space);
+}
+
+TEST_CASE_BENCHMARK("[SceneTree][PhysicsServer3D][Benchmark] Pile step time") {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID box = ps->box_shape_create();
+	ps->shape_set_data(box, Vector3(0.5, 0.5, 0.5));
+	RID floor = ps->box_shape_create();
+
+	const int steps = 30;
+	const int column_counts[] = { 8, 16, 24 };
+	for (int columns : column_counts) {
+		for (int pass = 0; pass < 2; pass++) {
+			const bool packed = pass == 0;
+			GodotStep3D::set_solver_body_state_enabled(packed);
+
+			RID space = ps->space_create();
+			ps->space_set_active(space, true);
+			LocalVector<RID> bodies;
+			_create_box_piles(space, box, floor, columns, 8, bodies);
+
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int step = 0; step < steps; step++) {
+				ps->step(1.0 / 60.0);
+			}
+			uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+			MESSAGE(vformat("%d bodies, %d worker threads, solving on %s: %.3f ms per step.", bodies.size() - 1, WorkerThreadPool::get_singleton()->get_thread_count(), packed ? "packed body state" : "bodies", elapsed / (steps * 1000.0)).utf8().get_data());
+
+			_free_rids(bodies);
+			ps->free(space);
+		}
+	}
+	GodotStep3D::set_solver_body_state_enabled(true);
+
+	ps->free(floor);
+	ps->free(box);
+}
+
+static Transform3D _random_transform(RandomPCG &p_rng, real_t p_spread) {
+	Basis basis = Basis::from_euler(Vector3(p_rng.random(-Math_PI, Math_PI), p_rng.random(-Math_PI, Math_PI), p_rng.random(-Math_PI, Math_PI)));
+	return Transform3D(basis, Vector3(p_rng.random(-p_spread, p_spread), p_rng.random(-p_spread, p_spread), p_rng.random(-p_spread, p_spread)));
+}
+
+static Vector3 _random_direction(RandomPCG &p_rng) {
+	return Vector3(p_rng.random(-1.0, 1.0), p_rng.random(-1.0, 1.0), p_rng.random(-1.0, 1.0)).normalized();
+}
+
+TEST_CASE("[PhysicsServer3D] SIMD projection kernels match the scalar kernels") {
+	RandomPCG rng(1234);
+
+	for (int test = 0; test < 1000; test++) {
+		Transform3D transform = _random_transform(rng, 100.0);
+		Vector3 half_extents(rng.random(0.01, 10.0), rng.random(0.01, 10.0), rng.random(0.01, 10.0));
+		Vector3 axes[4];
+		for (int i = 0; i < 4; i++) {
+			axes[i] = _random_direction(rng);
+		}
+
+		real_t min[4], max[4], scalar_min[4], scalar_max[4];
+		GodotSIMDKernels3D::box_project_range_x4(half_extents, transform, axes, min, max);
+		GodotSIMDKernels3D::box_project_range_x4_scalar(half_extents, transform, axes, scalar_min, scalar_max);
+		CHECK(memcmp(min, scalar_min, sizeof(min)) == 0);
+		CHECK(memcmp(max, scalar_max, sizeof(max)) == 0);
+
+		// Also covers counts that are not a multiple of four.
+		Vector3 points[13];
+		for (Vector3 &point : points) {
+			point = Vector3(rng.random(-5.0, 5.0), rng.random(-5.0, 5.0), rng.random(-5.0, 5.0));
+		}
+		uint32_t count = 1 + test % 13;
+		real_t range[2] = {}, scalar_range[2] = {};
+		GodotSIMDKernels3D::points_project_range(points, count, axes[0], transform, range[0], range[1]);
+		GodotSIMDKernels3D::points_project_range_scalar(points, count, axes[0], transform, scalar_range[0], scalar_range[1]);
+		CHECK(memcmp(range, scalar_range, sizeof(range)) == 0);
+	}
+}
+
+struct ContactRecorder {
+	LocalVector<Vector3> points;
+
+	static void add_contact(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &p_normal, void *p_userdata) {
+		ContactRecorder *recorder = static_cast<ContactRecorder *>(p_userdata);
+		recorder->points.push_back(p_point_A);
+		recorder->points.push_back(p_point_B);
+	}
+};
+
+// Collides shape pairs placed close to each other, and records every contact.
+static void _record_contacts(const GodotShape3D *p_shape_A, const GodotShape3D *p_shape_B, const LocalVector<Transform3D> &p_transforms, LocalVector<Vector3> &r_contacts, LocalVector<Vector3> &r_separation_axes) {
+	for (uint32_t i = 0; i + 1 < p_transforms.size(); i += 2) {
+		ContactRecorder recorder;
+		Vector3 separation_axis;
+		GodotCollisionSolver3D::solve_static(p_shape_A, p_transforms[i], p_shape_B, p_transforms[i + 1], ContactRecorder::add_contact, &recorder, &separation_axis);
+		for (const Vector3 &point : recorder.points) {
+			r_contacts.push_back(point);
+		}
+		r_separation_axes.push_back(separation_axis);
+	}
+}
+
+TEST_CASE("[PhysicsServer3D] SIMD collision kernels give bitwise identical contacts") {
+	GodotBoxShape3D *box = memnew(GodotBoxShape3D);
+	box->set_data(Vector3(0.5, 1.0, 1.5));
+
+	RandomPCG rng(99);
+	Vector<Vector3> hull_points;
+	for (int i = 0; i < 24; i++) {
+		hull_points.push_back(_random_direction(rng) * rng.random(0.5, 1.0));
+	}
+	GodotConvexPolygonShape3D *convex = memnew(GodotConvexPolygonShape3D);
+	convex->set_data(hull_points);
+
+	LocalVector<Transform3D> transforms;
+	for (int i = 0; i < 2000; i++) {
+		transforms.push_back(_random_transform(rng, 1.5));
+	}
+
+	const GodotShape3D *pairs[3][2] = { { box, box }, { box, convex }, { convex, convex } };
+	for (const auto &pair : pairs) {
+		LocalVector<Vector3> contacts[2];
+		LocalVector<Vector3> separation_axes[2];
+		for (int pass = 0; pass < 2; pass++) {
+			GodotSIMDKernels3D::set_enabled(pass == 0);
+			_record_contacts(pair[0], pair[1], transforms, contacts[pass], separation_axes[pass]);
+		}
+		GodotSIMDKernels3D::set_enabled(true);
+
+		CHECK(contacts[0].size() > 0);
+		REQUIRE(contacts[0].size() == contacts[1].size());
+		CHECK(memcmp(contacts[0].ptr(), contacts[1].ptr(), contacts[0].size() * sizeof(Vector3)) == 0);
+		REQUIRE(separation_axes[0].size() == separation_axes[1].size());
+		CHECK(memcmp(separation_axes[0].ptr(), separation_axes[1].ptr(), separation_axes[0].size() * sizeof(Vector3)) == 0);
+	}
+
+	memdelete(convex);
+	memdelete(box);
+}
+
+TEST_CASE_BENCHMARK("[PhysicsServer3D][Benchmark] Contact generation rate") {
+	GodotBoxShape3D *box = memnew(GodotBoxShape3D);
+	box->set_data(Vector3(0.5, 0.5, 0.5));
+
+	RandomPCG rng(5);
+	LocalVector<Transform3D> transforms;
+	for (int i = 0; i < 100000; i++) {
+		transforms.push_back(_random_transform(rng, 0.8));
+	}
+
+	for (int pass = 0; pass < 2; pass++) {
+		const bool simd = pass == 0;
+		GodotSIMDKernels3D::set_enabled(simd);
+
+		LocalVector<Vector3> contacts;
+		LocalVector<Vector3> separation_axes;
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		_record_contacts(box, box, transforms, contacts, separation_axes);
+		uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+
+		MESSAGE(vformat("Box-box, %s kernels: %d pairs per second, %d contacts per second.", simd && GodotSIMDKernels3D::is_available() ? "SIMD" : "scalar", int64_t(separation_axes.size() * 1000000.0 / elapsed), int64_t(contacts.size() / 2 * 1000000.0 / elapsed)).utf8().get_data());
+	}
+	GodotSIMDKernels3D::set_enabled(true);
+
+	memdelete(box);
+}
+
+// Rolling terrain made of a grid of p_size * p_size cells, two triangles each.
+static Vector<Vector3> _create_terrain_faces(int p_size, real_t p_cell_size) {
+	auto height = [p_cell_size](int p_x, int p_z) {
+		return Math::sin(p_x * 0.21) * Math::cos(p_z * 0.17) * 4.0 * p_cell_size;
+	};
+
+	Vector<Vector3> faces;
+	faces.resize(p_size * p_size * 6);
+	Vector3 *facesw = faces.ptrw();
+	for (int z = 0; z < p_size; z++) {
+		for (int x = 0; x < p_size; x++) {
+			Vector3 v00(x * p_cell_size, height(x, z), z * p_cell_size);
+			Vector3 v10((x + 1) * p_cell_size, height(x + 1, z), z * p_cell_size);
+			Vector3 v01(x * p_cell_size, height(x, z + 1), (z + 1) * p_cell_size);
+			Vector3 v11((x + 1) * p_cell_size, height(x + 1, z + 1), (z + 1) * p_cell_size);
+			Vector3 *cell = &facesw[(z * p_size + x) * 6];
+			cell[0] = v00;
+			cell[1] = v10;
+			cell[2] = v01;
+			cell[3] = v10;
+			cell[4] = v11;
+			cell[5] = v01;
+		}
+	}
+	return faces;
+}
+
+static GodotConcavePolygonShape3D *_create_concave_shape(const Vector<Vector3> &p_faces, bool p_backface_collision) {
+	GodotConcavePolygonShape3D *shape = memnew(GodotConcavePolygonShape3D);
+	Dictionary data;
+	data["faces"] = p_faces;
+	data["backface_collision"] = p_backface_collision;
+	shape->set_data(data);
+	return shape;
+}
+
+static bool _count_face(void *p_userdata, GodotShape3D *p_face) {
+	(*static_cast<int *>(p_userdata))++;
+	return false;
+}
+
+TEST_CASE("[PhysicsServer3D] Concave polygon queries match testing every face") {
+	const Vector<Vector3> faces = _create_terrain_faces(40, 1.0);
+	const int face_count = faces.size() / 3;
+
+	for (int backface_collision = 0; backface_collision < 2; backface_collision++) {
+		GodotConcavePolygonShape3D *shape = _create_concave_shape(faces, backface_collision);
+
+		// Vertices are shared, and faces reordered, internally.
+		const Vector<Vector3> shape_faces = shape->get_faces();
+		REQUIRE(shape_faces.size() == faces.size());
+		CHECK(memcmp(shape_faces.ptr(), faces.ptr(), faces.size() * sizeof(Vector3)) == 0);
+		CHECK(shape->vertices.size() == 41 * 41);
+
+		RandomPCG rng(backface_collision + 7);
+		int culled_total = 0;
+		for (int test = 0; test < 200; test++) {
+			Vector3 position(rng.random(-5.0, 45.0), rng.random(-6.0, 6.0), rng.random(-5.0, 45.0));
+			AABB aabb(position, Vector3(rng.random(0.0, 4.0), rng.random(0.0, 4.0), rng.random(0.0, 4.0)));
+
+			int expected = 0;
+			for (int i = 0; i < face_count; i++) {
+				expected += aabb.intersects(Face3(faces[i * 3 + 0], faces[i * 3 + 1], faces[i * 3 + 2]).get_aabb());
+			}
+			int culled = 0;
+			shape->cull(aabb, _count_face, &culled, false);
+			CHECK(culled == expected);
+			culled_total += culled;
+		}
+		CHECK(culled_total > 0);
+
+		int hits = 0;
+		for (int test = 0; test < 200; test++) {
+			Vector3 begin(rng.random(-5.0, 45.0), rng.random(-10.0, 10.0), rng.random(-5.0, 45.0));
+			Vector3 end = test % 2 ? Vector3(rng.random(-5.0, 45.0), rng.random(-10.0, 10.0), rng.random(-5.0, 45.0)) : begin + _random_direction(rng) * 1000.0;
+
+			// The closest face hit, testing all of them.
+			GodotFaceShape3D face;
+			face.backface_collision = backface_collision;
+			const Vector3 dir = (end - begin).normalized();
+			real_t expected_d = 1e20;
+			int expected_face_index = -1;
+			for (int i = 0; i < face_count; i++) {
+				face.vertex[0] = faces[i * 3 + 0];
+				face.vertex[1] = faces[i * 3 + 1];
+				face.vertex[2] = faces[i * 3 + 2];
+				Vector3 result, normal;
+				int face_index = i;
+				if (face.intersect_segment(begin, end, result, normal, face_index, true)) {
+					real_t d = dir.dot(result) - dir.dot(begin);
+					if (d > 0 && d < expected_d) {
+						expected_d = d;
+						expected_face_index = i;
+					}
+				}
+			}
+
+			Vector3 result, normal;
+			int face_index = -1;
+			bool hit = shape->intersect_segment(begin, end, result, normal, face_index, true);
+			CHECK(hit == (expected_face_index >= 0));
+			if (hit) {
+				CHECK(face_index == expected_face_index);
+				hits++;
+			}
+		}
+		CHECK(hits > 0);
+
+		memdelete(shape);
+	}
+}
+
+TEST_CASE("[PhysicsServer3D] Quantized BVH kernels match the scalar kernels") {
+	RandomPCG rng(3);
+	for (int test = 0; test < 10000; test++) {
+		GodotQuantizedBVH3D::Node node;
+		uint16_t query[6];
+		for (int i = 0; i < 3; i++) {
+			uint16_t a = rng.rand(), b = rng.rand();
+			node.min[i] = MIN(a, b);
+			node.max[i] = MAX(a, b);
+			a = rng.rand();
+			b = rng.rand();
+			query[i] = MIN(a, b);
+			query[i + 3] = MAX(a, b);
+		}
+		node.data = rng.rand();
+		CHECK(GodotQuantizedBVH3D::node_overlaps(node, query) == GodotQuantizedBVH3D::node_overlaps_scalar(node, query));
+
+		Vector3 from(rng.random(0.0, 65535.0), rng.random(0.0, 65535.0), rng.random(0.0, 65535.0));
+		Vector3 dir = _random_direction(rng) * 40000.0;
+		Vector3 inv_dir(1.0 / dir.x, 1.0 / dir.y, 1.0 / dir.z);
+		real_t entry = GodotQuantizedBVH3D::node_segment_entry(node, from, inv_dir, 1.0);
+		real_t scalar_entry = GodotQuantizedBVH3D::node_segment_entry_scalar(node, from, inv_dir, 1.0);
+		CHECK(entry == scalar_entry);
+	}
+}
+
+TEST_CASE_BENCHMARK("[PhysicsServer3D][Benchmark] Concave polygon memory and queries") {
+	const int size = 512;
+	const Vector<Vector3> faces = _create_terrain_faces(size, 1.0);
+	const int face_count = faces.size() / 3;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	GodotConcavePolygonShape3D *shape = _create_concave_shape(faces, false);
+	uint64_t build_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(vformat("%d faces, built in %.1f ms, %d bytes (%.1f bytes per face, %d BVH nodes).", face_count, build_time / 1000.0, int64_t(shape->get_memory_usage()), double(shape->get_memory_usage()) / face_count, shape->bvh.get_node_count()).utf8().get_data());
+
+	RandomPCG rng(11);
+	const int queries = 100000;
+
+	int culled = 0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < queries; i++) {
+		Vector3 position(rng.random(0.0, double(size)), rng.random(-4.0, 4.0), rng.random(0.0, double(size)));
+		shape->cull(AABB(position, Vector3(1.0, 1.0, 1.0)), _count_face, &culled, false);
+	}
+	uint64_t cull_time = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+
+	int hits = 0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < queries; i++) {
+		Vector3 from(rng.random(0.0, double(size)), 20.0, rng.random(0.0, double(size)));
+		Vector3 to = from + Vector3(rng.random(-50.0, 50.0), -40.0, rng.random(-50.0, 50.0));
+		Vector3 result, normal;
+		int face_index = -1;
+		hits += shape->intersect_segment(from, to, result, normal, face_index, false);
+	}
+	uint64_t ray_time = MAX(OS::get_singleton()->get_ticks_usec() - begin, uint64_t(1));
+
+	MESSAGE(vformat("%d AABB culls per second (%d faces found), %d rays per second (%d hits).", int64_t(queries * 1000000.0 / cull_time), culled, int64_t(queries * 1000000.0 / ray_time), hits).utf8().get_data());
+
+	memdelete(shape);
+}
+
+} // namespace TestPhysicsServer3D
+
+#endif // TEST_PHYSICS_SERVER_3D_H